@@ -40,6 +40,8 @@
 #include "OptimizeAction.h"
 #include "MaximalStandardAction.h"
 #include "LatticeAnalyzeAction.h"
+#include "MicroBenchmarkAction.h"
+#include "SolveShardAction.h"
 #include "DimensionAction.h"
 #include "EulerAction.h"
 
@@ -51,9 +53,39 @@ Action::Action(const char* name,
   _shortDescription(shortDescription),
   _description(description),
   _acceptsNonParameter(acceptsNonParameterParam),
-  _printActions("time", "Display and time each subcomputation.", false) {
+  _printActions("time", "Display and time each subcomputation.", false),
+  _profile("profile",
+           "Write the wall clock time, CPU time and peak memory use of each\n"
+           "phase of the computation to the given file in JSON format.",
+           ""),
+  _trace("trace",
+         "Write a trace of the nodes of the computation tree of the Slice,\n"
+         "Bigatti et.al. and Euler characteristic algorithms to the given file.\n"
+         "Only the most recent nodes are kept for long computations.",
+         ""),
+  _traceFormat("traceFormat",
+               "The format of the trace. Options are chrome for the JSON format\n"
+               "of the Chrome trace viewer and folded for folded stacks as used\n"
+               "by flame graph tools.",
+               "chrome"),
+  _timeLimit("timeLimit",
+             "Stop the computation with an error once it has run for this many\n"
+             "seconds of wall clock time. The output written up to that point is\n"
+             "incomplete. The value 0 indicates no limit.",
+             0),
+  _progress("progress",
+            "Report the progress of the Slice, Bigatti et.al. and Euler\n"
+            "characteristic algorithms to standard error every this many seconds.\n"
+            "A report includes an estimate of the size of the computation tree.\n"
+            "The value 0 indicates no reports.",
+            0) {
 
   _params.add(_printActions);
+  _params.add(_profile);
+  _params.add(_trace);
+  _params.add(_traceFormat);
+  _params.add(_timeLimit);
+  _params.add(_progress);
 }
 
 Action::~Action() {
@@ -86,6 +118,8 @@ namespace {
     nameFactoryRegister<AnalyzeAction>(factory);
     nameFactoryRegister<LatticeFormatAction>(factory);
     nameFactoryRegister<LatticeAnalyzeAction>(factory);
+    nameFactoryRegister<MicroBenchmarkAction>(factory);
+    nameFactoryRegister<SolveShardAction>(factory);
 
     nameFactoryRegister<HelpAction>(factory);
     nameFactoryRegister<TestAction>(factory);
@@ -102,6 +136,26 @@ const Parameter& Action::getParam(const string& name) const {
   return _params.getParam(name);
 }
 
+const string& Action::getProfileFileName() const {
+  return _profile.getValue();
+}
+
+const string& Action::getTraceFileName() const {
+  return _trace.getValue();
+}
+
+const string& Action::getTraceFormat() const {
+  return _traceFormat.getValue();
+}
+
+unsigned int Action::getTimeLimit() const {
+  return _timeLimit.getValue();
+}
+
+unsigned int Action::getProgressInterval() const {
+  return _progress.getValue();
+}
+
 void Action::getActionNames(vector<string>& names) {
   getActionFactory().getNamesWithPrefix("", names);
 }
@@ -18,6 +18,8 @@
 #define ACTION_GUARD
 
 #include "BoolParameter.h"
+#include "StringParameter.h"
+#include "IntegerParameter.h"
 #include "CliParams.h"
 
 class Parameter;
@@ -52,6 +54,29 @@ class Action {
 
   const Parameter& getParam(const string& name) const;
 
+  /** Returns the name of the file that a profile of the computation
+    should be written to. Returns the empty string if no profile
+    should be written. */
+  const string& getProfileFileName() const;
+
+  /** Returns the name of the file that a trace of the computation
+    tree should be written to. Returns the empty string if no trace
+    should be written. */
+  const string& getTraceFileName() const;
+
+  /** Returns the name of the format that the trace should be written
+    in. */
+  const string& getTraceFormat() const;
+
+  /** Returns the number of wall clock seconds after which the
+    computation is to be stopped. Returns zero if there is no time
+    limit. */
+  unsigned int getTimeLimit() const;
+
+  /** Returns the number of wall clock seconds between progress
+    reports. Returns zero if progress should not be reported. */
+  unsigned int getProgressInterval() const;
+
   static void getActionNames(vector<string>& names);
   static auto_ptr<Action> createActionWithPrefix(const string& prefix);
 
@@ -66,6 +91,11 @@ class Action {
   bool _acceptsNonParameter;
 
   BoolParameter _printActions;
+  StringParameter _profile;
+  StringParameter _trace;
+  StringParameter _traceFormat;
+  IntegerParameter _timeLimit;
+  IntegerParameter _progress;
 
 };
 
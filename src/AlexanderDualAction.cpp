@@ -36,6 +36,8 @@ AlexanderDualAction::AlexanderDualAction():
  "details.",
  false),
 
+  _sliceParams(false, true, false, true, true, true),
+
   _io(DataType::getMonomialIdealType(), DataType::getMonomialIdealType()) {
 }
 
@@ -18,11 +18,57 @@
 #include "stdinc.h"
 #include "Arena.h"
 
+#include "Parallel.h"
 #include <new>
 #include <limits>
+#include <vector>
 
 Arena Arena::_scratchArena;
 
+#ifdef _OPENMP
+namespace {
+  /** The scratch arena of the calling thread. This is null until the
+   thread first asks for its scratch arena. */
+  Arena* threadScratchArena = 0;
+#pragma omp threadprivate(threadScratchArena)
+
+  /** Owns the scratch arenas of the threads other than the initial
+   thread. The threads of OpenMP are re-used across parallel regions,
+   so these arenas live until the program exits. */
+  class ThreadArenas {
+  public:
+    ~ThreadArenas() {
+      for (size_t i = 0; i < _arenas.size(); ++i)
+        delete _arenas[i];
+    }
+
+    Arena* makeArena() {
+      MutexLocker locker(_mutex);
+      _arenas.reserve(_arenas.size() + 1);
+      Arena* arena = new Arena();
+      _arenas.push_back(arena);
+      return arena;
+    }
+
+  private:
+    Mutex _mutex;
+    std::vector<Arena*> _arenas;
+  } threadArenas;
+}
+
+Arena& Arena::getArena() {
+  if (threadScratchArena == 0) {
+    // Only the initial thread runs outside of parallel regions. A
+    // thread keeps the arena it gets here for as long as it lives.
+    if (!isInParallelRegion())
+      threadScratchArena = &_scratchArena;
+    else
+      threadScratchArena = threadArenas.makeArena();
+  }
+  return *threadScratchArena;
+}
+#endif
+
 Arena::Arena() {
 }
 
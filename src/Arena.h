@@ -129,14 +129,20 @@ class Arena {
    include memory for a DEBUG-only mechanism to catch bugs. */
   size_t getMemoryUsage() const {return _blocks.getMemoryUsage();}
 
-  /** Returns an arena object that can be used for non-thread safe
-   scratch memory after static objects have been initialized. The
-   default contract is that each function leaves this arena with the
-   exact same objects allocated as before the function was entered. It
-   is fine for functions to collaborate for example by using the arena
-   to return variable size objects without calling new, though care
-   should be used in such cases. */
+  /** Returns an arena object that can be used for scratch memory
+   after static objects have been initialized. Each thread has its own
+   scratch arena, so no locking is needed. The default contract is that
+   each function leaves this arena with the exact same objects
+   allocated as before the function was entered. It is fine for
+   functions to collaborate for example by using the arena to return
+   variable size objects without calling new, though care should be
+   used in such cases. Memory from the scratch arena must be freed on
+   the thread that allocated it. */
+#ifdef _OPENMP
+  static Arena& getArena();
+#else
   static Arena& getArena() {return _scratchArena;}
+#endif
 
  private:
   typedef MemoryBlocks::Block Block;
@@ -156,6 +162,7 @@ class Arena {
   MemoryBlocks _blocks;
   IF_DEBUG(std::vector<void*> _debugAllocs;)
 
+  /** The scratch arena of the initial thread. */
   static Arena _scratchArena;
 };
 
@@ -19,8 +19,10 @@
 #include "Arena.h"
 #include "tests.h"
 
+#include "Parallel.h"
 #include <algorithm>
 #include <sstream>
+#include <vector>
 
 TEST_SUITE(Arena)
 
@@ -194,3 +196,20 @@ TEST(Arena, ConNoDecon) {
   ASSERT_EQ(ConNoDeconHelper::getLog(), "+1+2+3");
   ASSERT_TRUE(arena.isEmpty())
 }
+
+TEST(Arena, ThreadScratchArenas) {
+  Arena* initialArena = &Arena::getArena();
+  const int threadCount = static_cast<int>(getMaxThreadCount());
+  vector<Arena*> arenas(threadCount);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threadCount)
+#endif
+  {
+    arenas[getThreadIndex()] = &Arena::getArena();
+  }
+
+  ASSERT_EQ(&Arena::getArena(), initialArena);
+  ASSERT_EQ(arenas[0], initialArena);
+  sort(arenas.begin(), arenas.end());
+  ASSERT_TRUE(adjacent_find(arenas.begin(), arenas.end()) == arenas.end());
+}
@@ -33,6 +33,7 @@ AssociatedPrimesAction::AssociatedPrimesAction():
  "future version of Frobby.",
  false),
 
+  _sliceParams(false, true, false, false, false, true),
   _io(DataType::getMonomialIdealType(), DataType::getMonomialIdealType()) {
 }
 
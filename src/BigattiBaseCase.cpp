@@ -20,6 +20,7 @@
 
 #include "BigattiState.h"
 #include "TermTranslator.h"
+#include "ProgressMeter.h"
 #include <algorithm>
 
 BigattiBaseCase::BigattiBaseCase(const TermTranslator& translator):
@@ -92,6 +93,7 @@ void BigattiBaseCase::output(bool plus, const Term& term) {
   }
 
   ++_totalTermsOutputEver;
+  ProgressMeter::getSingleton().addOutputTerms(1);
   if (_computeUnivariate) {
     if (term.getVarCount() == 0)
       _tmp = 0;
@@ -234,6 +236,7 @@ bool BigattiBaseCase::univariateAllFaces(const BigattiState& state) {
     ++_totalTermsOutputEver;
     _outputUnivariate.add(poly[e], e+degree);
   }
+  ProgressMeter::getSingleton().addOutputTerms(poly.size());
 
   return true;
 }
@@ -21,6 +21,7 @@
 #include "BigattiHilbertAlgorithm.h"
 #include "BigattiParams.h"
 #include "BigattiPivotStrategy.h"
+#include "SquareFreeHilbertAlg.h"
 
 BigattiFacade::BigattiFacade(const BigattiParams& params):
   Facade(params.getPrintActions()),
@@ -36,6 +37,11 @@ BigattiFacade::~BigattiFacade() {
 }
 
 void BigattiFacade::computeMultigradedHilbertSeries() {
+  if (_params.getUseSquareFree() && _common.isProperSquareFreeIdeal()) {
+    computeSquareFreeHilbertSeries(false);
+    return;
+  }
+
   beginAction("Computing multigraded Hilbert-Poincare series.");
 
   BigattiHilbertAlgorithm alg(_common.takeIdeal(),
@@ -50,6 +56,11 @@ void BigattiFacade::computeMultigradedHilbertSeries() {
 }
 
 void BigattiFacade::computeUnivariateHilbertSeries() {
+  if (_params.getUseSquareFree() && _common.isProperSquareFreeIdeal()) {
+    computeSquareFreeHilbertSeries(true);
+    return;
+  }
+
   beginAction("Computing univariate Hilbert-Poincare series");
 
   BigattiHilbertAlgorithm alg(_common.takeIdeal(),
@@ -62,3 +73,18 @@ void BigattiFacade::computeUnivariateHilbertSeries() {
 
   endAction();
 }
+
+void BigattiFacade::computeSquareFreeHilbertSeries(bool univariate) {
+  // The Bigatti algorithm does not use -split, so only the other
+  // options can be ignored here.
+  noteOptionsBypassedBySquareFree(false);
+  beginAction("Computing Hilbert-Poincare series of square free ideal.");
+
+  SquareFreeHilbertAlg alg(_common.getTranslator());
+  alg.setComputeUnivariate(univariate);
+  alg.run(_common.getIdeal());
+  alg.feedOutputTo(_common.getPolyConsumer(),
+                   _params.getProduceCanonicalOutput());
+
+  endAction();
+}
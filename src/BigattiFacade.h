@@ -45,6 +45,10 @@ class BigattiFacade : public Facade {
   void computeUnivariateHilbertSeries();
 
  private:
+  /** Computes the series using SquareFreeHilbertAlg, which requires
+   the ideal to be square free. */
+  void computeSquareFreeHilbertSeries(bool univariate);
+
   auto_ptr<BigattiPivotStrategy> _pivot;
   BigattiParams _params;
   CommonParamsHelper _common;
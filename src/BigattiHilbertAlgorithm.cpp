@@ -21,6 +21,8 @@
 #include "Ideal.h"
 #include "CoefBigTermConsumer.h"
 #include "BigattiState.h"
+#include "Profiler.h"
+#include "TreeTrace.h"
 
 BigattiHilbertAlgorithm::
 BigattiHilbertAlgorithm
@@ -56,8 +58,14 @@ void BigattiHilbertAlgorithm::run() {
     _pivot = BigattiPivotStrategy::createStrategy("median", true);
 
   _baseCase.setComputeUnivariate(_computeUnivariate);
-  _tasks.runTasks();
-  _baseCase.feedOutputTo(*_consumer, _params.getProduceCanonicalOutput());
+  {
+    ProfilePhase phase("Bigatti algorithm");
+    _tasks.runTasks();
+  }
+  {
+    ProfilePhase phase("Producing output of Bigatti algorithm");
+    _baseCase.feedOutputTo(*_consumer, _params.getProduceCanonicalOutput());
+  }
 
   if (_params.getPrintStatistics()) {
     fputs("*** Statistics for run of Bigatti algorithm ***\n", stderr);
@@ -73,6 +81,9 @@ void BigattiHilbertAlgorithm::run() {
 }
 
 void BigattiHilbertAlgorithm::processState(auto_ptr<BigattiState> state) {
+  TraceNode node(TreeTrace::BigattiAlgorithm, _tasks.getCurrentDepth(),
+                 state->getIdeal().getGeneratorCount(), _varCount);
+
   if (_params.getUseSimplification())
     simplify(*state);
 
@@ -85,6 +96,7 @@ void BigattiHilbertAlgorithm::processState(auto_ptr<BigattiState> state) {
     _baseCase.genericBaseCase(*state) :
     _baseCase.baseCase(*state);
   if (isBaseCase) {
+    traceNodeKind(TreeTrace::BaseCase);
     freeState(state);
     return;
   }
@@ -98,6 +110,11 @@ void BigattiHilbertAlgorithm::processState(auto_ptr<BigattiState> state) {
   ASSERT(!pivot.isIdentity());
   ASSERT(!state->getIdeal().contains(pivot));
 
+  TreeTrace& trace = TreeTrace::getSingleton();
+  if (trace.isEnabled())
+    trace.setNodeKind(TreeTrace::PivotSplit, pivot.getFirstNonZeroExponent(),
+                      pivot.getSizeOfSupport());
+
   auto_ptr<BigattiState> colonState(_stateCache.newObjectCopy(*state));
   colonState->colonStep(pivot);
   _tasks.addTask(colonState.release());
@@ -59,9 +59,13 @@ private:
     size_t _varCount;
     const TermTranslator& _translator;
     CoefBigTermConsumer* _consumer;
-    TaskEngine _tasks;
     ObjectCache<BigattiState> _stateCache;
 
+    /** This is declared after _stateCache so that tasks still pending
+     when a run is stopped by an exception are disposed into the cache
+     before the cache is destructed. */
+    TaskEngine _tasks;
+
     Term _tmp_processState_pivot;
     Term _tmp_simplify_gcd;
 
@@ -34,9 +34,7 @@ namespace {
   class MedianPivot : public BigattiPivotStrategy {
   public:
     const Term& getPivot(BigattiState& state) {
-      _counts.reset(state.getVarCount());
-      state.getIdeal().getSupportCounts(_counts);
-      size_t var = _counts.getFirstMaxExponent();
+      size_t var = state.getSupportCounts().getFirstMaxExponent();
 
       _pivot.reset(state.getVarCount());
       _pivot[var] = state.getMedianPositiveExponentOf(var);
@@ -52,7 +50,6 @@ namespace {
     }
 
   private:
-    Term _counts;
     Term _pivot;
   };
 
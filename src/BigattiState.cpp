@@ -25,7 +25,9 @@ BigattiState::BigattiState(BigattiHilbertAlgorithm* algorithm,
                            const Ideal& ideal, const Term& multiply):
   _algorithm(algorithm),
   _ideal(ideal),
-  _multiply(multiply) {
+  _multiply(multiply),
+  _supportCounts(multiply.getVarCount()),
+  _supportCountsUpdated(false) {
   ASSERT(_algorithm != 0);
   ASSERT(_ideal.getVarCount() == _multiply.getVarCount());
 }
@@ -51,6 +53,23 @@ size_t BigattiState::getVarCount() const {
   return _ideal.getVarCount();
 }
 
+const Term& BigattiState::getSupportCounts() {
+#ifdef DEBUG
+  if (_supportCountsUpdated) {
+    Term tmp(getVarCount());
+    _ideal.getSupportCounts(tmp);
+    ASSERT(tmp == _supportCounts);
+  }
+#endif
+
+  if (!_supportCountsUpdated) {
+    _supportCounts.reset(getVarCount());
+    _ideal.getSupportCounts(_supportCounts);
+    _supportCountsUpdated = true;
+  }
+  return _supportCounts;
+}
+
 Exponent BigattiState::getMedianPositiveExponentOf(size_t var) {
   ASSERT(var < getVarCount());
 
@@ -78,13 +97,51 @@ void BigattiState::singleDegreeSort(size_t var) {
 
 void BigattiState::colonStep(const Term& pivot) {
   ASSERT(pivot.getVarCount() == getVarCount());
-  _ideal.colonReminimize(pivot);
+  if (_ideal.colonReminimize(pivot))
+    _supportCountsUpdated = false; // supports may have changed
   _multiply.product(_multiply, pivot);
 }
 
+namespace {
+  /** Helper class for BigattiState::addStep. Selects the multiples of
+   a term and subtracts their support from a vector of counts. */
+  class RemoveMultiplesPredicate {
+  public:
+    RemoveMultiplesPredicate(const Term& term, Term& counts):
+      _term(term), _counts(counts) {}
+
+    bool operator()(const Exponent* term) {
+      if (!_term.divides(term))
+        return false;
+      for (size_t var = 0; var < _counts.getVarCount(); ++var)
+        if (term[var] > 0)
+          _counts[var] -= 1;
+      return true;
+    }
+
+  private:
+    const Term& _term;
+    Term& _counts;
+  };
+}
+
 void BigattiState::addStep(const Term& pivot) {
   ASSERT(pivot.getVarCount() == getVarCount());
-  _ideal.insertReminimize(pivot);
+  if (!_supportCountsUpdated) {
+    _ideal.insertReminimize(pivot);
+    return;
+  }
+
+  // Same as insertReminimize, but updating the support counts.
+  ASSERT(_ideal.isMinimallyGenerated());
+  if (_ideal.contains(pivot))
+    return;
+  _ideal.removeIf(RemoveMultiplesPredicate(pivot, _supportCounts));
+  _ideal.insert(pivot);
+  for (size_t var = 0; var < getVarCount(); ++var)
+    if (pivot[var] > 0)
+      _supportCounts[var] += 1;
+  ASSERT(_ideal.isMinimallyGenerated());
 }
 
 void BigattiState::run(TaskEngine& tasks) {
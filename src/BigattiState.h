@@ -36,6 +36,20 @@ class BigattiState : public Task {
   Ideal& getIdeal();
   Term& getMultiply();
 
+  /** Returns the number of generators of getIdeal() that each
+   variable divides. The counts are stored and kept up to date by
+   colonStep and addStep as far as that is cheap, and child states
+   inherit them, so this is usually an inexpensive operation. The
+   counts are not updated on changes made directly through the
+   non-const getIdeal(), so such changes must not alter the
+   generators other than reordering them. */
+  const Term& getSupportCounts();
+
+  /** Returns the lower median of the positive exponents of var among
+   the generators. This sorts the generators by their exponent of var
+   rather than keeping the exponents incrementally. The sort is a small
+   part of the time of a pivot split, and the order it leaves behind
+   determines the order that later steps see the generators in. */
   Exponent getMedianPositiveExponentOf(size_t var);
   size_t getTypicalExponent(size_t& var, Exponent& exp);
   void singleDegreeSort(size_t var);
@@ -53,6 +67,9 @@ class BigattiState : public Task {
   BigattiHilbertAlgorithm* _algorithm;
   Ideal _ideal;
   Term _multiply;
+
+  Term _supportCounts; /// valid if _supportCountsUpdated is true
+  bool _supportCountsUpdated;
 };
 
 #endif
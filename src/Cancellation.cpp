@@ -0,0 +1,84 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "Cancellation.h"
+
+#include "FrobbyStringStream.h"
+#include "error.h"
+
+Cancellation::Cancellation():
+  _cancelRequested(0),
+  _running(false),
+  _wasCancelled(false),
+  _timeLimit(0),
+  _stepCount(0),
+  _milliseconds(0) {
+}
+
+Cancellation& Cancellation::getSingleton() {
+  static Cancellation singleton;
+  return singleton;
+}
+
+void Cancellation::start(unsigned long timeLimit) {
+  _cancelRequested = 0;
+  _running = true;
+  _wasCancelled = false;
+  _timeLimit = timeLimit;
+  _stepCount = 0;
+  _milliseconds = 0;
+  _timer.reset();
+}
+
+void Cancellation::finish() {
+  if (!_running)
+    return;
+  _milliseconds = _timer.getMilliseconds();
+  _running = false;
+  _timeLimit = 0;
+  _cancelRequested = 0;
+}
+
+unsigned long Cancellation::getMilliseconds() const {
+  return _running ? _timer.getMilliseconds() : _milliseconds;
+}
+
+void Cancellation::checkTimeLimit() {
+  if (!isInParallelRegion() && _stepCount % WallTimer::StepsPerReading != 0)
+    return;
+  if (_timer.getMilliseconds() >= _timeLimit)
+    stop(true);
+}
+
+void Cancellation::stop(bool timeLimitReached) {
+  if (!_running) {
+    // A call to cancel() while no computation is running is ignored.
+    _cancelRequested = 0;
+    return;
+  }
+  _wasCancelled = true;
+
+  FrobbyStringStream msg;
+  if (timeLimitReached)
+    msg << "The computation was stopped by its time limit of "
+        << _timeLimit << " ms after " << _stepCount << " steps.";
+  else
+    msg << "The computation was cancelled after " << _stepCount
+        << " steps and " << _timer.getMilliseconds() << " ms.";
+  throwError<CancelledException>(msg);
+}
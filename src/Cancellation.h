@@ -0,0 +1,104 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef CANCELLATION_GUARD
+#define CANCELLATION_GUARD
+
+#include "WallTimer.h"
+#include "Parallel.h"
+#include <csignal>
+
+/** Stops a computation before it is done, either because its time
+ limit has passed or because cancel() has been called.
+
+ The algorithms call check() at the boundaries of their steps. A step
+ is a task run by TaskEngine, which covers the Slice Algorithm and the
+ algorithm of Bigatti et.al., a state of the Euler characteristic
+ algorithm or of the enumeration of the Scarf complex, or a node of
+ the square free algorithms and of the independent set search.
+ check() throws CancelledException once the computation is to be
+ stopped, and that exception then unwinds the computation like any
+ other error. The output produced up to that
+ point has been passed on to the consumer, so it is incomplete.
+
+ There is one Cancellation for the whole program, and it only stops
+ computations that are running between a call to start() and a call to
+ finish(). The number of steps and the time taken are kept after the
+ computation is done so that it can be seen how far a stopped
+ computation got. Steps run inside a parallel region are not
+ counted. */
+class Cancellation {
+ public:
+  /** Returns the Cancellation for the whole program. */
+  static Cancellation& getSingleton();
+
+  /** Begins a computation that is stopped once timeLimit wall clock
+   milliseconds have passed. A time limit of zero means that there is
+   no limit. This clears the statistics and any earlier call to
+   cancel(). */
+  void start(unsigned long timeLimit);
+
+  /** Ends the computation begun by start(). The statistics and
+   wasCancelled() keep their values until the next call to start(). */
+  void finish();
+
+  /** Makes the next call to check() stop the computation. This only
+   sets a flag, so it can be called from a signal handler or from
+   another thread. */
+  void cancel() {_cancelRequested = 1;}
+
+  /** Throws CancelledException if the computation is to be stopped.
+   Call this between the steps of an algorithm. */
+  void check() {
+    if (_cancelRequested != 0)
+      stop(false);
+    if (!isInParallelRegion())
+      ++_stepCount;
+    if (_timeLimit != 0)
+      checkTimeLimit();
+  }
+
+  /** Returns true if the most recent computation was stopped by
+   check(). */
+  bool wasCancelled() const {return _wasCancelled;}
+
+  /** Returns the number of steps of the most recent computation so
+   far. */
+  size_t getStepCount() const {return _stepCount;}
+
+  /** Returns the wall clock milliseconds taken by the most recent
+   computation so far. */
+  unsigned long getMilliseconds() const;
+
+ private:
+  Cancellation();
+  Cancellation(const Cancellation&); // unavailable
+  void operator=(const Cancellation&); // unavailable
+
+  void checkTimeLimit();
+  void stop(bool timeLimitReached);
+
+  volatile std::sig_atomic_t _cancelRequested;
+  bool _running;
+  bool _wasCancelled;
+  unsigned long _timeLimit; /// zero if there is no limit
+  size_t _stepCount;
+  unsigned long _milliseconds; /// the time taken once finished
+  WallTimer _timer;
+};
+
+#endif
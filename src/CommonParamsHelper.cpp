@@ -22,6 +22,7 @@
 #include "IOFacade.h"
 #include "BigIdeal.h"
 #include "Ideal.h"
+#include "Term.h"
 #include "TermTranslator.h"
 #include "VarSorter.h"
 #include "Scanner.h"
@@ -165,6 +166,22 @@ void CommonParamsHelper::addPurePowersAtInfinity() {
   _translator->addPurePowersAtInfinity(*_ideal);
 }
 
+bool CommonParamsHelper::isProperSquareFreeIdeal() const {
+  const Ideal& ideal = getIdeal();
+  if (ideal.getGeneratorCount() == 0 || ideal.containsIdentity())
+    return false;
+
+  Term lcm(ideal.getVarCount());
+  ideal.getLcm(lcm);
+  for (size_t var = 0; var < ideal.getVarCount(); ++var) {
+    if (lcm[var] > 1)
+      return false;
+    if (lcm[var] == 1 && getTranslator().getExponent(var, 1) != 1)
+      return false;
+  }
+  return true;
+}
+
 void CommonParamsHelper::readIdeal(const CommonParams& params, Scanner& in) {
   BigIdeal bigIdeal;
   IOFacade facade(params.getPrintActions());
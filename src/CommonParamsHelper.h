@@ -81,6 +81,12 @@ class CommonParamsHelper {
 
   void addPurePowersAtInfinity();
 
+  /** Returns true if the ideal is square free and proper and has
+   generators, and the translator maps the exponent 1 to 1 for each
+   variable that appears. Then algorithms for square free ideals can
+   be run on the ideal and their output translated. */
+  bool isProperSquareFreeIdeal() const;
+
  private:
   // No copies
   CommonParamsHelper(const CommonParamsHelper&);
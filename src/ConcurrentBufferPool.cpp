@@ -0,0 +1,165 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "ConcurrentBufferPool.h"
+
+#include <utility>
+#include <limits>
+
+const size_t ConcurrentBufferPool::MagazineCapacity;
+
+ConcurrentBufferPool::ConcurrentBufferPool(size_t bufferSize):
+  _bufferSize(MemoryBlocks::alignThrowOnOverflow
+              (std::max(bufferSize, sizeof(void*)))),
+  _threadMagazineCount(0),
+  _magazineCount(0) {
+  // Each thread that OpenMP may use gets a magazine, and the last
+  // magazine is shared by any other threads.
+  const size_t magazinesToLoad = getMaxThreadCount() + 1;
+  try {
+    _loaded.reserve(magazinesToLoad);
+    for (size_t i = 0; i < magazinesToLoad; ++i)
+      _loaded.push_back(newMagazine());
+  } catch (...) {
+    for (size_t i = 0; i < _loaded.size(); ++i)
+      delete _loaded[i];
+    throw;
+  }
+  _threadMagazineCount = magazinesToLoad - 1;
+}
+
+ConcurrentBufferPool::~ConcurrentBufferPool() {
+  for (size_t i = 0; i < _loaded.size(); ++i)
+    delete _loaded[i];
+  for (size_t i = 0; i < _full.size(); ++i)
+    delete _full[i];
+  for (size_t i = 0; i < _empty.size(); ++i)
+    delete _empty[i];
+}
+
+size_t ConcurrentBufferPool::getMemoryUsage() {
+  MutexLocker locker(_depotMutex);
+  return _blocks.getMemoryUsage();
+}
+
+void* ConcurrentBufferPool::allocSlow(size_t thread) {
+  MutexLocker locker(_depotMutex);
+  if (thread < _threadMagazineCount)
+    return allocFromDepot(_loaded[thread]);
+
+  Magazine*& shared = _loaded.back();
+  if (shared->count == 0)
+    return allocFromDepot(shared);
+  --shared->count;
+  return shared->buffers[shared->count];
+}
+
+void ConcurrentBufferPool::freeSlow(size_t thread, void* ptr) {
+  MutexLocker locker(_depotMutex);
+  if (thread < _threadMagazineCount) {
+    freeToDepot(_loaded[thread], ptr);
+    return;
+  }
+
+  Magazine*& shared = _loaded.back();
+  if (shared->count == MagazineCapacity) {
+    freeToDepot(shared, ptr);
+    return;
+  }
+  shared->buffers[shared->count] = ptr;
+  ++shared->count;
+}
+
+void* ConcurrentBufferPool::allocFromDepot(Magazine*& magazine) {
+  ASSERT(magazine->count == 0);
+
+  if (!_full.empty()) {
+    // Cannot throw as there is capacity for all magazines.
+    _empty.push_back(magazine);
+    magazine = _full.back();
+    _full.pop_back();
+  } else
+    fillWithNewBuffers(*magazine);
+
+  ASSERT(magazine->count > 0);
+  --magazine->count;
+  return magazine->buffers[magazine->count];
+}
+
+void ConcurrentBufferPool::freeToDepot(Magazine*& magazine, void* ptr) {
+  ASSERT(magazine->count == MagazineCapacity);
+
+  // fillWithNewBuffers makes an empty magazine for each magazine worth
+  // of buffers that it hands out. All buffers cannot fit in the full
+  // magazines, so there must be an empty magazine to swap in. The
+  // vectors have capacity for all magazines, so nothing here can
+  // throw.
+  ASSERT(!_empty.empty());
+  _full.push_back(magazine);
+  magazine = _empty.back();
+  _empty.pop_back();
+
+  ASSERT(magazine->count == 0);
+  magazine->buffers[0] = ptr;
+  magazine->count = 1;
+}
+
+void ConcurrentBufferPool::fillWithNewBuffers(Magazine& magazine) {
+  ASSERT(magazine.count == 0);
+
+  // Make the empty magazine that freeToDepot relies on before handing
+  // out the buffers.
+  _empty.push_back(newMagazine());
+
+  while (magazine.count < MagazineCapacity) {
+    Block& block = _blocks.getFrontBlock();
+    if (block.position() == block.end()) {
+      // ** Calculate size of block (doubles capacity)
+      size_t size = block.getBytesInBlock();
+      if (size == 0) {
+        if (_bufferSize > std::numeric_limits<size_t>::max() /
+            MagazineCapacity)
+          throw bad_alloc(); // _bufferSize * MagazineCapacity overflows
+        size = _bufferSize * MagazineCapacity;
+      } else {
+        if (size > std::numeric_limits<size_t>::max() / 2)
+          throw bad_alloc(); // size * 2 overflows
+        size *= 2;
+      }
+      ASSERT(MemoryBlocks::alignNoOverflow(size) == size);
+      _blocks.allocBlock(size);
+      continue;
+    }
+
+    magazine.buffers[magazine.count] = block.position();
+    ++magazine.count;
+    block.setPosition(block.position() + _bufferSize);
+  }
+}
+
+ConcurrentBufferPool::Magazine* ConcurrentBufferPool::newMagazine() {
+  // Reserve first so that moving magazines between the vectors never
+  // needs to allocate memory.
+  _full.reserve(_magazineCount + 1);
+  _empty.reserve(_magazineCount + 1);
+
+  Magazine* magazine = new Magazine();
+  magazine->count = 0;
+  ++_magazineCount;
+  return magazine;
+}
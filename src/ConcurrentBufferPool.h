@@ -0,0 +1,145 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef CONCURRENT_BUFFER_POOL_GUARD
+#define CONCURRENT_BUFFER_POOL_GUARD
+
+#include "MemoryBlocks.h"
+#include "Parallel.h"
+#include <vector>
+
+/** Allocator for allocating and freeing same-size buffers from
+ several threads at once. A buffer can be freed on a different thread
+ than the one that allocated it.
+
+ Each thread has a magazine, which is a small stack of free
+ buffers. Allocation pops a buffer from the magazine of the calling
+ thread and freeing pushes onto it, so in the common case this is as
+ fast as BufferPool and takes no lock. When a magazine is empty on
+ alloc or full on free, it is exchanged for a full or empty magazine
+ from a shared depot. Only that exchange takes a lock, and it moves
+ MagazineCapacity buffers at a time. The depot gets fresh buffers from
+ a geometrically growing list of blocks just like BufferPool.
+
+ Magazines are assigned by the index of the thread within its OpenMP
+ team, so a pool must not be used from nested parallel regions that
+ are active at the same time. Threads beyond the thread count that
+ OpenMP reported at construction share a magazine under the lock.
+
+ All allocations are freed when the pool is destructed. */
+class ConcurrentBufferPool {
+ public:
+  /** bufferSize is how many bytes are returned by each call to alloc. */
+  ConcurrentBufferPool(size_t bufferSize);
+  ~ConcurrentBufferPool();
+
+  /** Returns a pointer to an array of getBufferSize() chars. The
+   alignment is as for Arena. Throws bad_alloc if no more memory can
+   be allocated. Never returns null. */
+  inline void* alloc();
+
+  /** Makes the buffer at ptr available for reuse. ptr must be a value
+   previously returned by alloc on this same object that hasn't been
+   freed already since then. ptr must not be null. This method cannot
+   throw an exception. */
+  inline void free(void* ptr);
+
+  /** Returns how many bytes are in each buffer. Can be a few bytes
+   more than requested due to internal requirements on the size of the
+   buffers. Will never be less than requested. */
+  size_t getBufferSize() const {return _bufferSize;}
+
+  /** Returns the total amount of memory allocated for buffers by this
+   object. Includes excess capacity that has not been allocated by a
+   client yet. */
+  size_t getMemoryUsage();
+
+  /** The number of buffers in a full magazine. */
+  static const size_t MagazineCapacity = 64;
+
+ private:
+  ConcurrentBufferPool(const ConcurrentBufferPool&); // unavailable
+  void operator=(const ConcurrentBufferPool&); // unavailable
+
+  struct Magazine {
+    size_t count;
+    void* buffers[MagazineCapacity];
+  };
+
+  /** As alloc where magazine is empty. The depot must be locked. */
+  void* allocFromDepot(Magazine*& magazine);
+
+  /** As free where magazine is full. The depot must be locked. */
+  void freeToDepot(Magazine*& magazine, void* ptr);
+
+  /** Fills the empty magazine with fresh buffers. The depot must be
+   locked. */
+  void fillWithNewBuffers(Magazine& magazine);
+
+  /** Returns a new empty magazine and makes room to store it in the
+   depot without allocating. The depot must be locked. */
+  Magazine* newMagazine();
+
+  void* allocSlow(size_t thread);
+  void freeSlow(size_t thread, void* ptr);
+
+  typedef MemoryBlocks::Block Block;
+
+  const size_t _bufferSize; /// size of the buffers returned by alloc
+
+  /** The magazine of each thread. The last entry is shared by the
+   threads that do not have their own magazine. */
+  std::vector<Magazine*> _loaded;
+
+  /** The number of threads that have their own magazine. */
+  size_t _threadMagazineCount;
+
+  // ***** The depot. All fields below are protected by _depotMutex.
+  Mutex _depotMutex;
+  std::vector<Magazine*> _full; /// full magazines
+  std::vector<Magazine*> _empty; /// empty magazines
+  size_t _magazineCount; /// total number of magazines
+  MemoryBlocks _blocks; /// source of fresh buffers
+};
+
+inline void* ConcurrentBufferPool::alloc() {
+  const size_t thread = getThreadIndex();
+  if (thread < _threadMagazineCount) {
+    Magazine& magazine = *_loaded[thread];
+    if (magazine.count > 0) {
+      --magazine.count;
+      return magazine.buffers[magazine.count];
+    }
+  }
+  return allocSlow(thread);
+}
+
+inline void ConcurrentBufferPool::free(void* ptr) {
+  ASSERT(ptr != 0);
+  const size_t thread = getThreadIndex();
+  if (thread < _threadMagazineCount) {
+    Magazine& magazine = *_loaded[thread];
+    if (magazine.count < MagazineCapacity) {
+      magazine.buffers[magazine.count] = ptr;
+      ++magazine.count;
+      return;
+    }
+  }
+  freeSlow(thread, ptr);
+}
+
+#endif
@@ -0,0 +1,105 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "ConcurrentBufferPool.h"
+#include "tests.h"
+
+#include <list>
+#include <vector>
+#include <algorithm>
+
+TEST_SUITE(ConcurrentBufferPool)
+
+TEST(ConcurrentBufferPool, NoOp) {
+  ConcurrentBufferPool pool1(0);
+  ConcurrentBufferPool pool2(1);
+  ConcurrentBufferPool pool3(100);
+}
+
+TEST(ConcurrentBufferPool, GetMemoryUsage) {
+  ConcurrentBufferPool pool(100);
+  ASSERT_EQ(pool.getMemoryUsage(), 0);
+  pool.alloc();
+  ASSERT_TRUE(pool.getMemoryUsage() >= 100);
+}
+
+TEST(ConcurrentBufferPool, Reuse) {
+  ConcurrentBufferPool pool(5);
+  void* a = pool.alloc();
+  pool.free(a);
+  ASSERT_EQ(pool.alloc(), a);
+}
+
+TEST(ConcurrentBufferPool, Distinct) {
+  ConcurrentBufferPool pool(3);
+  std::vector<char*> ptrs;
+  for (size_t i = 0; i < 1000; ++i) {
+    ptrs.push_back(static_cast<char*>(pool.alloc()));
+    *ptrs.back() = static_cast<char>(i);
+  }
+  std::sort(ptrs.begin(), ptrs.end());
+  for (size_t i = 1; i < ptrs.size(); ++i)
+    ASSERT_TRUE_SILENT(ptrs[i - 1] + pool.getBufferSize() <= ptrs[i]);
+}
+
+TEST(ConcurrentBufferPool, Grind) {
+  // Go through many magazines so that full and empty magazines are
+  // exchanged with the depot.
+  ConcurrentBufferPool pool(1001);
+  std::list<void*> ptrs;
+  for (size_t i = 0; i < 10; ++i) {
+    for (size_t j = 0; j < 1000; ++j)
+      ptrs.push_back(pool.alloc());
+    // free most but not all and in FIFO order
+    for (size_t j = 0; j < 900; ++j) {
+      pool.free(ptrs.front());
+      ptrs.pop_front();
+    }
+  }
+  // free rest in LIFO order
+  while (!ptrs.empty()) {
+    pool.free(ptrs.back());
+    ptrs.pop_back();
+  }
+}
+
+TEST(ConcurrentBufferPool, Threads) {
+  // Each thread allocates buffers and frees those of other threads.
+  ConcurrentBufferPool pool(sizeof(long));
+  const long bufferCount = 10000;
+  std::vector<long*> ptrs(bufferCount);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (long i = 0; i < bufferCount; ++i) {
+    ptrs[i] = static_cast<long*>(pool.alloc());
+    *ptrs[i] = i;
+  }
+  std::vector<long*> sorted(ptrs);
+  std::sort(sorted.begin(), sorted.end());
+  ASSERT_TRUE(std::adjacent_find(sorted.begin(), sorted.end()) ==
+              sorted.end());
+  for (long i = 0; i < bufferCount; ++i)
+    ASSERT_EQ_SILENT(*ptrs[i], i);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 7)
+#endif
+  for (long i = 0; i < bufferCount; ++i)
+    pool.free(ptrs[bufferCount - 1 - i]);
+}
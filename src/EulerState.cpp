@@ -20,6 +20,7 @@
 #include "RawSquareFreeTerm.h"
 #include "Ideal.h"
 #include "Arena.h"
+#include "TreeTrace.h"
 
 #include <limits>
 
@@ -74,12 +75,16 @@ EulerState* EulerState::rawConstruct(size_t varCount, size_t capacity,
   state->eliminated = arena->allocArrayNoCon<Word>(wordsElim).first;
   state->sign = 1;
   state->_parent = 0;
+  state->_divCounts =
+    arena->allocArrayNoCon<size_t>(wordsElim * BitsPerWord).first;
+  state->_hasDivCounts = false;
 
   return state;
 }
 
 EulerState* EulerState::inPlaceStdSplit(size_t pivotVar) {
   ASSERT(pivotVar < getVarCount());
+  traceNodeKind(TreeTrace::PivotSplit, pivotVar, 1);
   EulerState* subState = makeSumSubState(pivotVar);
   toColonSubState(pivotVar);
   return subState;
@@ -87,6 +92,10 @@ EulerState* EulerState::inPlaceStdSplit(size_t pivotVar) {
 
 EulerState* EulerState::inPlaceStdSplit(Word* pivot) {
   ASSERT(pivot != 0);
+  TreeTrace& trace = TreeTrace::getSingleton();
+  if (trace.isEnabled())
+    trace.setNodeKind(TreeTrace::PivotSplit, TreeTrace::NoVar,
+                      Ops::getSizeOfSupport(pivot, getVarCount()));
   EulerState* subState = makeSumSubState(pivot);
   toColonSubState(pivot);
   return subState;
@@ -94,6 +103,11 @@ EulerState* EulerState::inPlaceStdSplit(Word* pivot) {
 
 EulerState* EulerState::inPlaceGenSplit(size_t pivotIndex) {
   ASSERT(pivotIndex < getIdeal().getGeneratorCount());
+  TreeTrace& trace = TreeTrace::getSingleton();
+  if (trace.isEnabled())
+    trace.setNodeKind(TreeTrace::GeneratorSplit, TreeTrace::NoVar,
+                      Ops::getSizeOfSupport(getIdeal().getGenerator(pivotIndex),
+                                            getVarCount()));
 
   const size_t varCount = ideal->getVarCount();
   const size_t capacity = ideal->getGeneratorCount();
@@ -122,6 +136,7 @@ bool EulerState::toColonSubState(const Word* pivot) {
   const size_t genCountBefore = getIdeal().getGeneratorCount();
   ideal->colonReminimize(pivot);
   Ops::lcmInPlace(eliminated, pivot, ideal->getVarCount());
+  updateDivCountsAfterColon(pivot, genCountBefore);
   ASSERT(debugIsValid());
   return genCountBefore != getIdeal().getGeneratorCount();
 }
@@ -133,6 +148,7 @@ bool EulerState::toColonSubState(size_t pivotVar) {
   const size_t genCountBefore = getIdeal().getGeneratorCount();
   ideal->colonReminimize(pivotVar);
   Ops::setExponent(eliminated, pivotVar, true);
+  updateDivCountsAfterColon(pivotVar, genCountBefore);
   ASSERT(debugIsValid());
   return genCountBefore != getIdeal().getGeneratorCount();
 }
@@ -143,6 +159,7 @@ void EulerState::toColonSubStateNoReminimizeNecessary(size_t pivotVar) {
 
   ideal->colon(pivotVar);
   Ops::setExponent(eliminated, pivotVar, true);
+  updateDivCountsAfterColon(pivotVar, getIdeal().getGeneratorCount());
   ASSERT(debugIsValid());
 }
 
@@ -152,6 +169,7 @@ void EulerState::toColonSubStateNoReminimizeNecessary(Word* pivot) {
 
   ideal->colon(pivot);
   Ops::lcmInPlace(eliminated, pivot, getVarCount());
+  updateDivCountsAfterColon(pivot, getIdeal().getGeneratorCount());
   ASSERT(debugIsValid());
 }
 
@@ -188,6 +206,7 @@ EulerState* EulerState::makeSumSubState(Word* pivot) {
 }
 
 void EulerState::transpose() {
+  _hasDivCounts = false;
   ideal->transpose(eliminated);
   ideal->minimize();
   Ops::setToIdentity(eliminated, ideal->getVarCount());
@@ -197,12 +216,47 @@ void EulerState::compactEliminatedVariablesIfProfitable() {
   const size_t varCount = getVarCount();
   const size_t varsLeft = getNonEliminatedVarCount();
   if (Ops::getWordCount(varCount) > Ops::getWordCount(varsLeft)) {
+	_hasDivCounts = false;
 	ideal->compact(eliminated);
 	Ops::setToIdentity(eliminated, ideal->getVarCount());
 	ASSERT(debugIsValid());
   }
 }
 
+void EulerState::removeGenerator(size_t index) {
+  if (_hasDivCounts)
+    Ops::decrementAtSupport
+      (ideal->getGenerator(index), _divCounts, getVarCount());
+  ideal->removeGenerator(index);
+}
+
+void EulerState::getVarDividesCounts(vector<size_t>& divCounts) {
+  const size_t varCount = getVarCount();
+  if (!_hasDivCounts) {
+    ideal->getVarDividesCounts(_divCounts);
+    _hasDivCounts = true;
+  }
+  ASSERT(debugHasValidDivCounts());
+  divCounts.reserve(varCount + BitsPerWord);
+  divCounts.assign(_divCounts, _divCounts + varCount);
+}
+
+void EulerState::updateDivCountsAfterColon(const Word* pivot,
+                                           size_t genCountBefore) {
+  if (genCountBefore != getIdeal().getGeneratorCount())
+    _hasDivCounts = false;
+  else if (_hasDivCounts)
+    Ops::toZeroAtSupport(pivot, _divCounts, getVarCount());
+}
+
+void EulerState::updateDivCountsAfterColon(size_t pivotVar,
+                                           size_t genCountBefore) {
+  if (genCountBefore != getIdeal().getGeneratorCount())
+    _hasDivCounts = false;
+  else if (_hasDivCounts)
+    _divCounts[pivotVar] = 0;
+}
+
 void EulerState::print(FILE* out) {
   fputs("** an Euler characteristic algorithm state:\n", out);
   fprintf(out, "State sign: %s\n", sign == 1 ? "+1" : "-1");
@@ -226,6 +280,17 @@ bool EulerState::debugIsValid() const {
 	  ideal->getNotRelativelyPrime(eliminated) !=
 	  ideal->getGeneratorCount())
 	return false;
+  return debugHasValidDivCounts();
+}
+
+bool EulerState::debugHasValidDivCounts() const {
+  if (!_hasDivCounts)
+    return true;
+  vector<size_t> divCounts;
+  ideal->getVarDividesCounts(divCounts);
+  for (size_t var = 0; var < divCounts.size(); ++var)
+    if (divCounts[var] != _divCounts[var])
+      return false;
   return true;
 }
 #endif
@@ -235,6 +300,8 @@ void EulerState::toZero() {
   eliminated = 0;
   sign = 1;
   _parent = 0;
+  _divCounts = 0;
+  _hasDivCounts = false;
 }
 
 size_t EulerState::getNonEliminatedVarCount() const {
@@ -18,6 +18,7 @@
 #define EULER_STATE_GUARD
 
 #include "RawSquareFreeIdeal.h"
+#include <vector>
 
 class Ideal;
 class Arena;
@@ -52,7 +53,16 @@ public:
   size_t getVarCount() const {return getIdeal().getVarCount();}
   size_t getNonEliminatedVarCount() const;
 
-  void removeGenerator(size_t index) {ideal->removeGenerator(index);}
+  void removeGenerator(size_t index);
+
+  /** Sets divCounts[var] to the number of generators that var
+   divides. The counts are kept in the state and updated as
+   generators are removed and variables are eliminated, so they are
+   only computed from the ideal again after a reminimization has
+   removed generators or the ideal has been transposed or compacted.
+   divCounts gets capacity for BitsPerWord entries more than there are
+   variables. */
+  void getVarDividesCounts(vector<size_t>& divCounts);
 
   void compactEliminatedVariablesIfProfitable();
 
@@ -60,6 +70,7 @@ public:
 
 #ifdef DEBUG
   bool debugIsValid() const;
+  bool debugHasValidDivCounts() const;
 #endif
 
 private:
@@ -73,11 +84,22 @@ private:
 
   void deallocate();
 
+  /** Updates the cached counts after a colon by pivot, which removed
+   generators if genCountBefore is not the current generator count. */
+  void updateDivCountsAfterColon(const Word* pivot, size_t genCountBefore);
+  void updateDivCountsAfterColon(size_t pivotVar, size_t genCountBefore);
+
   RawSquareFreeIdeal* ideal;
   Word* eliminated;
   int sign;
   Arena* _alloc;
   EulerState* _parent;
+
+  /** The number of generators that each variable divides. Only valid
+   if _hasDivCounts is true. There is space for BitsPerWord times the
+   number of words per term of the ideal both ways around. */
+  size_t* _divCounts;
+  bool _hasDivCounts;
 };
 
 #endif
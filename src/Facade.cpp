@@ -17,6 +17,8 @@
 #include "stdinc.h"
 #include "Facade.h"
 
+#include "Profiler.h"
+
 Facade::Facade(bool printActions):
   _printActions(printActions)
 #ifdef DEBUG
@@ -41,6 +43,7 @@ void Facade::beginAction(const char* message) {
   _doingAnAction = true;
 #endif
 
+  Profiler::getSingleton().beginPhase(message);
   if (!_printActions)
     return;
 
@@ -54,6 +57,7 @@ void Facade::endAction() {
   _doingAnAction = false;
 #endif
 
+  Profiler::getSingleton().endPhase();
   if (!_printActions)
     return;
 
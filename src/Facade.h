@@ -41,7 +41,8 @@ class Facade {
 
   /** Prints message to standard error if printing is turned on, and
       records the time when the action started. endAction() must be
-      called in-between two calls to beginAction.
+      called in-between two calls to beginAction. The action is also
+      a phase for the Profiler.
   */
   void beginAction(const char* message);
 
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <exception>
+#include <cstring>
 
 // This is a replacement for stringstream, which may seem weird since
 // stringstream should work perfectly fine for any purpose where
@@ -80,30 +81,41 @@ FrobbyStringStream::operator const string&() const {
 
 void FrobbyStringStream::appendIntegerToString(string& str,
                                                unsigned long integer) {
-  unsigned long initialLength = str.size();
-
-  // Append string representation of integer with digits in reverse
-  // order.
+  // Write the digits from the back of a buffer so that they do not
+  // need to be reversed afterwards. 3 digits per byte is more than
+  // enough for a decimal representation.
+  char digits[sizeof(unsigned long) * 3];
+  char* const end = digits + sizeof(digits);
+  char* begin = end;
   do {
     unsigned long quotient = integer / 10;
     unsigned long remainder = integer - quotient * 10; // faster than %
 
-    char digit = static_cast<char>(remainder + '0');
-    str += digit;
+    --begin;
+    *begin = static_cast<char>(remainder + '0');
 
     integer = quotient;
 
     // condition at end so that zero maps to "0" rather than "".
   } while (integer != 0);
 
-  // Reverse the digits (and only the digits) to get the correct
-  // order.
-  reverse(str.begin() + initialLength, str.end());
+  str.append(begin, end);
 }
 
 void FrobbyStringStream::appendIntegerToString(string& str,
                                                const mpz_class& integer) {
-  str += integer.get_str();
+  if (integer.fits_ulong_p()) {
+    appendIntegerToString(str, integer.get_ui());
+    return;
+  }
+
+  // Let GMP write directly into str instead of going through a
+  // temporary string. mpz_sizeinbase can be one too large, and there
+  // has to be room for a sign and the terminating null.
+  const size_t initialLength = str.size();
+  str.resize(initialLength + mpz_sizeinbase(integer.get_mpz_t(), 10) + 2);
+  mpz_get_str(&str[initialLength], 10, integer.get_mpz_t());
+  str.resize(initialLength + strlen(&str[initialLength]));
 }
 
 void FrobbyStringStream::parseInteger(mpz_class& integer, const string& str) {
@@ -42,6 +42,9 @@ class FrobbyStringStream {
 
   void clear() {_str.clear();}
 
+  /** Appends the decimal representation of integer to str. Unlike
+   the rest of this class these are fast, as they are used for writing
+   output. */
   static void appendIntegerToString(string& str, unsigned long integer);
   static void appendIntegerToString(string& str, const mpz_class& integer);
 
@@ -0,0 +1,55 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2007 Bjarke Hammersholt Roune (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "FrobbyStringStream.h"
+#include "tests.h"
+
+#include <limits>
+
+TEST_SUITE(FrobbyStringStream)
+
+namespace {
+  string toString(unsigned long integer) {
+    string str;
+    FrobbyStringStream::appendIntegerToString(str, integer);
+    return str;
+  }
+
+  string toString(const mpz_class& integer) {
+    string str("x");
+    FrobbyStringStream::appendIntegerToString(str, integer);
+    return str.substr(1);
+  }
+}
+
+TEST(FrobbyStringStream, AppendUnsignedLong) {
+  ASSERT_EQ(toString(0ul), "0");
+  ASSERT_EQ(toString(7ul), "7");
+  ASSERT_EQ(toString(1230ul), "1230");
+  ASSERT_EQ(toString(std::numeric_limits<unsigned long>::max()),
+            mpz_class(std::numeric_limits<unsigned long>::max()).get_str());
+}
+
+TEST(FrobbyStringStream, AppendMpz) {
+  ASSERT_EQ(toString(mpz_class(0)), "0");
+  ASSERT_EQ(toString(mpz_class(-1)), "-1");
+  ASSERT_EQ(toString(mpz_class(4096)), "4096");
+
+  mpz_class big("-123456789012345678901234567890");
+  ASSERT_EQ(toString(big), "-123456789012345678901234567890");
+  ASSERT_EQ(toString(mpz_class(-big)), "123456789012345678901234567890");
+}
@@ -34,6 +34,18 @@
 template<class Key>
 class FrobbyHash {};
 
+/** This template specialization makes the hash code of an mpz_class
+ available to the implementation of HashMap.
+*/
+template<>
+class FrobbyHash<mpz_class> {
+ public:
+  size_t operator()(const mpz_class& i) const {
+    // The constant is a prime. This method needs to be improved.
+    return mpz_fdiv_ui(i.get_mpz_t(), 2106945901u);
+  }
+};
+
 // *********************************************************
 #ifdef __GNUC__ // Only GCC defines this macro
 #include "hash_map/hash_map"
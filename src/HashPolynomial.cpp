@@ -62,6 +62,15 @@ void HashPolynomial::add(bool plus, const Term& term) {
     _terms.erase(term);
 }
 
+void HashPolynomial::add(const HashPolynomial& poly) {
+  ASSERT(_varCount == poly._varCount);
+
+  TermMap::const_iterator termsEnd = poly._terms.end();
+  TermMap::const_iterator it = poly._terms.begin();
+  for (; it != termsEnd; ++it)
+    add(it->second, it->first);
+}
+
 namespace {
   /** Helper class for feedTo. */
   class RefCompare {
@@ -52,6 +52,9 @@ class HashPolynomial {
    is true or false, respectively. */
   void add(bool plus, const Term& term);
 
+  /** Add poly to this polynomial. */
+  void add(const HashPolynomial& poly);
+
   void feedTo(const TermTranslator& translator,
               CoefBigTermConsumer& consumer,
               bool inCanonicalOrder) const;
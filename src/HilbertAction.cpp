@@ -24,8 +24,66 @@
 #include "ScarfFacade.h"
 #include "DataType.h"
 #include "ScarfParams.h"
+#include "Portfolio.h"
+#include "WallTimer.h"
+#include "BigIdeal.h"
+#include "IOFacade.h"
+#include "Scanner.h"
 #include "error.h"
 
+namespace {
+  /** Runs the entries of a portfolio of Hilbert-Poincare series
+   algorithms. An entry is the name of an algorithm, optionally
+   followed by a colon and a split strategy. */
+  class HilbertPortfolio : public Portfolio {
+  public:
+    HilbertPortfolio(const vector<string>& entries,
+                     HilbertAction& action,
+                     SliceParameters& sliceParams):
+      Portfolio(entries),
+      _action(action),
+      _sliceParams(sliceParams) {
+    }
+
+    static string getAlgorithm(const string& entry) {
+      return entry.substr(0, entry.find(':'));
+    }
+
+  protected:
+    virtual void runEntry(const string& entry) {
+      const size_t colon = entry.find(':');
+      if (colon != string::npos)
+        _sliceParams.setSplit(entry.substr(colon + 1));
+      _action.perform(getAlgorithm(entry));
+    }
+
+  private:
+    HilbertAction& _action;
+    SliceParameters& _sliceParams;
+  };
+
+  /** Returns true if ideal is square free, not zero and not the whole
+   ring. Such ideals are handled by the algorithms for square free
+   ideals if -squareFree is on. This can miss a square free ideal that
+   has a non-minimal generator with a larger exponent. */
+  bool isSquareFree(const BigIdeal& ideal) {
+    if (ideal.getGeneratorCount() == 0)
+      return false;
+    for (size_t term = 0; term < ideal.getGeneratorCount(); ++term) {
+      bool isIdentity = true;
+      for (size_t var = 0; var < ideal.getVarCount(); ++var) {
+        if (ideal[term][var] > 1)
+          return false;
+        if (ideal[term][var] != 0)
+          isIdentity = false;
+      }
+      if (isIdentity)
+        return false;
+    }
+    return true;
+  }
+}
+
 HilbertAction::HilbertAction():
   Action
 (staticGetName(),
@@ -41,7 +99,7 @@ HilbertAction::HilbertAction():
 
   _io(DataType::getMonomialIdealType(), DataType::getPolynomialType()),
 
-  _sliceParams(false, true, true),
+  _sliceParams(false, true, true, false, true, true),
 
   _univariate
   ("univariate",
@@ -50,26 +108,46 @@ HilbertAction::HilbertAction():
 
   _algorithm
   ("algorithm",
-   "Which algorithm to use. Options are slice, bigatti and deform.",
-   "bigatti") {
+   "Which algorithm to use. Options are slice, bigatti, deform and\n"
+   "portfolio. The option portfolio runs the algorithms given by\n"
+   "-portfolio at the same time as separate processes and outputs the\n"
+   "result of the first one to finish.",
+   "bigatti"),
+
+  _portfolio
+  ("portfolio",
+   "The algorithms to run for -algorithm portfolio, separated by commas.\n"
+   "An algorithm can be followed by a colon and a split strategy, as in\n"
+   "slice:minimum. With -time the algorithm that finished first is\n"
+   "reported. On square free input bigatti and slice both use the\n"
+   "algorithm for square free ideals, so only the first of them is run.",
+   "bigatti,slice") {
 
   _params.add(_io);
   _params.add(_sliceParams);
   _params.add(_univariate);
   _params.add(_algorithm);
+  _params.add(_portfolio);
 
   addScarfParams(_params);
 }
 
 void HilbertAction::perform() {
-  if (_algorithm.getValue() == "bigatti") {
+  if (_algorithm.getValue() == "portfolio")
+    performPortfolio();
+  else
+    perform(_algorithm.getValue());
+}
+
+void HilbertAction::perform(const string& algorithm) {
+  if (algorithm == "bigatti") {
     BigattiParams params(_params);
     BigattiFacade facade(params);
     if (_univariate)
       facade.computeUnivariateHilbertSeries();
     else
       facade.computeMultigradedHilbertSeries();
-  } else if (_algorithm.getValue() == "slice") {
+  } else if (algorithm == "slice") {
     SliceParams params(_params);
     validateSplit(params, false, false);
     SliceFacade sliceFacade(params, DataType::getPolynomialType());
@@ -77,7 +155,7 @@ void HilbertAction::perform() {
       sliceFacade.computeUnivariateHilbertSeries();
     else
       sliceFacade.computeMultigradedHilbertSeries();
-  } else if (_algorithm.getValue() == "deform") {
+  } else if (algorithm == "deform") {
     ScarfParams params(_params);
     ScarfFacade facade(params);
     if (_univariate)
@@ -86,7 +164,78 @@ void HilbertAction::perform() {
       facade.computeMultigradedHilbertSeries();
   } else
     reportError("Unknown Hilbert-Poincare series algorithm \"" +
-                _algorithm.getValue() + "\".");
+                algorithm + "\".");
+}
+
+void HilbertAction::performPortfolio() {
+  vector<string> entries;
+  Portfolio::parseEntries(_portfolio.getValue(), entries);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const string algorithm = HilbertPortfolio::getAlgorithm(entries[i]);
+    if (algorithm != "bigatti" && algorithm != "slice" &&
+        algorithm != "deform")
+      reportError("Unknown Hilbert-Poincare series algorithm \"" +
+                  algorithm + "\" in the portfolio.");
+  }
+
+  // The input is copied so that it can be read both here and by the
+  // entries.
+  FILE* input = tmpfile();
+  if (input == 0)
+    reportError("Could not create a temporary file for the portfolio.");
+  try {
+    int c;
+    while ((c = getchar()) != EOF)
+      putc(c, input);
+
+    // Both bigatti and slice run the algorithm for square free ideals
+    // on square free input, so only the first of those entries is
+    // raced then.
+    if (isSquareFreeInput(input)) {
+      vector<string> distinct;
+      bool hasSquareFreeEntry = false;
+      for (size_t i = 0; i < entries.size(); ++i) {
+        if (HilbertPortfolio::getAlgorithm(entries[i]) != "deform") {
+          if (hasSquareFreeEntry)
+            continue;
+          hasSquareFreeEntry = true;
+        }
+        distinct.push_back(entries[i]);
+      }
+      entries.swap(distinct);
+    }
+    rewind(input);
+
+    WallTimer timer;
+    HilbertPortfolio portfolio(entries, *this, _sliceParams);
+    const size_t winner = portfolio.race(input, stdout, stderr);
+    if (_printActions) {
+      fprintf(stderr, "The portfolio entry %s finished first. ",
+              entries[winner].c_str());
+      timer.print(stderr);
+      fputc('\n', stderr);
+    }
+  } catch (...) {
+    fclose(input);
+    throw;
+  }
+  fclose(input);
+}
+
+bool HilbertAction::isSquareFreeInput(FILE* input) {
+  BigattiParams params(_params);
+  if (!params.getUseSquareFree())
+    return false;
+
+  // Reading the input does not start any threads, so the entries are
+  // still forked from a process with a single thread.
+  rewind(input);
+  BigIdeal ideal;
+  Scanner in(_io.getInputFormat(), input);
+  _io.autoDetectInputFormat(in);
+  _io.validateFormats();
+  IOFacade(false).readIdeal(in, ideal);
+  return isSquareFree(ideal);
 }
 
 const char* HilbertAction::staticGetName() {
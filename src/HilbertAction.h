@@ -29,13 +29,26 @@ class HilbertAction : public Action {
 
   virtual void perform();
 
+  /** Computes the Hilbert-Poincare series using the given algorithm
+   instead of the one given by the parameters. */
+  void perform(const string& algorithm);
+
   static const char* staticGetName();
 
  private:
+  /** Runs the algorithms of the portfolio parameter at the same time
+   and outputs the result of the first one to finish. */
+  void performPortfolio();
+
+  /** Returns true if input holds a square free ideal that the
+   algorithms for square free ideals are used for. */
+  bool isSquareFreeInput(FILE* input);
+
   IOParameters _io;
   SliceParameters _sliceParams;
   BoolParameter _univariate;
   StringParameter _algorithm;
+  StringParameter _portfolio;
 };
 
 #endif
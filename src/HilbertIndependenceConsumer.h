@@ -40,6 +40,7 @@ public:
 
   virtual void run(TaskEngine& engine);
   virtual void dispose();
+  virtual bool isTreeNode() const {return false;}
 
   CoefTermConsumer* getLeftConsumer();
 
@@ -40,6 +40,7 @@ class HilbertSlice : public Slice {
   virtual bool baseCase(bool simplified);
 
   virtual Slice& operator=(const Slice& slice);
+  virtual bool setToInnerSliceOf(const Slice& slice, const Term& pivot);
 
   virtual bool simplifyStep();
 
@@ -25,6 +25,8 @@
 #include "IndependenceSplitter.h"
 #include "HilbertIndependenceConsumer.h"
 #include "ElementDeleter.h"
+#include "Profiler.h"
+#include "TreeTrace.h"
 
 HilbertStrategy::HilbertStrategy(CoefTermConsumer* consumer,
                                  const SplitStrategy* splitStrategy):
@@ -34,6 +36,10 @@ HilbertStrategy::HilbertStrategy(CoefTermConsumer* consumer,
   _consumer(consumer) {
 }
 
+HilbertStrategy::~HilbertStrategy() {
+  disposePendingTasks();
+}
+
 void HilbertStrategy::run(const Ideal& ideal) {
   ASSERT(_consumer != 0);
 
@@ -41,7 +47,8 @@ void HilbertStrategy::run(const Ideal& ideal) {
   Ideal sliceIdeal(varCount);
 
   if (!ideal.contains(Term(varCount))) {
-    _consumer->consume(1, Term(varCount));
+    if (!hasShards() || _shards->getStep() != SliceShards::SplitStep)
+      _consumer->consume(1, Term(varCount));
 
     if (ideal.getGeneratorCount() > 0) {
       Term allOnes(varCount);
@@ -53,6 +60,12 @@ void HilbertStrategy::run(const Ideal& ideal) {
     }
   }
 
+  ProfilePhase phase("Slice algorithm");
+  if (hasShards()) {
+    runWithShards(ideal, sliceIdeal);
+    return;
+  }
+
   auto_ptr<Slice> slice
     (new HilbertSlice(*this, sliceIdeal, Ideal(varCount),
                       Term(varCount), _consumer));
@@ -63,17 +76,47 @@ void HilbertStrategy::run(const Ideal& ideal) {
   _consumerCacheDeleter.deleteElements();
 }
 
+void HilbertStrategy::runWithShards(const Ideal& ideal,
+                                    const Ideal& sliceIdeal) {
+  ASSERT(_consumer != 0);
+  const size_t varCount = ideal.getVarCount();
+  if (_shards->getStep() != SliceShards::MergeStep) {
+    SliceShards::ResultWriter root
+      (_shards->getRootResultFileName(), SliceShards::PolynomialKind,
+       varCount, SliceFile::hashIdeal(ideal));
+    auto_ptr<Slice> slice
+      (new HilbertSlice(*this, sliceIdeal, Ideal(varCount),
+                        Term(varCount), &root));
+    simplify(*slice);
+    _tasks.addTask(slice.release());
+    splitIntoShards(SliceShards::PolynomialKind, ideal);
+    root.close();
+
+    if (_shards->getStep() == SliceShards::SplitStep)
+      return;
+    _shards->runLocalWorkers();
+  }
+
+  _shards->mergeResults(ideal, *_consumer);
+  if (_shards->getStep() == SliceShards::AllSteps)
+    _shards->removeFiles();
+}
+
 bool HilbertStrategy::processSlice
 (TaskEngine& tasks, auto_ptr<Slice> slice) {
   ASSERT(slice.get() != 0);
   ASSERT(debugIsValidSlice(slice.get()));
+  TraceNode node(TreeTrace::SliceAlgorithm, tasks.getCurrentDepth(),
+                 slice->getIdeal().getGeneratorCount(), slice->getVarCount());
 
   if (slice->baseCase(getUseSimplification())) {
+    traceNodeKind(TreeTrace::BaseCase);
     freeSlice(slice);
     return true;
   }
 
   if (getUseIndependence() && _indepSplitter.analyze(*slice)) {
+    traceNodeKind(TreeTrace::IndependenceSplit);
     independenceSplit(slice);
   } else {
     ASSERT(_split->isPivotSplit());
@@ -83,6 +126,13 @@ bool HilbertStrategy::processSlice
   return false;
 }
 
+auto_ptr<Slice> HilbertStrategy::makeSlice(const Ideal& ideal,
+                                           const Ideal& subtract,
+                                           const Term& multiply) {
+  return auto_ptr<Slice>
+    (new HilbertSlice(*this, ideal, subtract, multiply, _consumer));
+}
+
 auto_ptr<HilbertSlice> HilbertStrategy::newHilbertSlice() {
   auto_ptr<Slice> slice(newSlice());
   ASSERT(debugIsValidSlice(slice.get()));
@@ -116,6 +166,15 @@ void HilbertStrategy::freeConsumer(auto_ptr<HilbertIndependenceConsumer>
   noThrowPushBack(_consumerCache, consumer);
 }
 
+const mpz_class& HilbertStrategy::computeBasecaseCoefficient
+(const Ideal& ideal) {
+  ASSERT(ideal.isMinimallyGenerated());
+  // The Euler algorithm would otherwise record its nodes inside the
+  // node of the slice.
+  TraceSuspension suspension;
+  return _basecase.computeEulerCharacteristic(ideal);
+}
+
 void HilbertStrategy::independenceSplit(auto_ptr<Slice> sliceParam) {
   ASSERT(sliceParam.get() != 0);
   ASSERT(debugIsValidSlice(sliceParam.get()));
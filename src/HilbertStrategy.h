@@ -22,6 +22,7 @@
 #include "SliceStrategyCommon.h"
 #include "ElementDeleter.h"
 #include "HilbertIndependenceConsumer.h"
+#include "PivotEulerAlg.h"
 
 class HilbertSlice;
 class Ideal;
@@ -34,6 +35,7 @@ class HilbertStrategy : public SliceStrategyCommon {
  public:
   HilbertStrategy(CoefTermConsumer* consumer,
                   const SplitStrategy* splitStrategy);
+  virtual ~HilbertStrategy();
 
   virtual void run(const Ideal& ideal);
 
@@ -41,10 +43,25 @@ class HilbertStrategy : public SliceStrategyCommon {
 
   void freeConsumer(auto_ptr<HilbertIndependenceConsumer> consumer);
 
+  /** Returns the coefficient of the product of all the variables in
+   the numerator of the Hilbert-Poincare series of ideal. ideal must
+   be minimal and square free, and each variable must divide some
+   generator. This is the base case of HilbertSlice. The coefficient
+   is the Euler characteristic that PivotEulerAlg computes, and the
+   same PivotEulerAlg is used for every base case so that its memory
+   is reused. */
+  const mpz_class& computeBasecaseCoefficient(const Ideal& ideal);
+
  private:
   auto_ptr<HilbertIndependenceConsumer> newConsumer();
 
+  /** Carries out the steps of the run given by _shards. */
+  void runWithShards(const Ideal& ideal, const Ideal& sliceIdeal);
+
   auto_ptr<HilbertSlice> newHilbertSlice();
+  virtual auto_ptr<Slice> makeSlice(const Ideal& ideal,
+                                    const Ideal& subtract,
+                                    const Term& multiply);
   virtual auto_ptr<Slice> allocateSlice();
   virtual bool debugIsValidSlice(Slice* slice);
 
@@ -56,6 +73,8 @@ class HilbertStrategy : public SliceStrategyCommon {
   vector<HilbertIndependenceConsumer*> _consumerCache;
   ElementDeleter<vector<HilbertIndependenceConsumer*> > _consumerCacheDeleter;
 
+  PivotEulerAlg _basecase;
+
   CoefTermConsumer* _consumer;
   bool _useIndependence;
 };
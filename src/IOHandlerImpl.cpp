@@ -120,25 +120,103 @@ void IO::readTermProduct(Scanner& in,
   } while (in.match('*'));
 }
 
+namespace {
+  /** Terms are rendered into this buffer and then written with a
+   single call to fwrite. This is a lot faster than writing each
+   variable and exponent with a separate call. The memory of the
+   buffer is kept from term to term. Output is not written from
+   several threads at once, so one buffer is enough. */
+  string& getClearedTermBuffer() {
+    static string buffer;
+    buffer.clear();
+    return buffer;
+  }
+
+  void writeBuffer(const string& buffer, FILE* out) {
+    fwrite(buffer.data(), 1, buffer.size(), out);
+  }
+
+  void appendTermProduct(string& buffer,
+                         const Term& term,
+                         const TermTranslator& translator) {
+    bool seenNonZero = false;
+    size_t varCount = term.getVarCount();
+    for (size_t var = 0; var < varCount; ++var) {
+      const char* exp = translator.getVarExponentString(var, term[var]);
+      if (exp == 0)
+        continue;
+
+      if (seenNonZero)
+        buffer += '*';
+      else
+        seenNonZero = true;
+
+      buffer += exp;
+    }
+
+    if (!seenNonZero)
+      buffer += '1';
+  }
+
+  void appendTermProduct(string& buffer,
+                         const vector<mpz_class>& term,
+                         const VarNames& names) {
+    bool seenNonZero = false;
+    size_t varCount = term.size();
+    for (size_t var = 0; var < varCount; ++var) {
+      if (term[var] == 0)
+        continue;
+
+      if (seenNonZero)
+        buffer += '*';
+      else
+        seenNonZero = true;
+
+      buffer += names.getName(var);
+      if ((term[var]) != 1) {
+        buffer += '^';
+        FrobbyStringStream::appendIntegerToString(buffer, term[var]);
+      }
+    }
+
+    if (!seenNonZero)
+      buffer += '1';
+  }
+
+  /** Appends what comes before the term in a coefficient-term
+   product. Returns false if the term is the identity, in which case
+   the coefficient is all there is to write. */
+  bool appendCoefficient(string& buffer,
+                         const mpz_class& coef,
+                         bool isIdentity,
+                         bool hidePlus) {
+    if (coef >= 0 && !hidePlus)
+      buffer += '+';
+
+    if (isIdentity) {
+      FrobbyStringStream::appendIntegerToString(buffer, coef);
+      return false;
+    }
+
+    if (coef == -1)
+      buffer += '-';
+    else if (coef != 1) {
+      FrobbyStringStream::appendIntegerToString(buffer, coef);
+      buffer += '*';
+    }
+    return true;
+  }
+}
+
 void IO::writeCoefTermProduct(const mpz_class& coef,
                               const Term& term,
                               const TermTranslator& translator,
                               bool hidePlus,
                               FILE* out) {
-  if (coef >= 0 && !hidePlus)
-    fputc('+', out);
-
-  if (term.isIdentity()) {
-    gmp_fprintf(out, "%Zd", coef.get_mpz_t());
-    return;
-  }
-
-  if (coef == -1)
-    fputc('-', out);
-  else if (coef != 1)
-    gmp_fprintf(out, "%Zd*", coef.get_mpz_t());
-
-  writeTermProduct(term, translator, out);
+  string& buffer = getClearedTermBuffer();
+  if (appendCoefficient(buffer, coef, term.isIdentity(), hidePlus))
+    appendTermProduct(buffer, term, translator);
+  writeBuffer(buffer, out);
 }
 
 void IO::writeCoefTermProduct(const mpz_class& coef,
@@ -146,72 +224,31 @@ void IO::writeCoefTermProduct(const mpz_class& coef,
                               const VarNames& names,
                               bool hidePlus,
                               FILE* out) {
-  if (coef >= 0 && !hidePlus)
-    fputc('+', out);
-
   bool isIdentity = true;
   for (size_t var = 0; var < term.size(); ++var)
     if (term[var] != 0)
       isIdentity = false;
 
-  if (isIdentity) {
-    gmp_fprintf(out, "%Zd", coef.get_mpz_t());
-    return;
-  }
-
-  if (coef == -1)
-    fputc('-', out);
-  else if (coef != 1)
-    gmp_fprintf(out, "%Zd*", coef.get_mpz_t());
-
-  writeTermProduct(term, names, out);
+  string& buffer = getClearedTermBuffer();
+  if (appendCoefficient(buffer, coef, isIdentity, hidePlus))
+    appendTermProduct(buffer, term, names);
+  writeBuffer(buffer, out);
 }
 
 void IO::writeTermProduct(const Term& term,
                           const TermTranslator& translator,
                           FILE* out) {
-  bool seenNonZero = false;
-  size_t varCount = term.getVarCount();
-  for (size_t var = 0; var < varCount; ++var) {
-    const char* exp = translator.getVarExponentString(var, term[var]);
-    if (exp == 0)
-      continue;
-
-    if (seenNonZero)
-      putc('*', out);
-    else
-      seenNonZero = true;
-
-    fputs(exp, out);
-  }
-
-  if (!seenNonZero)
-    fputc('1', out);
+  string& buffer = getClearedTermBuffer();
+  appendTermProduct(buffer, term, translator);
+  writeBuffer(buffer, out);
 }
 
 void IO::writeTermProduct(const vector<mpz_class>& term,
                           const VarNames& names,
                           FILE* out) {
-  bool seenNonZero = false;
-  size_t varCount = term.size();
-  for (size_t var = 0; var < varCount; ++var) {
-    if (term[var] == 0)
-      continue;
-
-    if (seenNonZero)
-      fputc('*', out);
-    else
-      seenNonZero = true;
-
-    fputs(names.getName(var).c_str(), out);
-    if ((term[var]) != 1) {
-      fputc('^', out);
-      mpz_out_str(out, 10, term[var].get_mpz_t());
-    }
-  }
-
-  if (!seenNonZero)
-    fputc('1', out);
+  string& buffer = getClearedTermBuffer();
+  appendTermProduct(buffer, term, names);
+  writeBuffer(buffer, out);
 }
 
 void IO::readTermProduct(BigIdeal& ideal, Scanner& in) {
@@ -20,6 +20,7 @@
 #include "TermPredicate.h"
 #include "Term.h"
 #include "Minimizer.h"
+#include "Parallel.h"
 
 #include <algorithm>
 #include <functional>
@@ -573,6 +574,30 @@ bool Ideal::colonReminimize(size_t var, Exponent e) {
   return pair.second;
 }
 
+bool Ideal::setToColonReminimize(const Ideal& ideal, const Exponent* colon) {
+  ASSERT(&ideal != this);
+  ASSERT(ideal.isMinimallyGenerated());
+
+  clearAndSetVarCount(ideal.getVarCount());
+  _terms.reserve(ideal.getGeneratorCount());
+  try {
+    for (size_t i = 0; i < ideal.getGeneratorCount(); ++i)
+      _terms.push_back(_allocator.allocate());
+  } catch (...) {
+    clear(); // do not leave terms with undefined exponents behind
+    throw;
+  }
+
+  Minimizer minimizer(_varCount);
+  pair<iterator, bool> pair = minimizer.colonReminimize
+    (ideal._terms.begin(), _terms.begin(), _terms.end(), colon);
+
+  _terms.erase(pair.first, _terms.end());
+
+  ASSERT(isMinimallyGenerated());
+  return pair.second;
+}
+
 void Ideal::remove(const_iterator it) {
   ASSERT(begin() <= it);
   ASSERT(it < end());
@@ -700,10 +725,12 @@ void Ideal::swap(Ideal& ideal) {
 const int ExponentsPerChunk = 1024;
 const int MinTermsPerChunk = 2;
 
+/** Caches chunks for ExponentAllocator. The cache is not thread safe,
+ so it is bypassed inside parallel regions. */
 class ChunkPool {
 public:
   Exponent* allocate() {
-    if (_chunks.empty())
+    if (_chunks.empty() || isInParallelRegion())
       return new Exponent[ExponentsPerChunk];
 
     Exponent* chunk = _chunks.back();
@@ -712,6 +739,11 @@ public:
   }
 
   void deallocate(Exponent* chunk) {
+    if (isInParallelRegion()) {
+      delete[] chunk;
+      return;
+    }
+
     // deallocate can be called from a destructor, so no exceptions
     // can be allowed to escape from it.
     try {
@@ -736,39 +768,27 @@ private:
 } globalChunkPool;
 
 Ideal::ExponentAllocator::ExponentAllocator(size_t varCount):
-  _varCount(varCount),
+  _varCount(varCount == 0 ? 1 : varCount),
   _chunkIterator(0),
   _chunkEnd(0) {
-  if (_varCount == 0)
-    _varCount = 1;
+  _chunkSize = getChunkSize(_varCount);
 }
 
 Ideal::ExponentAllocator::~ExponentAllocator() {
-  reset(0);
+  freeChunks();
 }
 
 Exponent* Ideal::ExponentAllocator::allocate() {
   if (_chunkIterator + _varCount > _chunkEnd) {
-    if (useSingleChunking()) {
-      Exponent* term = new Exponent[_varCount];
-      try {
-        _chunks.push_back(term);
-      } catch (...) {
-        delete[] term;
-        throw;
-      }
-      return term;
-    }
-
-    _chunkIterator = globalChunkPool.allocate();
-    _chunkEnd = _chunkIterator + ExponentsPerChunk;
-
+    Exponent* chunk = newChunk();
     try {
-      _chunks.push_back(_chunkIterator);
+      _chunks.push_back(chunk);
     } catch (...) {
-      globalChunkPool.deallocate(_chunkIterator);
+      deleteChunk(chunk);
       throw;
     }
+    _chunkIterator = chunk;
+    _chunkEnd = _chunkIterator + _chunkSize;
   }
 
   Exponent* term = _chunkIterator;
@@ -779,32 +799,52 @@ Exponent* Ideal::ExponentAllocator::allocate() {
 }
 
 void Ideal::ExponentAllocator::reset(size_t newVarCount) {
-  _varCount = newVarCount;
-
-  if (useSingleChunking()) {
-    for (size_t i = 0; i < _chunks.size(); ++i)
-      delete[] _chunks[i];
-    _chunks.clear();
-  } else {
-    _chunkIterator = 0;
-    _chunkEnd = 0;
-
-    for (size_t i = 0; i < _chunks.size(); ++i)
-      globalChunkPool.deallocate(_chunks[i]);
-    _chunks.clear();
-  }
+  // The chunks are freed with the size they were allocated with
+  // before the size changes. Chunks of the usual size go back to
+  // globalChunkPool, which hands them out again without allocating,
+  // so an ideal that is cleared does not hold on to its memory.
+  freeChunks();
+  _varCount = newVarCount == 0 ? 1 : newVarCount;
+  _chunkSize = getChunkSize(_varCount);
 }
 
 void Ideal::ExponentAllocator::swap(ExponentAllocator& allocator) {
   std::swap(_varCount, allocator._varCount);
   std::swap(_chunkIterator, allocator._chunkIterator);
   std::swap(_chunkEnd, allocator._chunkEnd);
+  std::swap(_chunkSize, allocator._chunkSize);
 
   _chunks.swap(allocator._chunks);
 }
 
-bool Ideal::ExponentAllocator::useSingleChunking() const {
-  return _varCount > ExponentsPerChunk / MinTermsPerChunk;
+size_t Ideal::ExponentAllocator::getChunkSize(size_t varCount) {
+  // If too few terms fit in a chunk, each term gets a chunk of its own.
+  if (varCount > ExponentsPerChunk / MinTermsPerChunk)
+    return varCount;
+  else
+    return ExponentsPerChunk;
+}
+
+Exponent* Ideal::ExponentAllocator::newChunk() const {
+  if (_chunkSize == static_cast<size_t>(ExponentsPerChunk))
+    return globalChunkPool.allocate();
+  else
+    return new Exponent[_chunkSize];
+}
+
+void Ideal::ExponentAllocator::deleteChunk(Exponent* chunk) const {
+  if (_chunkSize == static_cast<size_t>(ExponentsPerChunk))
+    globalChunkPool.deallocate(chunk);
+  else
+    delete[] chunk;
+}
+
+void Ideal::ExponentAllocator::freeChunks() {
+  for (size_t i = 0; i < _chunks.size(); ++i)
+    deleteChunk(_chunks[i]);
+  _chunks.clear();
+  _chunkIterator = 0;
+  _chunkEnd = 0;
 }
 
 void Ideal::clearStaticCache() {
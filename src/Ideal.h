@@ -234,6 +234,14 @@ class Ideal {
   bool colonReminimize(const Exponent* colon);
   bool colonReminimize(size_t var, Exponent e);
 
+  // Sets this ideal to ideal : colon and then minimizes. This is
+  // equivalent to assigning ideal to this ideal and then calling
+  // colonReminimize(colon), except that the colon is done while
+  // copying the generators instead of in a second pass. ideal must not
+  // be this ideal. Returns true if the support of any generator was
+  // changed.
+  bool setToColonReminimize(const Ideal& ideal, const Exponent* colon);
+
   // Swaps it and the last element, and then removes the last element,
   // which is the element originally pointed to by it.
   void remove(const_iterator it);
@@ -293,6 +301,9 @@ class Ideal {
     ~ExponentAllocator();
 
     Exponent* allocate();
+
+    /** Frees all allocated exponent vectors and prepares to allocate
+     exponent vectors of newVarCount entries. */
     void reset(size_t newVarCount);
 
     void swap(ExponentAllocator& allocator);
@@ -301,15 +312,23 @@ class Ideal {
     ExponentAllocator(const ExponentAllocator&);
     ExponentAllocator& operator=(const ExponentAllocator&);
 
-    bool useSingleChunking() const;
+    /** Returns the number of exponents in each chunk for the given
+     number of variables. */
+    static size_t getChunkSize(size_t varCount);
+
+    Exponent* newChunk() const;
+    void deleteChunk(Exponent* chunk) const;
+    void freeChunks();
 
     size_t _varCount;
 
-    Exponent* _chunk;
     Exponent* _chunkIterator;
     Exponent* _chunkEnd;
 
     vector<Exponent*> _chunks;
+
+    /** The number of exponents in each chunk in _chunks. */
+    size_t _chunkSize;
   };
 
   size_t _varCount;
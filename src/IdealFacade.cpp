@@ -26,7 +26,7 @@
 #include "CanonicalCoefTermConsumer.h"
 #include "error.h"
 #include "FrobbyStringStream.h"
-#include "SizeMaxIndepSetAlg.h"
+#include "SquareFreeMaxIndepSetAlg.h"
 #include "HilbertBasecase.h"
 #include "PivotEulerAlg.h"
 
@@ -102,10 +102,8 @@ mpz_class IdealFacade::computeDimension(const BigIdeal& bigIdeal,
   }
   ASSERT(!squareFreeAndMinimal || radical.isMinimallyGenerated());
 
-  if (!squareFreeAndMinimal)
-    radical.minimize();
-
-  SizeMaxIndepSetAlg alg;
+  // The algorithm minimizes its own copy of the radical.
+  SquareFreeMaxIndepSetAlg alg;
   alg.run(radical);
   mpz_class result = alg.getMaxIndepSetSize();
 
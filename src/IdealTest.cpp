@@ -40,3 +40,74 @@ TEST(Ideal, IsWeaklyGeneric2) {
 
   ASSERT_FALSE(id.isWeaklyGeneric());
 }
+
+TEST(Ideal, ClearAndRefill) {
+  Ideal id(3);
+  id.insert(Term("1 2 3"));
+  id.insert(Term("3 2 1"));
+  Ideal copy(id);
+
+  // Refill after clear.
+  for (size_t i = 0; i < 3; ++i) {
+    id.clear();
+    ASSERT_TRUE(id.isZeroIdeal());
+    id.insert(copy);
+    ASSERT_EQ(id, copy);
+  }
+  id = copy;
+  ASSERT_EQ(id, copy);
+}
+
+TEST(Ideal, ClearAndSetVarCount) {
+  // Go back and forth between small and large numbers of variables,
+  // where large means that each generator gets its own chunk of
+  // memory.
+  const size_t largeVarCount = 2000;
+  Ideal large(largeVarCount);
+  Term term(largeVarCount);
+  for (size_t var = 0; var < largeVarCount; ++var) {
+    term[var] = 1;
+    large.insert(term);
+    term[var] = 0;
+  }
+
+  Ideal small(2);
+  small.insert(Term("1 2"));
+  small.insert(Term("2 1"));
+
+  Ideal id;
+  for (size_t i = 0; i < 2; ++i) {
+    id = large;
+    ASSERT_EQ(id, large);
+    id = small;
+    ASSERT_EQ(id, small);
+  }
+}
+
+TEST(Ideal, SetToColonReminimize) {
+  Ideal id(3);
+  id.insert(Term("4 0 0"));
+  id.insert(Term("3 1 0"));
+  id.insert(Term("2 0 3"));
+  id.insert(Term("1 2 2"));
+  id.insert(Term("0 4 1"));
+  id.insert(Term("0 0 5"));
+  id.insert(Term("2 2 1"));
+
+  // Includes pure powers, which take a different path, and colons that
+  // do not change any support.
+  const char* colons[] = {"1 0 0", "2 0 0", "0 0 4", "1 1 0", "2 1 1",
+                          "0 0 0", "3 5 1", "9 9 9"};
+  for (size_t i = 0; i < sizeof(colons) / sizeof(colons[0]); ++i) {
+    Term colon(colons[i]);
+    Ideal inPlace(id);
+    bool inPlaceChanged = inPlace.colonReminimize(colon);
+
+    Ideal copied;
+    bool copiedChanged = copied.setToColonReminimize(id, colon);
+
+    // Also the order of the generators should be the same.
+    ASSERT_EQ(copied, inPlace);
+    ASSERT_EQ(copiedChanged, inPlaceChanged);
+  }
+}
@@ -37,6 +37,8 @@ IrreducibleDecomAction::IrreducibleDecomAction():
           "Encode the decomposition as monomials generating an ideal.",
           false),
 
+  _sliceParams(false, true, false, true, true, true),
+
   _io(DataType::getMonomialIdealType(), DataType::getMonomialIdealType()) {
 }
 
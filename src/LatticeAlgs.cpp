@@ -17,14 +17,29 @@
 #include "stdinc.h"
 #include "LatticeAlgs.h"
 
+#include "Parallel.h"
 #include <stack>
 
-void getThinPlanes(vector<TriPlane>& planes, const GrobLat& lat) {
-  planes.clear();
-  for (size_t a = 0; a <= lat.getNeighborCount(); ++a) {
-	Neighbor an(lat);
-	if (a < lat.getNeighborCount())
-	  an = lat.getNeighbor(a);
+void reportFailedCheck(const char* condition, int line, const char* file) {
+  // Only one thread gets to report and exit. Other threads that fail a
+  // check wait at the critical section until the process is gone.
+#ifdef _OPENMP
+#pragma omp critical (reportFailedCheck)
+#endif
+  {
+	cout << "Check condition on line "
+		 << line << " of file " << file
+		 << " not satisfied:\n  " << condition << endl;
+	exit(1);
+  }
+}
+
+namespace {
+  /** Appends to planes the thin planes through an, b and c for all
+   neighbors b and c. Skips planes that are parallel to a plane
+   already in planes. */
+  void getThinPlanes(vector<TriPlane>& planes, Neighbor an,
+					 const GrobLat& lat) {
 	for (size_t b = 0; b < lat.getNeighborCount(); ++b) {
 	  for (size_t c = 0; c < lat.getNeighborCount(); ++c) {
 		TriPlane plane(an, lat.getNeighbor(b), lat.getNeighbor(c));
@@ -55,6 +70,48 @@ void getThinPlanes(vector<TriPlane>& planes, const GrobLat& lat) {
   }
 }
 
+void getThinPlanes(vector<TriPlane>& planes, const GrobLat& lat) {
+  // The planes for each choice of the first point are computed in
+  // parallel. Merging them in order of that point keeps the first
+  // plane of each set of parallel planes, just as a serial computation
+  // would.
+  const long pointCount = static_cast<long>(lat.getNeighborCount() + 1);
+  vector<vector<TriPlane> > planesByPoint(pointCount);
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long a = 0; a < pointCount; ++a) {
+	if (catcher.hasCaught())
+	  continue;
+	try {
+	  Neighbor an(lat);
+	  if (static_cast<size_t>(a) < lat.getNeighborCount())
+		an = lat.getNeighbor(a);
+	  getThinPlanes(planesByPoint[a], an, lat);
+	} catch (...) {
+	  catcher.catchCurrent();
+	}
+  }
+  catcher.rethrowIfCaught();
+
+  planes.clear();
+  for (size_t a = 0; a < planesByPoint.size(); ++a) {
+	for (size_t i = 0; i < planesByPoint[a].size(); ++i) {
+	  const TriPlane& plane = planesByPoint[a][i];
+	  bool parallel = false;
+	  for (size_t p = 0; p < planes.size(); ++p) {
+		if (plane.isParallel(planes[p])) {
+		  parallel = true;
+		  break;
+		}
+	  }
+	  if (!parallel)
+		planes.push_back(plane);
+	}
+  }
+}
+
 /*
 void checkParallelFaces(const vector<Mlfb>& mlfbs,
 						const vector<Plane> planes) {
@@ -236,49 +293,16 @@ void Mlfb::reset(size_t offset, const vector<Neighbor>& points) {
 	_isParallelogram = false;
 }
 
-void computeMlfbs(vector<Mlfb>& mlfbs, const GrobLat& lat) {
-  BigIdeal initialIdeal;
-  lat.getInitialIdeal(initialIdeal);
-
-  BigTermRecorder recorder;
-  SliceParams params;
-  SliceFacade facade(params, initialIdeal, recorder);
-  facade.computeIrreducibleDecomposition(true);
-  auto_ptr<BigIdeal> rhsesOwner = recorder.releaseIdeal();
-  BigIdeal& rhses = *rhsesOwner;
-  ASSERT(recorder.empty());
-
-  mlfbs.clear();
-  mlfbs.resize(rhses.getGeneratorCount());
-
-  vector<Neighbor> points;
-  for (size_t i = 0; i < mlfbs.size(); ++i) {
-	Mlfb& mlfb = mlfbs[i];
-	points.clear();
-
-	points.push_back(Neighbor(lat));
-	for (size_t gen = 0; gen < initialIdeal.getGeneratorCount(); ++gen) {
-	  for (size_t var = 0; var < initialIdeal.getVarCount(); ++var)
-		if (initialIdeal[gen][var] > rhses[i][var])
-		  goto skipIt;
-	  points.push_back(Neighbor(lat, gen));
-	skipIt:;
-	}
-
-	mlfb.reset(i, points);
-	CHECK(rhses[i] == mlfb.getRhs());
-  }
-
-  Matrix nullSpaceBasis;
-  nullSpace(nullSpaceBasis, lat.getMatrix());
-  transpose(nullSpaceBasis, nullSpaceBasis);
-  // the basis is the rows of NullSpaceBasis at this point.
-
-  for (size_t m = 0; m < mlfbs.size(); ++m) {
-	Mlfb& mlfb = mlfbs[m];
-
+namespace {
+  /** Sets minInitialFacet, dotDegree and the Scarf edges of
+   mlfb. The right hand sides of all of mlfbs must have been computed
+   already. */
+  void computeMlfbEdges(Mlfb& mlfb,
+						vector<Mlfb>& mlfbs,
+						const GrobLat& lat,
+						const Matrix& nullSpaceBasis) {
 	if (mlfb.getPointCount() != lat.getYDim())
-	  continue;
+	  return;
 
 	// Compute minInitialFacet.
 	mlfb.minInitialFacet = 0;
@@ -405,11 +429,90 @@ void computeMlfbs(vector<Mlfb>& mlfbs, const GrobLat& lat) {
 	  goto skipBecauseNotGeneric;
 	foundMatch:;
 	}
-	continue;
+	return;
   skipBecauseNotGeneric:
 	mlfb.edges.clear();
 	mlfb.edgeHitsFacet.clear();
   }
+
+  /** Sets mlfb to the MLFB with right hand side rhs. */
+  void computeMlfb(Mlfb& mlfb,
+				   size_t offset,
+				   const vector<mpz_class>& rhs,
+				   const BigIdeal& initialIdeal,
+				   const GrobLat& lat) {
+	vector<Neighbor> points;
+	points.push_back(Neighbor(lat));
+	for (size_t gen = 0; gen < initialIdeal.getGeneratorCount(); ++gen) {
+	  for (size_t var = 0; var < initialIdeal.getVarCount(); ++var)
+		if (initialIdeal[gen][var] > rhs[var])
+		  goto skipIt;
+	  points.push_back(Neighbor(lat, gen));
+	skipIt:;
+	}
+
+	mlfb.reset(offset, points);
+	CHECK(rhs == mlfb.getRhs());
+  }
+}
+
+void computeMlfbs(vector<Mlfb>& mlfbs, const GrobLat& lat) {
+  BigIdeal initialIdeal;
+  lat.getInitialIdeal(initialIdeal);
+
+  BigTermRecorder recorder;
+  SliceParams params;
+  SliceFacade facade(params, initialIdeal, recorder);
+  facade.computeIrreducibleDecomposition(true);
+  auto_ptr<BigIdeal> rhsesOwner = recorder.releaseIdeal();
+  BigIdeal& rhses = *rhsesOwner;
+  ASSERT(recorder.empty());
+
+  mlfbs.clear();
+  mlfbs.resize(rhses.getGeneratorCount());
+
+  // Each MLFB is computed independently, so they can be computed in
+  // parallel. The edges refer to other MLFBs, so the MLFBs must all be
+  // there before the edges are computed.
+  const long mlfbCount = static_cast<long>(mlfbs.size());
+  {
+	ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (long m = 0; m < mlfbCount; ++m) {
+	  if (catcher.hasCaught())
+		continue;
+	  try {
+		computeMlfb(mlfbs[m], m, rhses[m], initialIdeal, lat);
+	  } catch (...) {
+		catcher.catchCurrent();
+	  }
+	}
+	catcher.rethrowIfCaught();
+  }
+
+  Matrix nullSpaceBasis;
+  nullSpace(nullSpaceBasis, lat.getMatrix());
+  transpose(nullSpaceBasis, nullSpaceBasis);
+  // the basis is the rows of NullSpaceBasis at this point.
+
+  {
+	ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (long m = 0; m < mlfbCount; ++m) {
+	  if (catcher.hasCaught())
+		continue;
+	  try {
+		computeMlfbEdges(mlfbs[m], mlfbs, lat, nullSpaceBasis);
+	  } catch (...) {
+		catcher.catchCurrent();
+	  }
+	}
+	catcher.rethrowIfCaught();
+  }
 }
 
 SeqPos nextInSeq(SeqPos pos) {
@@ -508,11 +611,14 @@ void computeFlatSeq(vector<SeqPos>& seq,
   }
 }
 
-void computePlanes(vector<Plane>& planes,
-				   const GrobLat& lat,
-				   vector<Mlfb>& mlfbs) {
-  const size_t neighborCount = lat.getNeighborCount();
-  for (size_t gen1 = 0; gen1 < neighborCount; ++gen1) {
+namespace {
+  /** Appends to planes the planes of the non-flat double triangles
+   whose first point is neighbor gen1. */
+  void computePlanes(vector<Plane>& planes,
+					 size_t gen1,
+					 const GrobLat& lat,
+					 vector<Mlfb>& mlfbs) {
+	const size_t neighborCount = lat.getNeighborCount();
 	for (size_t gen2 = gen1 + 1; gen2 < neighborCount; ++gen2) {
 	  Neighbor a = lat.getNeighbor(gen1);
 	  Neighbor b = lat.getNeighbor(gen2);
@@ -552,16 +658,57 @@ void computePlanes(vector<Plane>& planes,
 	  transpose(plane.nullSpaceBasis);
 	}
   }
+}
 
-  for (size_t p = 0; p < planes.size(); ++p) {
-	Plane& plane = planes[p];
-	for (size_t i = 0; i < mlfbs.size(); ++i)
-	  plane.typeCounts[plane.getType(mlfbs[i])] += 1;
-
-	computeFlatSeq(plane.flatSeq, mlfbs, plane);
-	computePivots(plane.pivots, mlfbs, plane, plane.flatSeq);
-	plane.flatIntervalCount = computeFlatIntervalCount(plane.flatSeq);
+void computePlanes(vector<Plane>& planes,
+				   const GrobLat& lat,
+				   vector<Mlfb>& mlfbs) {
+  // The planes are found in parallel and then merged in order of the
+  // first point so that the order is the same as for a serial
+  // computation.
+  const long neighborCount = static_cast<long>(lat.getNeighborCount());
+  vector<vector<Plane> > planesByGen(neighborCount);
+  {
+	ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for (long gen1 = 0; gen1 < neighborCount; ++gen1) {
+	  if (catcher.hasCaught())
+		continue;
+	  try {
+		computePlanes(planesByGen[gen1], gen1, lat, mlfbs);
+	  } catch (...) {
+		catcher.catchCurrent();
+	  }
+	}
+	catcher.rethrowIfCaught();
   }
+  for (size_t gen1 = 0; gen1 < planesByGen.size(); ++gen1)
+	planes.insert(planes.end(),
+				  planesByGen[gen1].begin(), planesByGen[gen1].end());
+
+  const long planeCount = static_cast<long>(planes.size());
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long p = 0; p < planeCount; ++p) {
+	if (catcher.hasCaught())
+	  continue;
+	try {
+	  Plane& plane = planes[p];
+	  for (size_t i = 0; i < mlfbs.size(); ++i)
+		plane.typeCounts[plane.getType(mlfbs[i])] += 1;
+
+	  computeFlatSeq(plane.flatSeq, mlfbs, plane);
+	  computePivots(plane.pivots, mlfbs, plane, plane.flatSeq);
+	  plane.flatIntervalCount = computeFlatIntervalCount(plane.flatSeq);
+	} catch (...) {
+	  catcher.catchCurrent();
+	}
+  }
+  catcher.rethrowIfCaught();
 }
 
 Tri::Tri(Neighbor a, Neighbor b, Neighbor sum,
@@ -651,11 +798,23 @@ void checkDoubleTrianglePlanes(const vector<Plane>& planes,
 							   const vector<Mlfb>& mlfbs) {
   // Check no two planes are parallel. Otherwise there would a plane
   // with two non-flat double triangles in it.
-  for (size_t p1 = 0; p1 < planes.size(); ++p1) {
-	for (size_t p2 = 0; p2 < p1; ++p2) {
-	  CHECK(!hasSameRowSpace(planes[p1].rowAB, planes[p2].rowAB));
+  const long planeCount = static_cast<long>(planes.size());
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long p1 = 0; p1 < planeCount; ++p1) {
+	if (catcher.hasCaught())
+	  continue;
+	try {
+	  for (long p2 = 0; p2 < p1; ++p2) {
+		CHECK(!hasSameRowSpace(planes[p1].rowAB, planes[p2].rowAB));
+	  }
+	} catch (...) {
+	  catcher.catchCurrent();
 	}
   }
+  catcher.rethrowIfCaught();
 
   // Check that all parallelograms lie in a plane. Otherwise there
   // would be a plane defined by a flat that does not have a double
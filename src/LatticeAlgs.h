@@ -44,15 +44,16 @@
 
 #include <iostream>
 
+/** Prints that condition on line of file is not satisfied and
+ exits. Only the first thread to call this gets to report, so it is
+ safe to use from several threads at once. */
+void reportFailedCheck(const char* condition, int line, const char* file);
+
 // wrapped in do .. while(false) to make it act like a single statement.
-#define CHECK(X)									\
-  do {												\
-	if (!(X)) {										\
-	  cout << "Check condition on line "			\
-		   << __LINE__ << " of file " << __FILE__	\
-		   << " not satisfied:\n  "#X << endl;		\
-	  exit(1);										\
-	}				                                \
+#define CHECK(X)											\
+  do {														\
+	if (!(X))												\
+	  reportFailedCheck(#X, __LINE__, __FILE__);			\
   } while (false)
 
 enum NeighborPlace {
@@ -0,0 +1,102 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+
+#include "frobby.h"
+#include "tests.h"
+
+TEST_SUITE2(LibraryInterface, Cancellation)
+
+namespace {
+  /** Returns the ideal generated by the monomials of degree 5 in 4
+   variables, which has 35 irreducible components. */
+  Frobby::Ideal makeIdeal() {
+    Frobby::Ideal ideal(4);
+    for (int x = 0; x <= 5; ++x)
+      for (int y = 0; x + y <= 5; ++y)
+        for (int z = 0; x + y + z <= 5; ++z) {
+          ideal.addExponent(x);
+          ideal.addExponent(y);
+          ideal.addExponent(z);
+          ideal.addExponent(5 - x - y - z);
+        }
+    return ideal;
+  }
+
+  /** Counts the terms it is given and calls Frobby::cancel() when it
+   is given term number cancelAt. A cancelAt of zero means never. */
+  class CancellingConsumer : public Frobby::IdealConsumer {
+  public:
+    CancellingConsumer(size_t cancelAt): _cancelAt(cancelAt), _count(0) {}
+
+    virtual void consume(mpz_ptr* exponentVector) {
+      ++_count;
+      if (_count == _cancelAt)
+        Frobby::cancel();
+    }
+
+    size_t getCount() const {return _count;}
+
+  private:
+    size_t _cancelAt;
+    size_t _count;
+  };
+
+  size_t getComponentCount(size_t cancelAt) {
+    CancellingConsumer consumer(cancelAt);
+    Frobby::irreducibleDecompositionAsMonomials(makeIdeal(), consumer);
+    return consumer.getCount();
+  }
+}
+
+TEST(Cancellation, NotCancelled) {
+  ASSERT_EQ(getComponentCount(0), 35u);
+  ASSERT_FALSE(Frobby::wasCancelled());
+  ASSERT_TRUE(Frobby::getStepCount() > 0);
+}
+
+TEST(Cancellation, CancelFromConsumer) {
+  ASSERT_TRUE(getComponentCount(1) < 35u);
+  ASSERT_TRUE(Frobby::wasCancelled());
+  ASSERT_TRUE(Frobby::getStepCount() > 0);
+
+  // The cancellation does not carry over to the next computation.
+  ASSERT_EQ(getComponentCount(0), 35u);
+  ASSERT_FALSE(Frobby::wasCancelled());
+}
+
+TEST(Cancellation, CancelWhileNotRunning) {
+  Frobby::cancel();
+  ASSERT_EQ(getComponentCount(0), 35u);
+  ASSERT_FALSE(Frobby::wasCancelled());
+}
+
+TEST(Cancellation, TimeLimitNotReached) {
+  Frobby::setTimeLimit(1000 * 1000);
+  ASSERT_EQ(getComponentCount(0), 35u);
+  ASSERT_FALSE(Frobby::wasCancelled());
+}
+
+TEST(Cancellation, TimeLimitOnlyForNextComputation) {
+  // A time limit of one millisecond is used up by the first
+  // computation, so the second one runs without a limit.
+  Frobby::setTimeLimit(1);
+  getComponentCount(0);
+  ASSERT_EQ(getComponentCount(0), 35u);
+  ASSERT_FALSE(Frobby::wasCancelled());
+}
@@ -0,0 +1,90 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+
+#include "frobby.h"
+#include "tests.h"
+#include <vector>
+
+TEST_SUITE2(LibraryInterface, Progress)
+
+namespace {
+  /** Returns the ideal generated by the monomials of degree 5 in 4
+   variables. */
+  Frobby::Ideal makeIdeal() {
+    Frobby::Ideal ideal(4);
+    for (int x = 0; x <= 5; ++x)
+      for (int y = 0; x + y <= 5; ++y)
+        for (int z = 0; x + y + z <= 5; ++z) {
+          ideal.addExponent(x);
+          ideal.addExponent(y);
+          ideal.addExponent(z);
+          ideal.addExponent(5 - x - y - z);
+        }
+    return ideal;
+  }
+
+  class RecordingConsumer : public Frobby::ProgressConsumer {
+  public:
+    virtual void consume(const Frobby::ProgressReport& report) {
+      _reports.push_back(report);
+    }
+
+    const vector<Frobby::ProgressReport>& getReports() const {
+      return _reports;
+    }
+
+  private:
+    vector<Frobby::ProgressReport> _reports;
+  };
+
+  class NullIdealConsumer : public Frobby::IdealConsumer {
+  public:
+    virtual void consume(mpz_ptr* exponentVector) {}
+  };
+}
+
+TEST(Progress, Reports) {
+  RecordingConsumer consumer;
+  Frobby::setProgressConsumer(&consumer, 0);
+  NullIdealConsumer output;
+  Frobby::irreducibleDecompositionAsMonomials(makeIdeal(), output);
+  Frobby::setProgressConsumer(0, 0);
+
+  const vector<Frobby::ProgressReport>& reports = consumer.getReports();
+  ASSERT_FALSE(reports.empty());
+  for (size_t i = 0; i < reports.size(); ++i) {
+    ASSERT_TRUE(reports[i].nodeCount > 0);
+    ASSERT_TRUE(reports[i].doneFraction >= 0);
+    ASSERT_TRUE(reports[i].doneFraction <= 1);
+    if (i > 0) {
+      ASSERT_TRUE(reports[i - 1].nodeCount < reports[i].nodeCount);
+      ASSERT_TRUE(reports[i - 1].outputTermCount <=
+                  reports[i].outputTermCount);
+    }
+  }
+}
+
+TEST(Progress, Off) {
+  RecordingConsumer consumer;
+  Frobby::setProgressConsumer(&consumer, 0);
+  Frobby::setProgressConsumer(0, 0);
+  NullIdealConsumer output;
+  Frobby::irreducibleDecompositionAsMonomials(makeIdeal(), output);
+  ASSERT_TRUE(consumer.getReports().empty());
+}
@@ -23,6 +23,8 @@
 
 #include <utility>
 #include <sstream>
+#include <limits>
+#include <cmath>
 
 namespace {
   /** Multiplies column col of mat by a positive fractional number
@@ -52,6 +54,299 @@ namespace {
 	  ASSERT(mat(row, col).get_den() == 1);
 	}
   }
+
+  /** A matrix of integers for fraction-free elimination. Int is long
+   when all values that the elimination can produce are known to fit
+   in a long, and otherwise Int is mpz_class. */
+  template<class Int>
+  class IntegerMatrix {
+  public:
+	IntegerMatrix(size_t rowCount, size_t colCount):
+	  _rowCount(rowCount), _colCount(colCount),
+	  _entries(rowCount * colCount) {}
+
+	size_t getRowCount() const {return _rowCount;}
+	size_t getColCount() const {return _colCount;}
+
+	const Int& operator()(size_t row, size_t col) const
+	{return _entries[toIndex(row, col)];}
+	Int& operator()(size_t row, size_t col)
+	{return _entries[toIndex(row, col)];}
+
+	void swapRows(size_t row1, size_t row2) {
+	  using std::swap;
+	  for (size_t col = 0; col < _colCount; ++col)
+		swap((*this)(row1, col), (*this)(row2, col));
+	}
+
+  private:
+	size_t toIndex(size_t row, size_t col) const {
+	  ASSERT(row < _rowCount);
+	  ASSERT(col < _colCount);
+	  return col + row * _colCount;
+	}
+
+	size_t _rowCount;
+	size_t _colCount;
+	vector<Int> _entries;
+  };
+
+  /** Sets entry to (pivot * entry - factor * pivotRowEntry) /
+   divisor. The division is exact. */
+  inline void eliminate(long& entry, long pivot, long factor,
+						long pivotRowEntry, long divisor) {
+	entry = (pivot * entry - factor * pivotRowEntry) / divisor;
+  }
+
+  inline void eliminate(mpz_class& entry,
+						const mpz_class& pivot,
+						const mpz_class& factor,
+						const mpz_class& pivotRowEntry,
+						const mpz_class& divisor) {
+	mpz_ptr e = entry.get_mpz_t();
+	mpz_mul(e, e, pivot.get_mpz_t());
+	mpz_submul(e, factor.get_mpz_t(), pivotRowEntry.get_mpz_t());
+	ASSERT(mpz_divisible_p(e, divisor.get_mpz_t()));
+	mpz_divexact(e, e, divisor.get_mpz_t());
+  }
+
+  /** Performs Bareiss fraction-free Gaussian elimination on mat. This
+   keeps all entries integral without ever taking a gcd, and every
+   entry of the result is the determinant of a square sub-matrix of the
+   original mat. Only columns in [0, pivotColEnd) are used for pivots.
+
+   If fully is false then mat is reduced to row echelon form and the
+   last pivot is the determinant of the sub-matrix of the original rows
+   and the pivot columns. If fully is true then mat is reduced to
+   reduced row echelon form except that all pivots are the same value
+   instead of one.
+
+   The columns of the pivots are recorded in pivotCols and the value
+   of the last pivot is placed in lastPivot. lastPivot is 1 if there
+   are no pivots. Returns true if the permutation made of the rows is
+   odd. */
+  template<class Int>
+  bool reduceFractionFree(IntegerMatrix<Int>& mat,
+						  size_t pivotColEnd,
+						  bool fully,
+						  vector<size_t>& pivotCols,
+						  Int& lastPivot) {
+	ASSERT(pivotColEnd <= mat.getColCount());
+	const size_t rowCount = mat.getRowCount();
+	const size_t colCount = mat.getColCount();
+
+	bool permutationOdd = false;
+	pivotCols.clear();
+	lastPivot = 1;
+	Int factor;
+	for (size_t pivotCol = 0; pivotCol < pivotColEnd; ++pivotCol) {
+	  const size_t pivotRow = pivotCols.size();
+	  size_t row = pivotRow;
+	  for (; row < rowCount; ++row)
+		if (mat(row, pivotCol) != 0)
+		  break;
+	  if (row == rowCount)
+		continue;
+	  if (row != pivotRow) {
+		permutationOdd = !permutationOdd;
+		mat.swapRows(row, pivotRow);
+	  }
+	  pivotCols.push_back(pivotCol);
+
+	  const Int& pivot = mat(pivotRow, pivotCol);
+	  for (row = fully ? 0 : pivotRow + 1; row < rowCount; ++row) {
+		if (row == pivotRow)
+		  continue;
+
+		// Rows below pivotRow are zero to the left of pivotCol, but
+		// rows above it are not.
+		factor = mat(row, pivotCol);
+		const size_t colBegin = row < pivotRow ? 0 : pivotCol;
+		for (size_t col = colBegin; col < colCount; ++col)
+		  eliminate(mat(row, col), pivot, factor,
+					mat(pivotRow, col), lastPivot);
+		ASSERT(mat(row, pivotCol) == 0);
+	  }
+	  lastPivot = pivot;
+	}
+	return permutationOdd;
+  }
+
+  /** Sets intMat to mat with each row multiplied by the least common
+   multiple of the denominators of that row. If scale is not null, then
+   *scale is set to the product of those multipliers. */
+  void makeIntegral(IntegerMatrix<mpz_class>& intMat,
+					const Matrix& mat,
+					mpz_class* scale = 0) {
+	ASSERT(intMat.getRowCount() == mat.getRowCount());
+	ASSERT(intMat.getColCount() == mat.getColCount());
+
+	if (scale != 0)
+	  *scale = 1;
+	mpz_class denLcm;
+	for (size_t row = 0; row < mat.getRowCount(); ++row) {
+	  denLcm = 1;
+	  for (size_t col = 0; col < mat.getColCount(); ++col)
+		if (mat(row, col).get_den() != 1)
+		  mpz_lcm(denLcm.get_mpz_t(), denLcm.get_mpz_t(),
+				  mat(row, col).get_den_mpz_t());
+	  for (size_t col = 0; col < mat.getColCount(); ++col) {
+		mpz_class& entry = intMat(row, col);
+		entry = mat(row, col).get_num();
+		if (denLcm != 1) {
+		  entry *= denLcm;
+		  mpz_divexact(entry.get_mpz_t(), entry.get_mpz_t(),
+					   mat(row, col).get_den_mpz_t());
+		}
+	  }
+	  if (scale != 0)
+		*scale *= denLcm;
+	}
+  }
+
+  /** Sets small to big and returns true if every value computed by
+   reduceFractionFree on big fits in a long. Otherwise returns false
+   and leaves small in an unspecified state. Every entry produced by
+   the elimination is a minor of big, so by Hadamard's inequality it is
+   bounded by the product B of the lengths of the non-zero rows. The
+   intermediate values are bounded by 2*B^2. */
+  bool copyToLongIfFits(IntegerMatrix<long>& small,
+						const IntegerMatrix<mpz_class>& big) {
+	ASSERT(small.getRowCount() == big.getRowCount());
+	ASSERT(small.getColCount() == big.getColCount());
+
+	double logBound = 0;
+	for (size_t row = 0; row < big.getRowCount(); ++row) {
+	  double lengthSq = 0;
+	  for (size_t col = 0; col < big.getColCount(); ++col) {
+		double entry = big(row, col).get_d();
+		lengthSq += entry * entry;
+	  }
+	  if (lengthSq > 1)
+		logBound += std::log(lengthSq) / (2 * std::log(2.0));
+	}
+	// The bits of margin cover rounding errors in logBound.
+	if (!(2 * logBound + 3 < std::numeric_limits<long>::digits))
+	  return false;
+
+	for (size_t row = 0; row < big.getRowCount(); ++row)
+	  for (size_t col = 0; col < big.getColCount(); ++col)
+		small(row, col) = big(row, col).get_si();
+	return true;
+  }
+
+  /** Sets entry to numerator / denominator. */
+  template<class Int>
+  void setToQuotient(mpq_class& entry, const Int& numerator,
+					 const Int& denominator) {
+	ASSERT(denominator != 0);
+	entry.get_num() = numerator;
+	entry.get_den() = denominator;
+	entry.canonicalize();
+  }
+
+  template<class Int>
+  size_t fractionFreeRank(IntegerMatrix<Int>& mat) {
+	vector<size_t> pivotCols;
+	Int lastPivot;
+	reduceFractionFree(mat, mat.getColCount(), false, pivotCols, lastPivot);
+	return pivotCols.size();
+  }
+
+  template<class Int>
+  void fractionFreeDeterminant(mpq_class& det, IntegerMatrix<Int>& mat) {
+	vector<size_t> pivotCols;
+	Int lastPivot;
+	bool permutationOdd =
+	  reduceFractionFree(mat, mat.getColCount(), false, pivotCols, lastPivot);
+	if (pivotCols.size() < mat.getRowCount())
+	  det = 0;
+	else {
+	  det = mpz_class(lastPivot);
+	  if (permutationOdd)
+		det = -det;
+	}
+  }
+
+  template<class Int>
+  void fractionFreeNullSpace(Matrix& basis, IntegerMatrix<Int>& mat) {
+	vector<size_t> pivotCols;
+	Int pivot;
+	reduceFractionFree(mat, mat.getColCount(), true, pivotCols, pivot);
+
+	// Each row with a pivot is pivot times the corresponding row of
+	// the reduced row echelon form, so each column of basis is pivot
+	// times what it would be using the reduced row echelon form.
+	const size_t colCount = mat.getColCount();
+	const size_t rank = pivotCols.size();
+	const bool negate = pivot < 0;
+	basis.resize(colCount, colCount - rank);
+	size_t nullCol = 0;
+	size_t nextPivot = 0;
+	for (size_t col = 0; col < colCount; ++col) {
+	  if (nextPivot < rank && pivotCols[nextPivot] == col) {
+		++nextPivot;
+		continue;
+	  }
+
+	  ASSERT(nullCol < basis.getColCount());
+	  for (size_t nullRow = 0; nullRow < colCount; ++nullRow)
+		basis(nullRow, nullCol) = 0;
+	  basis(col, nullCol) = mpz_class(pivot);
+	  for (size_t row = 0; row < rank; ++row)
+		basis(pivotCols[row], nullCol) = -mpz_class(mat(row, col));
+	  if (negate)
+		for (size_t nullRow = 0; nullRow < colCount; ++nullRow)
+		  basis(nullRow, nullCol) = -basis(nullRow, nullCol);
+
+	  ++nullCol;
+	}
+	ASSERT(nullCol == basis.getColCount());
+  }
+
+  /** Solves the system whose left hand side is the columns of system
+   in [0, midCol) and whose right hand sides are the remaining
+   columns. Sets rank to the rank of the left hand side. */
+  template<class Int>
+  bool fractionFreeSolve(Matrix& sol, IntegerMatrix<Int>& system,
+						 size_t midCol, size_t& rank) {
+	vector<size_t> pivotCols;
+	Int pivot;
+	reduceFractionFree(system, midCol, true, pivotCols, pivot);
+	rank = pivotCols.size();
+
+	// Rows without a pivot are zero to the left of midCol.
+	for (size_t row = rank; row < system.getRowCount(); ++row)
+	  for (size_t col = midCol; col < system.getColCount(); ++col)
+		if (system(row, col) != 0)
+		  return false;
+
+	sol.resize(midCol, system.getColCount() - midCol);
+	for (size_t col = 0; col < midCol; ++col)
+	  for (size_t r = 0; r < sol.getColCount(); ++r)
+		sol(col, r) = 0;
+	for (size_t row = 0; row < rank; ++row)
+	  for (size_t r = 0; r < sol.getColCount(); ++r)
+		setToQuotient(sol(pivotCols[row], r), system(row, midCol + r), pivot);
+	return true;
+  }
+
+  /** As fractionFreeSolve for the rational matrix system. Does not
+   change sol if there is no solution. */
+  bool solveSystem(Matrix& sol, const Matrix& system,
+				   size_t midCol, size_t& rank) {
+	IntegerMatrix<mpz_class> big(system.getRowCount(), system.getColCount());
+	makeIntegral(big, system);
+
+	Matrix tmp;
+	IntegerMatrix<long> small(system.getRowCount(), system.getColCount());
+	bool hasSolution = copyToLongIfFits(small, big) ?
+	  fractionFreeSolve(tmp, small, midCol, rank) :
+	  fractionFreeSolve(tmp, big, midCol, rank);
+	if (hasSolution)
+	  sol.swap(tmp);
+	return hasSolution;
+  }
 }
 
 Matrix::Matrix(size_t rowCount, size_t colCount):
@@ -258,87 +553,38 @@ bool inverse(Matrix& inv, const Matrix& mat) {
   ASSERT(mat.getRowCount() == mat.getColCount());
   size_t size = mat.getRowCount();
 
-  inv = mat;
-
-  // Append identity matrix
-  inv.resize(size, size + size);
+  // The inverse is the solution to mat * inv = identity.
+  Matrix system(mat);
+  system.resize(size, size + size);
   for (size_t i = 0; i < size; ++i)
-	inv(i, size + i) = 1;
+	system(i, size + i) = 1;
 
-  rowReduceFully(inv);
-  if (inv(size - 1, size - 1) == 0)
+  size_t rank;
+  if (!solveSystem(inv, system, size, rank) || rank < size)
 	return false; // not invertible
-
-  subMatrix(inv, inv, 0, size, size, 2 * size);
   return true;
 }
 
-size_t matrixRank(const Matrix& matParam) {
-  Matrix mat(matParam);
-  rowReduceFully(mat);
-
-  // Find pivots
-  size_t rank = 0;
-  size_t col = 0;
-  size_t row = 0;
-  while (row < mat.getRowCount() && col < mat.getColCount()) {
-    if (mat(row,  col) == 0) {
-      ++col;
-    } else {
-      ++rank;
-      ++row;
-    }
-  }
+size_t matrixRank(const Matrix& mat) {
+  IntegerMatrix<mpz_class> big(mat.getRowCount(), mat.getColCount());
+  makeIntegral(big, mat);
 
-  return rank;
+  IntegerMatrix<long> small(mat.getRowCount(), mat.getColCount());
+  if (copyToLongIfFits(small, big))
+	return fractionFreeRank(small);
+  else
+	return fractionFreeRank(big);
 }
 
-void nullSpace(Matrix& basis, const Matrix& matParam) {
-  Matrix mat(matParam);
-  rowReduceFully(mat);
-
-  // Find pivots
-  size_t rank = 0;
-  vector<char> colHasPivot(mat.getColCount());
-  {
-    size_t col = 0;
-    size_t row = 0;
-    while (row < mat.getRowCount() && col < mat.getColCount()) {
-      if (mat(row,  col) == 0) {
-        ++col;
-      } else {
-        ++rank;
-        colHasPivot[col] = true;
-        ++row;
-      }
-    }
-  }
-
-  // Construct basis
-  basis.resize(mat.getColCount(), mat.getColCount() - rank);
-  size_t nullCol = 0;
-  for (size_t col = 0; col < mat.getColCount(); ++col) {
-    ASSERT(nullCol <= basis.getColCount());
-
-    if (colHasPivot[col])
-      continue;
+void nullSpace(Matrix& basis, const Matrix& mat) {
+  IntegerMatrix<mpz_class> big(mat.getRowCount(), mat.getColCount());
+  makeIntegral(big, mat);
 
-    ASSERT(nullCol < basis.getColCount());
-
-    size_t row = 0;
-    for (size_t nullRow = 0; nullRow < basis.getRowCount(); ++nullRow) {
-      if (colHasPivot[nullRow]) {
-		basis(nullRow, nullCol) = -mat(row, col);
-		++row;
-      } else if (nullRow == col)
-		basis(nullRow, nullCol) = 1;
-      else
-		basis(nullRow, nullCol) = 0;
-    }
-
-    ++nullCol;
-  }
-  ASSERT(nullCol == basis.getColCount());
+  IntegerMatrix<long> small(mat.getRowCount(), mat.getColCount());
+  if (copyToLongIfFits(small, big))
+	fractionFreeNullSpace(basis, small);
+  else
+	fractionFreeNullSpace(basis, big);
 
   // Make basis integer
   for (size_t col = 0; col < basis.getColCount(); ++col)
@@ -356,35 +602,8 @@ bool solve(Matrix& sol, const Matrix& lhs, const Matrix& rhs) {
 	for (size_t row = 0; row < rhs.getRowCount(); ++row)
 	  system(row, midCol + col) = rhs(row, col);
 
-  rowReduceFully(system);
-
-  // Check if system has a solution
-  for (size_t row = 0; row < system.getRowCount(); ++row) {
-	for (size_t col = 0; col < midCol; ++col)
-	  if (system(row, col) != 0)
-		goto hasLeftPivot;
-	for (size_t col = midCol; col < system.getColCount(); ++col)
-	  if (system(row, col) != 0)
-		return false;
-
-  hasLeftPivot:;
-  }
-
-  // Extract solution
-  sol.resize(lhs.getColCount(), rhs.getColCount());
-  size_t row = 0;
-  for (size_t col = 0; col < midCol; ++col) {
-	if (row == system.getRowCount() || system(row, col) == 0) {
-	  for (size_t r = 0; r < sol.getColCount(); ++r)
-		sol(col, r) = 0;
-	} else {
-	  ASSERT(system(row, col) == 1);
-	  for (size_t r = 0; r < sol.getColCount(); ++r)
-		sol(col, r) = system(row, midCol + r);
-	  ++row;
-	}
-  }
-  return true;
+  size_t rank;
+  return solveSystem(sol, system, midCol, rank);
 }
 
 bool hasSameRowSpace(const Matrix& a, const Matrix& b) {
@@ -410,12 +629,19 @@ bool hasSameColSpace(const Matrix& a, const Matrix& b) {
 mpq_class determinant(const Matrix& mat) {
   ASSERT(mat.getRowCount() == mat.getColCount());
 
-  Matrix reduced(mat);
-  bool permutationOdd = rowReduce(reduced);
+  IntegerMatrix<mpz_class> big(mat.getRowCount(), mat.getColCount());
+  mpz_class scale;
+  makeIntegral(big, mat, &scale);
+
+  mpq_class det;
+  IntegerMatrix<long> small(mat.getRowCount(), mat.getColCount());
+  if (copyToLongIfFits(small, big))
+	fractionFreeDeterminant(det, small);
+  else
+	fractionFreeDeterminant(det, big);
 
-  mpq_class det = permutationOdd ? -1 : 1;
-  for (size_t i = 0; i < reduced.getRowCount(); ++i)
-	det *= reduced(i, i);
+  // Each row of big is the row of mat times a factor of scale.
+  det /= scale;
   return det;
 }
 
@@ -371,6 +371,53 @@ TEST(Matrix, Determinant) {
   ASSERT_EQ(determinant(mat4), -2);
 }
 
+TEST(Matrix, DeterminantRational) {
+  Matrix mat = makeMatrix
+	(2,
+	 "1/2    0\n"
+	 "  3  2/3\n");
+  ASSERT_EQ(determinant(mat), mpq_class(1, 3));
+}
+
+TEST(Matrix, LargeEntries) {
+  // These entries are too large for the computation to be done with
+  // machine integers.
+  Matrix mat = makeMatrix
+	(3,
+	 "1000000000000             1             0\n"
+	 "            0 1000000000000             1\n"
+	 "            1             0 1000000000000\n");
+  ASSERT_EQ(determinant(mat),
+			mpq_class("1000000000000000000000000000000000001"));
+  ASSERT_EQ(matrixRank(mat), 3u);
+
+  Matrix inv;
+  ASSERT_TRUE(inverse(inv, mat));
+  Matrix prod;
+  product(prod, mat, inv);
+  ASSERT_EQ(prod, makeMatrix(3, "1 0 0\n0 1 0\n0 0 1\n"));
+
+  mat.resize(2, 3);
+  Matrix basis;
+  nullSpace(basis, mat);
+  ASSERT_EQ(basis, makeMatrix(1,
+							  "1\n"
+							  "-1000000000000\n"
+							  "1000000000000000000000000\n"));
+  ASSERT_EQ(matrixRank(mat), 2u);
+}
+
+TEST(Matrix, NotInvertible) {
+  Matrix mat = makeMatrix(3,
+						  "1 2 3\n"
+						  "4 5 6\n"
+						  "7 8 9\n");
+  Matrix inv;
+  ASSERT_FALSE(inverse(inv, mat));
+  ASSERT_EQ(matrixRank(mat), 2u);
+  ASSERT_EQ(determinant(mat), 0);
+}
+
 TEST(Matrix, IsParallelogram) {
   // zeroes and variations of number of pointsx
   for (size_t dim = 0; dim < 5; ++dim) {
@@ -31,6 +31,8 @@ MaximalStandardAction::MaximalStandardAction():
  "lie in the\nideal for every variable v in the ambient polynomial ring of I.",
  false),
 
+  _sliceParams(false, true, false, true, true, true),
+
   _io(DataType::getMonomialIdealType(), DataType::getMonomialIdealType()),
 
   _increment
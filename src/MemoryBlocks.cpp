@@ -18,6 +18,35 @@
 #include "stdinc.h"
 #include "MemoryBlocks.h"
 
+namespace {
+  // These are plain integers that need no construction, so they can
+  // be used by arenas that are constructed during static
+  // initialization.
+  size_t totalMemoryUsage = 0;
+  size_t peakMemoryUsage = 0;
+
+  void addToMemoryUsage(size_t bytes) {
+#ifdef _OPENMP
+#pragma omp critical (memoryBlocksUsage)
+#endif
+    {
+      totalMemoryUsage += bytes;
+      if (peakMemoryUsage < totalMemoryUsage)
+        peakMemoryUsage = totalMemoryUsage;
+    }
+  }
+
+  void subtractFromMemoryUsage(size_t bytes) {
+#ifdef _OPENMP
+#pragma omp critical (memoryBlocksUsage)
+#endif
+    {
+      ASSERT(totalMemoryUsage >= bytes);
+      totalMemoryUsage -= bytes;
+    }
+  }
+}
+
 void MemoryBlocks::freeAllPreviousBlocks() {
   while (_block.hasPreviousBlock())
 	freePreviousBlock();
@@ -51,12 +80,58 @@ void MemoryBlocks::Block::newBlock(size_t capacityInBytes) {
   _begin = new char[total];
   _position = _begin;
   _end = _begin + capacityInBytes;
+  addToMemoryUsage(capacityInBytes);
 
   ASSERT(!isNull());
   ASSERT(empty());
   ASSERT(capacityInBytes == getBytesInBlock());
 }
 
+void MemoryBlocks::Block::free() {
+  subtractFromMemoryUsage(getBytesInBlock());
+  delete[] begin();
+}
+
+size_t MemoryBlocks::getTotalMemoryUsage() {
+  size_t usage;
+#ifdef _OPENMP
+#pragma omp critical (memoryBlocksUsage)
+#endif
+  usage = totalMemoryUsage;
+  return usage;
+}
+
+size_t MemoryBlocks::getPeakMemoryUsage() {
+  size_t peak;
+#ifdef _OPENMP
+#pragma omp critical (memoryBlocksUsage)
+#endif
+  peak = peakMemoryUsage;
+  return peak;
+}
+
+size_t MemoryBlocks::resetPeakMemoryUsage() {
+  size_t peak;
+#ifdef _OPENMP
+#pragma omp critical (memoryBlocksUsage)
+#endif
+  {
+    peak = peakMemoryUsage;
+    peakMemoryUsage = totalMemoryUsage;
+  }
+  return peak;
+}
+
+void MemoryBlocks::raisePeakMemoryUsage(size_t peak) {
+#ifdef _OPENMP
+#pragma omp critical (memoryBlocksUsage)
+#endif
+  {
+    if (peakMemoryUsage < peak)
+      peakMemoryUsage = peak;
+  }
+}
+
 size_t MemoryBlocks::getMemoryUsage() const {
   size_t sum = 0;
   const Block* block = &_block;
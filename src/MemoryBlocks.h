@@ -60,6 +60,22 @@ class MemoryBlocks {
   /** Returns the total amount of memory allocated by this object. */
   size_t getMemoryUsage() const;
 
+  /** Returns the total amount of memory currently allocated by all
+   MemoryBlocks objects. This includes the memory of all arenas and
+   buffer pools. */
+  static size_t getTotalMemoryUsage();
+
+  /** Returns the largest value that getTotalMemoryUsage() has had
+   since the last call to resetPeakMemoryUsage(). */
+  static size_t getPeakMemoryUsage();
+
+  /** Sets the peak memory usage to the current total memory usage and
+   returns the peak memory usage from before the reset. */
+  static size_t resetPeakMemoryUsage();
+
+  /** Sets the peak memory usage to peak if that is larger. */
+  static void raisePeakMemoryUsage(size_t peak);
+
   /** Rounds value up to the nearest multiple of MemoryAlignment. This
    rounded up value must be representable in a size_t. */
   inline static size_t alignNoOverflow(size_t value);
@@ -121,7 +137,7 @@ class MemoryBlocks {
 	void makeNull();
 
 	/** Frees the memory for this block. */
-	void free() {delete[] begin();}
+	void free();
 
 	/** Frees the memory for the previous block. */
 	void freePrevious();
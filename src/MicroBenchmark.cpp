@@ -0,0 +1,159 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "MicroBenchmark.h"
+
+#include "WallTimer.h"
+#include "ColumnPrinter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+MicroBenchmark::MicroBenchmark(const char* name):
+  _name(name) {
+  ASSERT(name != 0);
+}
+
+MicroBenchmark::~MicroBenchmark() {
+}
+
+vector<MicroBenchmark*>& MicroBenchmark::getBenchmarks() {
+  static vector<MicroBenchmark*> benchmarks;
+  return benchmarks;
+}
+
+namespace {
+  bool nameLess(const MicroBenchmark* a, const MicroBenchmark* b) {
+    return string(a->getName()) < string(b->getName());
+  }
+
+  /** The results of the benchmarks are added to this so that the
+   compiler cannot tell that they are unused. */
+  volatile size_t benchmarkSink = 0;
+}
+
+MicroBenchmarkRunner::MicroBenchmarkRunner():
+  _repetitions(10),
+  _minRepetitionMs(20),
+  _seed(0) {
+}
+
+size_t MicroBenchmarkRunner::runAll(const string& prefix, FILE* out) {
+  vector<MicroBenchmark*> benchmarks;
+  for (size_t i = 0; i < MicroBenchmark::getBenchmarks().size(); ++i) {
+    MicroBenchmark* benchmark = MicroBenchmark::getBenchmarks()[i];
+    if (string(benchmark->getName()).compare(0, prefix.size(), prefix) == 0)
+      benchmarks.push_back(benchmark);
+  }
+  if (benchmarks.empty())
+    return 0;
+  sort(benchmarks.begin(), benchmarks.end(), nameLess);
+
+  ColumnPrinter pr;
+  pr.addColumn(true, "");
+  pr.addColumn(false);
+  pr.addColumn(false);
+  pr.addColumn(false);
+  pr.addColumn(false);
+  pr.addColumn(false);
+  pr[0] << "benchmark\n";
+  pr[1] << "runs/rep\n";
+  pr[2] << "min ns\n";
+  pr[3] << "median ns\n";
+  pr[4] << "mean ns\n";
+  pr[5] << "stddev\n";
+
+  for (size_t i = 0; i < benchmarks.size(); ++i) {
+    Result result;
+    runBenchmark(*benchmarks[i], result);
+
+    pr[0] << benchmarks[i]->getName() << '\n';
+    pr[1] << result.runsPerRepetition << '\n';
+    pr[2] << std::fixed;
+    pr[2].precision(1);
+    pr[2] << result.minNanoseconds << '\n';
+    pr[3] << std::fixed;
+    pr[3].precision(1);
+    pr[3] << result.medianNanoseconds << '\n';
+    pr[4] << std::fixed;
+    pr[4].precision(1);
+    pr[4] << result.meanNanoseconds << '\n';
+    pr[5] << std::fixed;
+    pr[5].precision(1);
+    const double relativeStdDev = result.meanNanoseconds == 0 ? 0 :
+      100 * result.stdDevNanoseconds / result.meanNanoseconds;
+    pr[5] << relativeStdDev << "%\n";
+  }
+
+  fprintf(out, "%lu repetitions of at least %lu ms each, seed %u.\n",
+          static_cast<unsigned long>(_repetitions),
+          static_cast<unsigned long>(_minRepetitionMs), _seed);
+  print(out, pr);
+  return benchmarks.size();
+}
+
+void MicroBenchmarkRunner::runBenchmark(MicroBenchmark& benchmark,
+                                        Result& result) {
+  srand(_seed);
+  benchmark.setUp();
+
+  // Find the number of runs that take at least the minimal time of a
+  // repetition. This also warms up the caches and the branch
+  // predictors.
+  const double minSeconds = _minRepetitionMs / 1000.0;
+  unsigned long runs = 1;
+  while (timeRuns(benchmark, runs) < minSeconds &&
+         runs <= std::numeric_limits<unsigned long>::max() / 2)
+    runs *= 2;
+
+  vector<double> nanoseconds;
+  const size_t repetitions = std::max(_repetitions, static_cast<size_t>(1));
+  for (size_t rep = 0; rep < repetitions; ++rep)
+    nanoseconds.push_back(timeRuns(benchmark, runs) * 1e9 / runs);
+
+  benchmark.tearDown();
+
+  std::sort(nanoseconds.begin(), nanoseconds.end());
+  const size_t count = nanoseconds.size();
+  double sum = 0;
+  for (size_t i = 0; i < count; ++i)
+    sum += nanoseconds[i];
+  const double mean = sum / count;
+  double squareSum = 0;
+  for (size_t i = 0; i < count; ++i)
+    squareSum += (nanoseconds[i] - mean) * (nanoseconds[i] - mean);
+
+  result.runsPerRepetition = runs;
+  result.minNanoseconds = nanoseconds.front();
+  result.medianNanoseconds = count % 2 == 1 ? nanoseconds[count / 2] :
+    (nanoseconds[count / 2 - 1] + nanoseconds[count / 2]) / 2;
+  result.meanNanoseconds = mean;
+  result.stdDevNanoseconds = count < 2 ? 0 : sqrt(squareSum / (count - 1));
+}
+
+double MicroBenchmarkRunner::timeRuns(MicroBenchmark& benchmark,
+                                      unsigned long runs) {
+  size_t sink = 0;
+  WallTimer timer;
+  for (unsigned long run = 0; run < runs; ++run)
+    sink += benchmark.run();
+  const double seconds = timer.getSeconds();
+  benchmarkSink = benchmarkSink + sink;
+  return seconds;
+}
@@ -0,0 +1,109 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef MICRO_BENCHMARK_GUARD
+#define MICRO_BENCHMARK_GUARD
+
+#include <vector>
+#include <string>
+
+class ColumnPrinter;
+
+/** A benchmark of a small piece of code such as a single operation
+ on terms or ideals. Each benchmark prepares its input in setUp and
+ then runs the code being measured in run. The input is generated
+ with the random seed fixed, so the numbers are reproducible.
+
+ Benchmarks are registered by defining a static object of type
+ RegisterMicroBenchmark and are run by MicroBenchmarkRunner. */
+class MicroBenchmark {
+ public:
+  MicroBenchmark(const char* name);
+  virtual ~MicroBenchmark();
+
+  const char* getName() const {return _name;}
+
+  /** Prepares the input for run. Called before the timing starts. */
+  virtual void setUp() {}
+
+  /** Runs the benchmarked code once. Returns a value that depends on
+   what was computed so that the compiler cannot optimize the work
+   away. */
+  virtual size_t run() = 0;
+
+  /** Frees what setUp allocated. */
+  virtual void tearDown() {}
+
+  /** Returns all registered benchmarks. */
+  static std::vector<MicroBenchmark*>& getBenchmarks();
+
+ private:
+  const char* _name;
+};
+
+/** Registers a benchmark of type T, which must be default
+ constructible. Define static objects of this type to register
+ benchmarks. */
+template<class T>
+class RegisterMicroBenchmark {
+ public:
+  RegisterMicroBenchmark() {
+    static T benchmark;
+    MicroBenchmark::getBenchmarks().push_back(&benchmark);
+  }
+};
+
+/** Runs microbenchmarks and collects statistics on their running
+ time. A benchmark is first run for a while to warm up caches and to
+ find how many runs are needed to take up the minimal time of a
+ repetition. Then that number of runs is timed repeatedly, and the
+ time per run is reported as the minimum, median, mean and standard
+ deviation over the repetitions. */
+class MicroBenchmarkRunner {
+ public:
+  MicroBenchmarkRunner();
+
+  void setRepetitions(size_t repetitions) {_repetitions = repetitions;}
+  void setMinRepetitionMilliseconds(size_t ms) {_minRepetitionMs = ms;}
+  void setSeed(unsigned int seed) {_seed = seed;}
+
+  /** Runs the benchmarks whose name begins with prefix and writes a
+   table of the results to out. Returns the number of benchmarks run,
+   and writes nothing if that is zero. */
+  size_t runAll(const string& prefix, FILE* out);
+
+ private:
+  struct Result {
+    unsigned long runsPerRepetition;
+    double minNanoseconds;
+    double medianNanoseconds;
+    double meanNanoseconds;
+    double stdDevNanoseconds;
+  };
+
+  void runBenchmark(MicroBenchmark& benchmark, Result& result);
+
+  /** Returns the number of seconds it takes to call run on benchmark
+   runs times. */
+  static double timeRuns(MicroBenchmark& benchmark, unsigned long runs);
+
+  size_t _repetitions;
+  size_t _minRepetitionMs;
+  unsigned int _seed;
+};
+
+#endif
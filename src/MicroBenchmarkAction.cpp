@@ -0,0 +1,84 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "MicroBenchmarkAction.h"
+
+#include "MicroBenchmark.h"
+#include "error.h"
+
+MicroBenchmarkAction::MicroBenchmarkAction():
+  Action
+(staticGetName(),
+ "Time the core operations of Frobby.",
+ "Time small pieces of code that are central to the performance of\n"
+ "Frobby, such as divisibility tests of terms, minimization of ideals and\n"
+ "memory allocation. The input of each benchmark is generated from a fixed\n"
+ "random seed, so the numbers can be compared between builds. The time\n"
+ "per run of each benchmark is reported in nanoseconds.\n\n"
+ "The benchmarks are only available in the release, debug and profile\n"
+ "builds.",
+ false),
+
+  _filter
+  ("filter",
+   "Only run the benchmarks whose name begins with this prefix.",
+   ""),
+
+  _repetitions
+  ("reps",
+   "The number of timed repetitions of each benchmark.",
+   10),
+
+  _minTime
+  ("minTime",
+   "The minimal number of milliseconds that each repetition takes. A\n"
+   "benchmark is run as many times as needed in each repetition to take\n"
+   "at least this long.",
+   20),
+
+  _seed
+  ("seed",
+   "The random seed used to generate the input of the benchmarks.",
+   0) {
+}
+
+void MicroBenchmarkAction::obtainParameters(vector<Parameter*>& parameters) {
+  Action::obtainParameters(parameters);
+  parameters.push_back(&_filter);
+  parameters.push_back(&_repetitions);
+  parameters.push_back(&_minTime);
+  parameters.push_back(&_seed);
+}
+
+void MicroBenchmarkAction::perform() {
+  MicroBenchmarkRunner runner;
+  runner.setRepetitions(_repetitions);
+  runner.setMinRepetitionMilliseconds(_minTime);
+  runner.setSeed(_seed);
+
+  if (runner.runAll(_filter.getValue(), stdout) == 0)
+    reportError("No benchmark has the prefix \"" + _filter.getValue() + "\".");
+}
+
+const char* MicroBenchmarkAction::staticGetName() {
+  return "microbench";
+}
+
+bool MicroBenchmarkAction::displayAction() const {
+  return false;
+}
@@ -0,0 +1,46 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef MICRO_BENCHMARK_ACTION_GUARD
+#define MICRO_BENCHMARK_ACTION_GUARD
+
+#include "Action.h"
+#include "StringParameter.h"
+#include "IntegerParameter.h"
+
+class MicroBenchmarkAction : public Action {
+ public:
+  MicroBenchmarkAction();
+
+  virtual void obtainParameters(vector<Parameter*>& parameters);
+
+  virtual void perform();
+
+  static const char* staticGetName();
+
+  /// This action is for developers, so it should not be displayed
+  /// by the help action.
+  virtual bool displayAction() const;
+
+ private:
+  StringParameter _filter;
+  IntegerParameter _repetitions;
+  IntegerParameter _minTime;
+  IntegerParameter _seed;
+};
+
+#endif
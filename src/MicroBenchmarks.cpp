@@ -0,0 +1,419 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "MicroBenchmark.h"
+
+#include "BigIdeal.h"
+#include "Ideal.h"
+#include "Term.h"
+#include "TermTranslator.h"
+#include "Minimizer.h"
+#include "HashPolynomial.h"
+#include "RawSquareFreeIdeal.h"
+#include "RawSquareFreeTerm.h"
+#include "Scanner.h"
+#include "Arena.h"
+#include "BufferPool.h"
+#include "randomDataGenerators.h"
+
+#include <cstdlib>
+
+/** @file MicroBenchmarks.cpp
+
+ The benchmarks run by the microbench action. Each run of a benchmark
+ performs its operation on every generator of a random ideal or a
+ similar amount of work, so the reported time is per pass rather than
+ per operation. Add a benchmark here when optimizing an operation so
+ that the change can be measured. */
+
+namespace Ops = SquareFreeTermOps;
+
+namespace {
+  /** Sets ideal to a random ideal generated with the current random
+   seed. */
+  void makeRandomIdeal(Ideal& ideal, size_t exponentRange,
+                       size_t varCount, size_t genCount) {
+    BigIdeal bigIdeal;
+    generateRandomIdeal(bigIdeal, exponentRange, varCount, genCount);
+    TermTranslator translator(bigIdeal, ideal, false);
+  }
+
+  /** A benchmark on the generators of a random ideal with 10
+   variables and 1000 generators. */
+  class IdealBenchmark : public MicroBenchmark {
+  public:
+    IdealBenchmark(const char* name): MicroBenchmark(name) {}
+
+    virtual void setUp() {
+      makeRandomIdeal(_ideal, 10, 10, 1000);
+      _tmp.reset(_ideal.getVarCount());
+    }
+
+    virtual void tearDown() {
+      _ideal.clearAndSetVarCount(0);
+    }
+
+  protected:
+    Ideal _ideal;
+    Term _tmp;
+  };
+
+  class TermDividesBenchmark : public IdealBenchmark {
+  public:
+    TermDividesBenchmark(): IdealBenchmark("termDivides") {}
+
+    virtual size_t run() {
+      const size_t varCount = _ideal.getVarCount();
+      size_t count = 0;
+      Ideal::const_iterator prev = _ideal.end() - 1;
+      Ideal::const_iterator end = _ideal.end();
+      for (Ideal::const_iterator it = _ideal.begin(); it != end; ++it) {
+        if (Term::divides(*prev, *it, varCount))
+          ++count;
+        prev = it;
+      }
+      return count;
+    }
+  };
+  RegisterMicroBenchmark<TermDividesBenchmark> registerTermDivides;
+
+  class TermLcmBenchmark : public IdealBenchmark {
+  public:
+    TermLcmBenchmark(): IdealBenchmark("termLcm") {}
+
+    virtual size_t run() {
+      const size_t varCount = _ideal.getVarCount();
+      Ideal::const_iterator prev = _ideal.end() - 1;
+      Ideal::const_iterator end = _ideal.end();
+      for (Ideal::const_iterator it = _ideal.begin(); it != end; ++it) {
+        Term::lcm(_tmp.begin(), *prev, *it, varCount);
+        prev = it;
+      }
+      return _tmp[0];
+    }
+  };
+  RegisterMicroBenchmark<TermLcmBenchmark> registerTermLcm;
+
+  /** A benchmark on an ideal that is not minimally generated. The
+   ideal is a random ideal with 1000 generators and a non-minimal
+   multiple of each of those. */
+  class NonMinimalIdealBenchmark : public IdealBenchmark {
+  public:
+    NonMinimalIdealBenchmark(const char* name): IdealBenchmark(name) {}
+
+    virtual void setUp() {
+      IdealBenchmark::setUp();
+      const size_t genCount = _ideal.getGeneratorCount();
+      for (size_t gen = 0; gen < genCount; ++gen) {
+        _tmp = _ideal[gen];
+        _tmp[rand() % _tmp.getVarCount()] += 1;
+        _ideal.insert(_tmp);
+      }
+    }
+  };
+
+  class IdealMinimizeBenchmark : public NonMinimalIdealBenchmark {
+  public:
+    IdealMinimizeBenchmark(): NonMinimalIdealBenchmark("idealMinimize") {}
+
+    virtual size_t run() {
+      _copy = _ideal;
+      _copy.minimize();
+      return _copy.getGeneratorCount();
+    }
+
+  private:
+    Ideal _copy;
+  };
+  RegisterMicroBenchmark<IdealMinimizeBenchmark> registerIdealMinimize;
+
+  class MinimizerMinimizeBenchmark : public NonMinimalIdealBenchmark {
+  public:
+    MinimizerMinimizeBenchmark():
+      NonMinimalIdealBenchmark("minimizerMinimize") {}
+
+    virtual void setUp() {
+      NonMinimalIdealBenchmark::setUp();
+      _terms.assign(_ideal.begin(), _ideal.end());
+    }
+
+    virtual size_t run() {
+      // Minimizer only moves the pointers, so the terms do not have
+      // to be copied.
+      _copy = _terms;
+      Minimizer minimizer(_ideal.getVarCount());
+      return minimizer.minimize(_copy.begin(), _copy.end()) - _copy.begin();
+    }
+
+  private:
+    vector<Exponent*> _terms;
+    vector<Exponent*> _copy;
+  };
+  RegisterMicroBenchmark<MinimizerMinimizeBenchmark> registerMinimizer;
+
+  class IdealColonReminimizeBenchmark : public IdealBenchmark {
+  public:
+    IdealColonReminimizeBenchmark():
+      IdealBenchmark("idealColonReminimize") {}
+
+    virtual void setUp() {
+      IdealBenchmark::setUp();
+      for (size_t var = 0; var < _tmp.getVarCount(); ++var)
+        _tmp[var] = 3;
+    }
+
+    virtual size_t run() {
+      _copy = _ideal;
+      _copy.colonReminimize(_tmp);
+      return _copy.getGeneratorCount();
+    }
+
+  private:
+    Ideal _copy;
+  };
+  RegisterMicroBenchmark<IdealColonReminimizeBenchmark>
+    registerIdealColonReminimize;
+
+  class HashPolynomialAddBenchmark : public IdealBenchmark {
+  public:
+    HashPolynomialAddBenchmark(): IdealBenchmark("hashPolynomialAdd") {}
+
+    virtual void setUp() {
+      IdealBenchmark::setUp();
+      _terms.clear();
+      for (size_t gen = 0; gen < _ideal.getGeneratorCount(); ++gen)
+        _terms.push_back(Term(_ideal[gen], _ideal.getVarCount()));
+    }
+
+    virtual size_t run() {
+      // Add each term twice so that both inserting new terms and
+      // updating existing terms are measured.
+      HashPolynomial poly(_ideal.getVarCount());
+      for (size_t i = 0; i < _terms.size(); ++i)
+        poly.add(true, _terms[i]);
+      for (size_t i = 0; i < _terms.size(); i += 2)
+        poly.add(false, _terms[i]);
+      return poly.getTermCount();
+    }
+
+    virtual void tearDown() {
+      IdealBenchmark::tearDown();
+      _terms.clear();
+    }
+
+  private:
+    vector<Term> _terms;
+  };
+  RegisterMicroBenchmark<HashPolynomialAddBenchmark> registerHashPolynomial;
+
+  /** A benchmark on the generators of a random square free ideal with
+   200 variables and 1000 generators. */
+  class SquareFreeBenchmark : public MicroBenchmark {
+  public:
+    SquareFreeBenchmark(const char* name):
+      MicroBenchmark(name), _ideal(0), _tmp(0) {}
+
+    virtual void setUp() {
+      Ideal ideal;
+      makeRandomIdeal(ideal, 1, 200, 1000);
+      _ideal = newRawSquareFreeIdeal(ideal.getVarCount(),
+                                     ideal.getGeneratorCount());
+      _ideal->insert(ideal);
+      _tmp = Ops::newTerm(ideal.getVarCount());
+    }
+
+    virtual void tearDown() {
+      deleteRawSquareFreeIdeal(_ideal);
+      _ideal = 0;
+      Ops::deleteTerm(_tmp);
+      _tmp = 0;
+    }
+
+  protected:
+    RawSquareFreeIdeal* _ideal;
+    Word* _tmp;
+  };
+
+  class SquareFreeDividesBenchmark : public SquareFreeBenchmark {
+  public:
+    SquareFreeDividesBenchmark(): SquareFreeBenchmark("squareFreeDivides") {}
+
+    virtual size_t run() {
+      const size_t wordCount = _ideal->getWordsPerTerm();
+      size_t count = 0;
+      const Word* prev = _ideal->getGenerator(_ideal->getGeneratorCount() - 1);
+      RawSquareFreeIdeal::const_iterator end = _ideal->end();
+      RawSquareFreeIdeal::const_iterator it = _ideal->begin();
+      for (; it != end; ++it) {
+        if (Ops::divides(prev, prev + wordCount, *it))
+          ++count;
+        prev = *it;
+      }
+      return count;
+    }
+  };
+  RegisterMicroBenchmark<SquareFreeDividesBenchmark> registerSquareFreeDivides;
+
+  class SquareFreeLcmBenchmark : public SquareFreeBenchmark {
+  public:
+    SquareFreeLcmBenchmark(): SquareFreeBenchmark("squareFreeLcm") {}
+
+    virtual size_t run() {
+      const size_t varCount = _ideal->getVarCount();
+      const Word* prev = _ideal->getGenerator(_ideal->getGeneratorCount() - 1);
+      RawSquareFreeIdeal::const_iterator end = _ideal->end();
+      RawSquareFreeIdeal::const_iterator it = _ideal->begin();
+      for (; it != end; ++it) {
+        Ops::lcm(_tmp, prev, *it, varCount);
+        prev = *it;
+      }
+      return static_cast<size_t>(*_tmp);
+    }
+  };
+  RegisterMicroBenchmark<SquareFreeLcmBenchmark> registerSquareFreeLcm;
+
+  class SquareFreeMinimizeBenchmark : public SquareFreeBenchmark {
+  public:
+    SquareFreeMinimizeBenchmark():
+      SquareFreeBenchmark("squareFreeMinimize"), _copy(0) {}
+
+    /** Adds a non-minimal multiple of each generator. */
+    virtual void setUp() {
+      SquareFreeBenchmark::setUp();
+      const size_t varCount = _ideal->getVarCount();
+      const size_t genCount = _ideal->getGeneratorCount();
+      RawSquareFreeIdeal* ideal = newRawSquareFreeIdeal(varCount, 2 * genCount);
+      ideal->insert(*_ideal);
+      for (size_t gen = 0; gen < genCount; ++gen) {
+        Ops::assign(_tmp, _ideal->getGenerator(gen), varCount);
+        Ops::setExponent(_tmp, rand() % varCount, 1);
+        ideal->insert(_tmp);
+      }
+      deleteRawSquareFreeIdeal(_ideal);
+      _ideal = ideal;
+      _copy = newRawSquareFreeIdeal(varCount, 2 * genCount);
+    }
+
+    virtual void tearDown() {
+      deleteRawSquareFreeIdeal(_copy);
+      _copy = 0;
+      SquareFreeBenchmark::tearDown();
+    }
+
+    virtual size_t run() {
+      *_copy = *_ideal;
+      _copy->minimize();
+      return _copy->getGeneratorCount();
+    }
+
+  private:
+    RawSquareFreeIdeal* _copy;
+  };
+  RegisterMicroBenchmark<SquareFreeMinimizeBenchmark>
+    registerSquareFreeMinimize;
+
+  class ScannerReadIntegerBenchmark : public MicroBenchmark {
+  public:
+    ScannerReadIntegerBenchmark():
+      MicroBenchmark("scannerReadInteger"), _file(0) {}
+
+    virtual void setUp() {
+      _file = tmpfile();
+      if (_file == 0)
+        throw bad_alloc();
+      for (size_t i = 0; i < 1000; ++i)
+        fprintf(_file, "%d\n", rand() % 1000000);
+      for (size_t i = 0; i < 10; ++i)
+        fprintf(_file, "%d%d%d\n", rand(), rand(), rand());
+    }
+
+    virtual size_t run() {
+      rewind(_file);
+      Scanner in("m2", _file);
+      size_t sum = 0;
+      while (!in.matchEOF()) {
+        in.readInteger(_integer);
+        sum += mpz_get_ui(_integer.get_mpz_t());
+      }
+      return sum;
+    }
+
+    virtual void tearDown() {
+      fclose(_file);
+      _file = 0;
+    }
+
+  private:
+    FILE* _file;
+    mpz_class _integer;
+  };
+  RegisterMicroBenchmark<ScannerReadIntegerBenchmark> registerScanner;
+
+  /** The sizes of the buffers allocated by the allocation benchmarks. */
+  const size_t AllocCount = 1000;
+  const size_t AllocSizes[] = {8, 24, 16, 40, 64, 8, 32, 16};
+  const size_t AllocSizeCount = sizeof(AllocSizes) / sizeof(AllocSizes[0]);
+
+  class ArenaAllocBenchmark : public MicroBenchmark {
+  public:
+    ArenaAllocBenchmark(): MicroBenchmark("arenaAlloc") {}
+
+    virtual size_t run() {
+      size_t sum = 0;
+      for (size_t i = 0; i < AllocCount; ++i) {
+        char* ptr = static_cast<char*>
+          (_arena.alloc(AllocSizes[i % AllocSizeCount]));
+        *ptr = static_cast<char>(i);
+        sum += *ptr;
+      }
+      _arena.freeAllAllocs();
+      return sum;
+    }
+
+    virtual void tearDown() {
+      _arena.freeAllAllocsAndBackingMemory();
+    }
+
+  private:
+    Arena _arena;
+  };
+  RegisterMicroBenchmark<ArenaAllocBenchmark> registerArena;
+
+  class BufferPoolAllocBenchmark : public MicroBenchmark {
+  public:
+    BufferPoolAllocBenchmark():
+      MicroBenchmark("bufferPoolAlloc"), _pool(32) {}
+
+    virtual size_t run() {
+      // Free in a different order than allocating so that the free
+      // list is not always in address order.
+      for (size_t i = 0; i < AllocCount; ++i)
+        _buffers[i] = _pool.alloc();
+      for (size_t i = 0; i < AllocCount; i += 2)
+        _pool.free(_buffers[i]);
+      for (size_t i = 1; i < AllocCount; i += 2)
+        _pool.free(_buffers[i]);
+      return reinterpret_cast<size_t>(_buffers[0]) & 0xff;
+    }
+
+  private:
+    BufferPool _pool;
+    void* _buffers[AllocCount];
+  };
+  RegisterMicroBenchmark<BufferPoolAllocBenchmark> registerBufferPool;
+}
@@ -288,6 +288,64 @@ pair<Minimizer::iterator, bool> Minimizer::colonReminimize
       ++it;
   }
 
+  return reminimizeAfterColon(begin, blockBegin, end);
+}
+
+pair<Minimizer::iterator, bool> Minimizer::colonReminimize
+(const_iterator srcBegin, iterator begin, iterator end,
+ const Exponent* colon) {
+  if (Term::getSizeOfSupport(colon, _varCount) == 1) {
+    size_t var = Term::getFirstNonZeroExponent(colon, _varCount);
+    return colonReminimize(srcBegin, begin, end, var, colon[var]);
+  }
+
+  // This is the same as the in-place version except that the colon is
+  // written into the term at it instead of being done in place. The
+  // terms at [it, blockBegin) have not been written yet, and they
+  // correspond to the same positions among the source terms except
+  // that the term at it corresponds to the source term that the
+  // in-place version would have swapped there. Keeping track of this
+  // makes the order of the result the same as for the in-place
+  // version.
+  const iterator firstTerm = begin;
+  iterator blockBegin = end;
+  const_iterator src = srcBegin;
+  for (iterator it = begin; it != blockBegin;) {
+    const Exponent* from = *src;
+    Exponent* to = *it;
+    bool block = true;
+    bool strictDivision = true;
+    for (size_t var = 0; var < _varCount; ++var) {
+      if (colon[var] >= from[var]) {
+        if (from[var] > 0)
+          block = false;
+        if (colon[var] > 0)
+          strictDivision = false;
+        to[var] = 0;
+      } else
+        to[var] = from[var] - colon[var];
+    }
+
+    if (strictDivision) {
+      swap(*begin, *it);
+      ++begin;
+      ++it;
+      src = srcBegin + (it - firstTerm);
+    } else if (block) {
+      --blockBegin;
+      swap(*it, *blockBegin);
+      src = srcBegin + (blockBegin - firstTerm);
+    } else {
+      ++it;
+      src = srcBegin + (it - firstTerm);
+    }
+  }
+
+  return reminimizeAfterColon(begin, blockBegin, end);
+}
+
+pair<Minimizer::iterator, bool> Minimizer::reminimizeAfterColon
+(iterator begin, iterator blockBegin, iterator end) {
   if (begin == blockBegin)
     return make_pair(end, false);
 
@@ -367,6 +425,43 @@ pair<Minimizer::iterator, bool> Minimizer::colonReminimize
       ++it;
   }
 
+  return reminimizeAfterColon(begin, zeroBegin, end, var, exponent);
+}
+
+pair<Minimizer::iterator, bool> Minimizer::colonReminimize
+(const_iterator srcBegin, iterator begin, iterator end,
+ size_t var, Exponent exponent) {
+  // This is the same as the in-place version except that each term is
+  // copied into the term at it before it is looked at. The source term
+  // is tracked as in the general version above.
+  const iterator firstTerm = begin;
+  iterator zeroBegin = end;
+  const_iterator src = srcBegin;
+  for (iterator it = begin; it != zeroBegin;) {
+    Exponent* to = *it;
+    copy(*src, *src + _varCount, to);
+    if (to[var] > exponent) {
+      to[var] -= exponent; // apply colon
+      swap(*it, *begin);
+      ++begin;
+      ++it;
+      src = srcBegin + (it - firstTerm);
+    } else if (to[var] == 0) {
+      --zeroBegin;
+      swap(*it, *zeroBegin);
+      src = srcBegin + (zeroBegin - firstTerm);
+    } else {
+      ++it;
+      src = srcBegin + (it - firstTerm);
+    }
+  }
+
+  return reminimizeAfterColon(begin, zeroBegin, end, var, exponent);
+}
+
+pair<Minimizer::iterator, bool> Minimizer::reminimizeAfterColon
+(iterator begin, iterator zeroBegin, iterator end,
+ size_t var, Exponent exponent) {
   if (begin == zeroBegin)
     return make_pair(end, false);
 
@@ -35,12 +35,38 @@ class Minimizer {
   pair<iterator, bool> colonReminimize(iterator begin, iterator end,
                                        size_t var, Exponent exponent);
 
+  /** As colonReminimize, except that the terms are not changed in
+   place. Instead the colon of the term at srcBegin + i is written
+   into the term at begin + i for each i, which saves a pass over the
+   terms compared to copying them first. */
+  pair<iterator, bool> colonReminimize(const_iterator srcBegin,
+                                       iterator begin, iterator end,
+                                       const Exponent* colon);
+  pair<iterator, bool> colonReminimize(const_iterator srcBegin,
+                                       iterator begin, iterator end,
+                                       size_t var, Exponent exponent);
+
   bool dominatesAny(iterator begin, iterator end, const Exponent* term);
   bool dividesAny(iterator begin, iterator end, const Exponent* term);
 
   bool isMinimallyGenerated(const_iterator begin, const_iterator end);
 
  private:
+  /** Reminimizes after a general colon. [begin, blockBegin) are the
+   terms that may have become non-minimal and [blockBegin, end) are
+   those that kept their support. */
+  pair<iterator, bool> reminimizeAfterColon(iterator begin,
+                                            iterator blockBegin,
+                                            iterator end);
+
+  /** Reminimizes after a colon by var^exponent. [begin, zeroBegin)
+   are the terms with var exponent at most exponent that have not had
+   the colon applied and [zeroBegin, end) have var exponent zero. */
+  pair<iterator, bool> reminimizeAfterColon(iterator begin,
+                                            iterator zeroBegin,
+                                            iterator end,
+                                            size_t var, Exponent exponent);
+
   size_t _varCount;
 };
 
@@ -143,7 +143,17 @@ void MsmSlice::setToProjOf(const MsmSlice& slice,
 bool MsmSlice::innerSlice(const Term& pivot) {
   ASSERT(!removeDoubleLcm());
 
-  bool changedMuch = Slice::innerSlice(pivot);
+  return updateAfterInnerSlice(Slice::innerSlice(pivot));
+}
+
+bool MsmSlice::setToInnerSliceOf(const Slice& slice, const Term& pivot) {
+  ASSERT(dynamic_cast<const MsmSlice*>(&slice) != 0);
+
+  _consumer = ((MsmSlice&)slice)._consumer;
+  return updateAfterInnerSlice(Slice::setToInnerSliceOf(slice, pivot));
+}
+
+bool MsmSlice::updateAfterInnerSlice(bool changedMuch) {
   if (!_lcmUpdated)
     changedMuch = removeDoubleLcm() || changedMuch;
 
@@ -200,11 +210,10 @@ bool MsmSlice::removeDoubleLcm() {
 
   while (true) {
     DoubleLcmPredicate pred(getLcm());
-    if (!_ideal.removeIf(pred))
+    if (!removeFromIdealIf(pred))
       break;
 
     removedAny = true;
-    _lcmUpdated = false;
   };
 
   return removedAny;
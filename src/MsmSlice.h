@@ -60,6 +60,7 @@ class MsmSlice : public Slice {
   void swap(MsmSlice& slice);
 
   virtual bool innerSlice(const Term& pivot);
+  virtual bool setToInnerSliceOf(const Slice& slice, const Term& pivot);
   virtual void outerSlice(const Term& pivot);
 
  private:
@@ -69,6 +70,10 @@ class MsmSlice : public Slice {
   // generators were removed.
   bool removeDoubleLcm();
 
+  // Does the part of innerSlice and setToInnerSliceOf that comes after
+  // the inner slice of Slice, which returned changedMuch.
+  bool updateAfterInnerSlice(bool changedMuch);
+
   // Calculates the gcd of those generators of getIdeal() that are
   // divisible by var. This gcd is then divided by var to yield a
   // lower bound on the content of the slice. Returns false if a base
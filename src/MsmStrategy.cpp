@@ -24,12 +24,44 @@
 #include <vector>
 #include "Projection.h"
 #include "TermGrader.h"
+#include "Profiler.h"
+#include "TreeTrace.h"
+#include "SliceCheckpoint.h"
+#include "WallTimer.h"
+#include "ProgressMeter.h"
+
+namespace {
+  /** Passes terms on to another consumer and counts them for the
+   ProgressMeter. */
+  class OutputCounter : public TermConsumer {
+  public:
+    OutputCounter(TermConsumer* consumer): _consumer(consumer) {}
+
+    virtual void beginConsuming() {
+      _consumer->beginConsuming();
+    }
+
+    virtual void consume(const Term& term) {
+      ProgressMeter::getSingleton().addOutputTerms(1);
+      _consumer->consume(term);
+    }
+
+    virtual void doneConsuming() {
+      _consumer->doneConsuming();
+    }
+
+  private:
+    TermConsumer* _consumer;
+  };
+}
 
 MsmStrategy::MsmStrategy(TermConsumer* consumer,
                          const SplitStrategy* splitStrategy):
   SliceStrategyCommon(splitStrategy),
   _consumer(consumer),
-  _initialSubtract(0) {
+  _initialSubtract(0),
+  _checkpointIntervalSeconds(0),
+  _resumeFromCheckpoint(false) {
   ASSERT(consumer != 0);
 }
 
@@ -38,10 +70,16 @@ MsmStrategy::MsmStrategy(TermConsumer* consumer,
                          const Ideal& initialSubtract):
   SliceStrategyCommon(splitStrategy),
   _consumer(consumer),
-  _initialSubtract(new Ideal(initialSubtract)) {
+  _initialSubtract(new Ideal(initialSubtract)),
+  _checkpointIntervalSeconds(0),
+  _resumeFromCheckpoint(false) {
   ASSERT(consumer != 0);
 }
 
+MsmStrategy::~MsmStrategy() {
+  disposePendingTasks();
+}
+
 void MsmStrategy::run(const Ideal& ideal) {
   ASSERT(_initialSubtract.get() == 0 ||
          _initialSubtract->getVarCount() == ideal.getVarCount());
@@ -55,27 +93,137 @@ void MsmStrategy::run(const Ideal& ideal) {
   for (size_t var = 0; var < varCount; ++var)
     sliceMultiply[var] = 1;
 
-  auto_ptr<Slice> slice
-    (new MsmSlice(*this, ideal, *_initialSubtract, sliceMultiply, _consumer));
-  simplify(*slice);
+  ProfilePhase phase("Slice algorithm");
+  if (hasShards()) {
+    runWithShards(ideal, sliceMultiply);
+    _initialSubtract.reset();
+    _consumer->doneConsuming();
+    return;
+  }
 
+  OutputCounter counter(_consumer);
+  TermConsumer* consumer = _consumer;
+  if (ProgressMeter::getSingleton().isEnabled())
+    consumer = &counter;
+
+  auto_ptr<SliceCheckpoint> checkpoint;
+  if (!_checkpointFileName.empty()) {
+    // The slices of an independence split pass their output to the
+    // split instead of to the consumer, so they cannot be written to a
+    // checkpoint.
+    setUseIndependence(false);
+    checkpoint.reset
+      (new SliceCheckpoint(_checkpointFileName, varCount, consumer));
+    consumer = checkpoint.get();
+  }
+
+  if (_resumeFromCheckpoint) {
+    ASSERT(checkpoint.get() != 0);
+    resumeFromCheckpoint(ideal, *checkpoint);
+  } else {
+    if (checkpoint.get() != 0)
+      checkpoint->beginRun();
+    auto_ptr<Slice> slice
+      (new MsmSlice(*this, ideal, *_initialSubtract, sliceMultiply, consumer));
+    simplify(*slice);
+    _tasks.addTask(slice.release());
+  }
   _initialSubtract.reset();
-  _tasks.addTask(slice.release());
-  _tasks.runTasks();
+
+  if (checkpoint.get() != 0) {
+    runTasksWithCheckpoints(ideal, *checkpoint);
+    checkpoint->removeFile();
+  } else
+    _tasks.runTasks();
   _consumer->doneConsuming();
 }
 
+void MsmStrategy::runWithShards(const Ideal& ideal,
+                                const Term& sliceMultiply) {
+  if (_shards->getStep() != SliceShards::MergeStep) {
+    SliceShards::ResultWriter root
+      (_shards->getRootResultFileName(), SliceShards::IdealKind,
+       ideal.getVarCount(), SliceFile::hashIdeal(ideal));
+    auto_ptr<Slice> slice
+      (new MsmSlice(*this, ideal, *_initialSubtract, sliceMultiply, &root));
+    simplify(*slice);
+    _tasks.addTask(slice.release());
+    splitIntoShards(SliceShards::IdealKind, ideal);
+    root.close();
+
+    if (_shards->getStep() == SliceShards::SplitStep)
+      return;
+    _shards->runLocalWorkers();
+  }
+
+  _shards->mergeResults(ideal, *_consumer);
+  if (_shards->getStep() == SliceShards::AllSteps)
+    _shards->removeFiles();
+}
+
+void MsmStrategy::setCheckpoint(const string& fileName,
+                                unsigned long intervalSeconds,
+                                bool resume) {
+  ASSERT(!fileName.empty());
+  _checkpointFileName = fileName;
+  _checkpointIntervalSeconds = intervalSeconds;
+  _resumeFromCheckpoint = resume;
+}
+
+void MsmStrategy::runTasksWithCheckpoints(const Ideal& ideal,
+                                          SliceCheckpoint& checkpoint) {
+  vector<const Slice*> slices;
+  WallTimer timer;
+  while (_tasks.runNextTask()) {
+    if (timer.getSeconds() < _checkpointIntervalSeconds)
+      continue;
+
+    ProfilePhase phase("Writing checkpoint");
+    slices.clear();
+    for (size_t i = 0; i < _tasks.getPendingTaskCount(); ++i) {
+      MsmSlice* slice = dynamic_cast<MsmSlice*>(_tasks.getPendingTask(i));
+      ASSERT(slice != 0);
+      ASSERT(slice->getConsumer() == &checkpoint);
+      slices.push_back(slice);
+    }
+    checkpoint.write(ideal, slices);
+    timer.reset();
+  }
+}
+
+void MsmStrategy::resumeFromCheckpoint(const Ideal& input,
+                                       SliceCheckpoint& checkpoint) {
+  const size_t varCount = input.getVarCount();
+  Ideal ideal(varCount);
+  Ideal subtract(varCount);
+  Term multiply(varCount);
+
+  const size_t sliceCount = checkpoint.beginResume(input);
+  for (size_t i = 0; i < sliceCount; ++i) {
+    checkpoint.readSlice(ideal, subtract, multiply);
+    auto_ptr<Slice> slice
+      (new MsmSlice(*this, ideal, subtract, multiply, &checkpoint));
+    simplify(*slice);
+    _tasks.addTask(slice.release());
+  }
+  checkpoint.endResume();
+}
+
 bool MsmStrategy::processSlice(TaskEngine& tasks, auto_ptr<Slice> slice) {
   ASSERT(slice.get() != 0);
+  TraceNode node(TreeTrace::SliceAlgorithm, tasks.getCurrentDepth(),
+                 slice->getIdeal().getGeneratorCount(), slice->getVarCount());
 
   if (slice->baseCase(getUseSimplification())) {
+    traceNodeKind(TreeTrace::BaseCase);
     freeSlice(slice);
     return true;
   }
 
-  if (getUseIndependence() && _indep.analyze(*slice))
+  if (getUseIndependence() && _indep.analyze(*slice)) {
+    traceNodeKind(TreeTrace::IndependenceSplit);
     independenceSplit(slice);
-  else if (_split->isLabelSplit())
+  } else if (_split->isLabelSplit())
     labelSplit(slice);
   else {
     ASSERT(_split->isPivotSplit());
@@ -85,6 +233,13 @@ bool MsmStrategy::processSlice(TaskEngine& tasks, auto_ptr<Slice> slice) {
   return false;
 }
 
+auto_ptr<Slice> MsmStrategy::makeSlice(const Ideal& ideal,
+                                       const Ideal& subtract,
+                                       const Term& multiply) {
+  return auto_ptr<Slice>
+    (new MsmSlice(*this, ideal, subtract, multiply, _consumer));
+}
+
 auto_ptr<MsmSlice> MsmStrategy::newMsmSlice() {
   auto_ptr<Slice> slice(newSlice());
   ASSERT(dynamic_cast<MsmSlice*>(slice.get()) != 0);
@@ -111,6 +266,7 @@ void MsmStrategy::labelSplit(auto_ptr<Slice> sliceParam) {
   ASSERT(!slice->normalize());
   ASSERT(_split != 0);
   size_t var = _split->getLabelSplitVariable(*slice);
+  traceNodeKind(TreeTrace::LabelSplit, var, 1);
 
   Term term(slice->getVarCount());
 
@@ -218,6 +374,10 @@ private:
     delete this;
   }
 
+  virtual bool isTreeNode() const {
+    return false;
+  }
+
   virtual void beginConsuming() {
   }
 
@@ -33,23 +33,37 @@ class TermGrader;
 class IndependenceSplitter;
 class SliceEvent;
 class TermConsumer;
+class SliceCheckpoint;
 
 class MsmStrategy : public SliceStrategyCommon {
  public:
   MsmStrategy(TermConsumer* consumer, const SplitStrategy* splitStrategy);
   MsmStrategy(TermConsumer* consumer, const SplitStrategy* splitStrategy,
               const Ideal& initialSubtract);
+  virtual ~MsmStrategy();
 
   virtual void run(const Ideal& ideal);
 
   virtual bool processSlice(TaskEngine& tasks, auto_ptr<Slice> slice);
 
+  /** Write a checkpoint to fileName every intervalSeconds seconds
+   while running, so that an interrupted run can be resumed. If resume
+   is true, then run resumes the run saved in fileName instead of
+   starting from the beginning. The file is deleted once the run is
+   done. See SliceCheckpoint. */
+  void setCheckpoint(const string& fileName,
+                     unsigned long intervalSeconds,
+                     bool resume);
+
  protected:
   virtual void getPivot(Term& pivot, Slice& slice);
   virtual void getPivot(Term& pivot, Slice& slice, const TermGrader& grader);
 
  private:
   auto_ptr<MsmSlice> newMsmSlice();
+  virtual auto_ptr<Slice> makeSlice(const Ideal& ideal,
+                                    const Ideal& subtract,
+                                    const Term& multiply);
   virtual auto_ptr<Slice> allocateSlice();
   virtual bool debugIsValidSlice(Slice* slice);
 
@@ -59,10 +73,22 @@ class MsmStrategy : public SliceStrategyCommon {
 
   size_t getLabelSplitVariable(const Slice& slice);
 
+  /** Carries out the steps of the run given by _shards. */
+  void runWithShards(const Ideal& ideal, const Term& sliceMultiply);
+
+  /** Runs the pending tasks while writing checkpoints. */
+  void runTasksWithCheckpoints(const Ideal& ideal,
+                               SliceCheckpoint& checkpoint);
+  void resumeFromCheckpoint(const Ideal& input, SliceCheckpoint& checkpoint);
+
   IndependenceSplitter _indep;
   TermConsumer* _consumer;
 
   auto_ptr<Ideal> _initialSubtract;
+
+  string _checkpointFileName;
+  unsigned long _checkpointIntervalSeconds;
+  bool _resumeFromCheckpoint;
 };
 
 #endif
@@ -0,0 +1,79 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "Parallel.h"
+
+#include "error.h"
+
+ParallelExceptionCatcher::ParallelExceptionCatcher():
+  _kind(NoException) {
+}
+
+void ParallelExceptionCatcher::catchCurrent() {
+  Kind kind = Unknown;
+  string message;
+  try {
+    throw;
+  } catch (const bad_alloc&) {
+    kind = BadAlloc;
+  } catch (const CancelledException& e) {
+    kind = Cancelled;
+    message = e.what();
+  } catch (const FrobbyException& e) {
+    kind = Frobby;
+    message = e.what();
+  } catch (const InternalFrobbyException& e) {
+    kind = InternalFrobby;
+    message = e.what();
+  } catch (...) {
+    kind = Unknown;
+  }
+
+#ifdef _OPENMP
+#pragma omp critical (ParallelExceptionCatcher)
+#endif
+  {
+    if (_kind == NoException) {
+      _message = message;
+      _kind = kind;
+    }
+  }
+}
+
+void ParallelExceptionCatcher::rethrowIfCaught() const {
+  switch (_kind) {
+  case NoException:
+    return;
+
+  case BadAlloc:
+    throw bad_alloc();
+
+  case Cancelled:
+    throw CancelledException(_message);
+
+  case Frobby:
+    throw FrobbyException(_message);
+
+  case InternalFrobby:
+    throw InternalFrobbyException(_message);
+
+  case Unknown:
+  default:
+    reportInternalError("Unknown exception thrown in parallel region.");
+  }
+}
@@ -0,0 +1,164 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef PARALLEL_GUARD
+#define PARALLEL_GUARD
+
+/** \file Parallel.h
+
+ Frobby can run parts of some algorithms on several cores using
+ OpenMP. This is only enabled if Frobby is compiled with OpenMP
+ support, e.g. by passing OPENMP=yes to make. Otherwise the functions
+ in this file report that there is a single thread and the code runs
+ serially as usual.
+
+ Put each OpenMP pragma inside #ifdef _OPENMP, together with any
+ variable that only the pragma uses. Otherwise a build without OpenMP
+ warns about unknown pragmas and unused variables, and the debug build
+ treats those warnings as errors.
+
+ The number of threads is controlled through the environment variable
+ OMP_NUM_THREADS as usual for OpenMP.
+*/
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <string>
+
+/** Returns the maximal number of threads that a parallel region
+ started now will use. */
+inline size_t getMaxThreadCount() {
+#ifdef _OPENMP
+  return static_cast<size_t>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+
+/** Returns the index of the calling thread in its team of
+ threads. This is zero outside of parallel regions. */
+inline size_t getThreadIndex() {
+#ifdef _OPENMP
+  return static_cast<size_t>(omp_get_thread_num());
+#else
+  return 0;
+#endif
+}
+
+/** Returns true if the calling thread is inside an active parallel
+ region. Code that uses thread-unsafe caches can use this to bypass
+ those caches. */
+inline bool isInParallelRegion() {
+#ifdef _OPENMP
+  return omp_in_parallel() != 0;
+#else
+  return false;
+#endif
+}
+
+/** A lock for mutual exclusion between threads. Locking and
+ unlocking does nothing if OpenMP is not enabled. */
+class Mutex {
+ public:
+  Mutex() {
+#ifdef _OPENMP
+    omp_init_lock(&_lock);
+#endif
+  }
+
+  ~Mutex() {
+#ifdef _OPENMP
+    omp_destroy_lock(&_lock);
+#endif
+  }
+
+  void lock() {
+#ifdef _OPENMP
+    omp_set_lock(&_lock);
+#endif
+  }
+
+  void unlock() {
+#ifdef _OPENMP
+    omp_unset_lock(&_lock);
+#endif
+  }
+
+ private:
+  Mutex(const Mutex&); // unavailable
+  void operator=(const Mutex&); // unavailable
+
+#ifdef _OPENMP
+  omp_lock_t _lock;
+#endif
+};
+
+/** Keeps a Mutex locked for as long as this object is alive. */
+class MutexLocker {
+ public:
+  MutexLocker(Mutex& mutex): _mutex(mutex) {_mutex.lock();}
+  ~MutexLocker() {_mutex.unlock();}
+
+ private:
+  MutexLocker(const MutexLocker&); // unavailable
+  void operator=(const MutexLocker&); // unavailable
+
+  Mutex& _mutex;
+};
+
+/** Exceptions must not propagate out of an OpenMP parallel region, so
+ each thread catches its exceptions and records them in a shared
+ object of this class. The exception is then re-thrown on the main
+ thread once the parallel region is done.
+
+ Only the first exception is kept. A bad_alloc is re-thrown as a
+ bad_alloc, a CancelledException as a CancelledException, and
+ Frobby's other exceptions are re-thrown as their base class with the
+ same message. Other exceptions are reported as internal errors. */
+class ParallelExceptionCatcher {
+ public:
+  ParallelExceptionCatcher();
+
+  /** Records the exception currently being handled. Must only be
+   called from inside a catch block. Safe to call from several threads
+   at once. */
+  void catchCurrent();
+
+  /** Returns true if an exception has been recorded. Threads can check
+   this to stop doing work that will be thrown away anyway. */
+  bool hasCaught() const {return _kind != NoException;}
+
+  /** Throws the recorded exception if there is one. */
+  void rethrowIfCaught() const;
+
+ private:
+  enum Kind {
+    NoException,
+    BadAlloc,
+    Cancelled,
+    Frobby,
+    InternalFrobby,
+    Unknown
+  };
+
+  volatile Kind _kind;
+  string _message;
+};
+
+#endif
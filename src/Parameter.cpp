@@ -22,7 +22,8 @@
 Parameter::Parameter(const string& name,
                      const string& description):
   _name(name),
-  _description(description) {
+  _description(description),
+  _wasGiven(false) {
 }
 
 Parameter::~Parameter() {
@@ -38,6 +39,7 @@ void Parameter::processArguments(const char** args, size_t argCount) {
   checkCorrectParameterCount(range.first, range.second, args, argCount);
 
   doProcessArguments(args, argCount);
+  _wasGiven = true;
 }
 
 void Parameter::checkCorrectParameterCount(unsigned int from,
@@ -35,6 +35,10 @@ class Parameter {
 
   void processArguments(const char** args, size_t argCount);
 
+  /** Returns true if the parameter has been given on the command
+   line, even if the value given is the default. */
+  bool wasGiven() const {return _wasGiven;}
+
  private:
   virtual string doGetArgumentType() const = 0;
   virtual string doGetValueAsString() const = 0;
@@ -48,6 +52,7 @@ class Parameter {
 
   string _name;
   string _description;
+  bool _wasGiven;
 };
 
 #endif
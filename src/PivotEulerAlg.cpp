@@ -28,8 +28,12 @@
 #include "PivotStrategy.h"
 #include "Arena.h"
 #include "LocalArray.h"
+#include "TreeTrace.h"
+#include "Cancellation.h"
+#include "ProgressMeter.h"
 
 #include <sstream>
+#include <cmath>
 #include <vector>
 
 namespace Ops = SquareFreeTermOps;
@@ -203,10 +207,12 @@ EulerState* PivotEulerAlg::processState(EulerState& state) {
   while (true) {
 	ASSERT(state.debugIsValid());
 
-	if (baseCaseSimple1(_euler, state))
+	if (baseCaseSimple1(_euler, state)) {
+	  traceNodeKind(TreeTrace::BaseCase);
 	  return 0;
+	}
 
-	state.getIdeal().getVarDividesCounts(_divCountsTmp);
+	state.getVarDividesCounts(_divCountsTmp);
 	size_t* divCountsTmp = &(_divCountsTmp[0]);
 
 	if (_useUniqueDivSimplify &&
@@ -218,8 +224,10 @@ EulerState* PivotEulerAlg::processState(EulerState& state) {
 	if (_useAllPairsSimplify) {
 	  if (optimizeVarPairs(state, _termTmp, divCountsTmp))
 		continue;
-	  if (baseCasePreconditionSimplified(_euler, state))
+	  if (baseCasePreconditionSimplified(_euler, state)) {
+		traceNodeKind(TreeTrace::BaseCase);
 		return 0;
+	  }
 	}
     if (_autoTranspose && autoTranspose(state))
       continue;
@@ -298,14 +306,61 @@ void PivotEulerAlg::computeEuler(EulerState* state) {
   _euler = 0;
   if (_initialAutoTranspose)
     autoTranspose(*state);
-  while (state != 0) {
-	EulerState* nextState = processState(*state);
-	if (nextState == 0) {
-	  nextState = state->getParent();
-	  Arena::getArena().freeAndAllAfter(state);
+
+  // When tracing or measuring progress, depths holds the depth in the
+  // computation tree of state and of each of its ancestors. Every
+  // split has two children, so a random probe reaches a base case at
+  // depth d with probability 2^-d and estimates the size of the tree
+  // as 2^(d + 1) - 1.
+  const bool tracing = TreeTrace::getSingleton().isEnabled();
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+  const bool measuring = meter.attach(this);
+  vector<size_t> depths;
+  if (tracing || measuring)
+    depths.push_back(0);
+  if (measuring)
+    meter.addRoot();
+
+  // The states are freed as they are done and the root state is
+  // freed last. If the computation is stopped by an exception, the
+  // states that are not done are freed by freeing the root state.
+  EulerState* const root = state;
+  Cancellation& cancellation = Cancellation::getSingleton();
+  try {
+	while (state != 0) {
+	  cancellation.check();
+	  EulerState* nextState;
+	  {
+		TraceNode node(TreeTrace::EulerAlgorithm, tracing ? depths.back() : 0,
+					   state->getIdeal().getGeneratorCount(),
+					   state->getVarCount());
+		nextState = processState(*state);
+	  }
+	  if (nextState == 0) {
+		nextState = state->getParent();
+		Arena::getArena().freeAndAllAfter(state);
+		if (measuring) {
+		  const int depth = static_cast<int>(depths.back());
+		  meter.addBaseCase(ldexp(1.0, -depth), ldexp(1.0, depth + 1) - 1);
+		  meter.nodeDone(depths.back(), depths.size() - 1);
+		}
+		if (tracing || measuring)
+		  depths.pop_back();
+	  } else if (tracing || measuring) {
+		// state has been turned into one child and nextState is the other.
+		++depths.back();
+		depths.push_back(depths.back());
+		if (measuring)
+		  meter.nodeDone(depths.back() - 1, depths.size() - 1);
+	  }
+	  state = nextState;
 	}
-	state = nextState;
+  } catch (...) {
+	Arena::getArena().freeAndAllAfter(root);
+	meter.detach(this);
+	throw;
   }
+  meter.detach(this);
 }
 
 bool PivotEulerAlg::autoTranspose(EulerState& state) {
@@ -957,5 +957,6 @@ auto_ptr<PivotStrategy> newStatisticsPivotStrategy
 }
 
 auto_ptr<PivotStrategy> newDefaultPivotStrategy() {
-  return newStdPivotStrategy("pivot");
+  // These are the defaults of the euler action.
+  return newGenPivotStrategy("raremax");
 }
@@ -0,0 +1,243 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "Portfolio.h"
+
+#include "display.h"
+#include "error.h"
+
+// MinGW defines __GNUC__ but does not have fork.
+#if defined(__GNUC__) && !defined(__MINGW32__)
+#define FROBBY_HAS_FORK
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <cerrno>
+#endif
+
+namespace {
+  /** Copies the rest of from to the end of to. */
+  void copyFile(FILE* from, FILE* to) {
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), from)) > 0)
+      fwrite(buffer, 1, size, to);
+    fflush(to);
+  }
+
+  /** The temporary files and the process of an entry. */
+  struct Racer {
+    Racer(): in(0), out(0), err(0), pid(0), running(false) {}
+
+    FILE* in;
+    FILE* out;
+    FILE* err;
+#ifdef FROBBY_HAS_FORK
+    pid_t pid;
+#else
+    int pid;
+#endif
+    bool running;
+  };
+
+  /** Kills the processes that are still running. */
+  void stopRacers(vector<Racer>& racers) {
+#ifdef FROBBY_HAS_FORK
+    for (size_t i = 0; i < racers.size(); ++i) {
+      if (racers[i].running) {
+        kill(racers[i].pid, SIGKILL);
+        waitpid(racers[i].pid, 0, 0);
+        racers[i].running = false;
+      }
+    }
+#endif
+  }
+
+#ifdef FROBBY_HAS_FORK
+  /** Checks whether the process of racer has ended without waiting
+   for it. Returns false if it is still running. Otherwise sets
+   racer.running to false and returns true, with succeeded set to
+   whether the process exited with status zero. Only the process of
+   racer is waited for, so this does not collect the exit status of
+   any other child of the calling process. */
+  bool hasEnded(Racer& racer, bool& succeeded) {
+    ASSERT(racer.running);
+    int status;
+    const pid_t pid = waitpid(racer.pid, &status, WNOHANG);
+    if (pid == 0 || (pid == -1 && errno == EINTR))
+      return false;
+    racer.running = false;
+    succeeded = pid == racer.pid &&
+      WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    return true;
+  }
+
+  /** How long to sleep between checks on the racers. */
+  const long PollMilliseconds = 10;
+#endif
+
+  /** Stops the racers and closes the temporary files, which deletes
+   them. */
+  void endRace(vector<Racer>& racers) {
+    stopRacers(racers);
+    for (size_t i = 0; i < racers.size(); ++i) {
+      Racer& racer = racers[i];
+      if (racer.in != 0)
+        fclose(racer.in);
+      if (racer.out != 0)
+        fclose(racer.out);
+      if (racer.err != 0)
+        fclose(racer.err);
+      racer.in = racer.out = racer.err = 0;
+    }
+  }
+}
+
+Portfolio::Portfolio(const vector<string>& entries):
+  _entries(entries) {
+}
+
+Portfolio::~Portfolio() {
+}
+
+size_t Portfolio::race(FILE* in, FILE* out, FILE* err) {
+  if (_entries.empty())
+    reportError("The portfolio must have at least one entry.");
+
+#ifdef FROBBY_HAS_FORK
+  string input;
+  {
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0)
+      input.append(buffer, size);
+  }
+
+  vector<Racer> racers(_entries.size());
+  for (size_t i = 0; i < racers.size(); ++i) {
+    Racer& racer = racers[i];
+    racer.in = tmpfile();
+    racer.out = tmpfile();
+    racer.err = tmpfile();
+    if (racer.in == 0 || racer.out == 0 || racer.err == 0) {
+      endRace(racers);
+      reportError("Could not create temporary files for the portfolio.");
+    }
+    fwrite(input.data(), 1, input.size(), racer.in);
+    rewind(racer.in);
+  }
+
+  // Buffered output would otherwise be written by each process too.
+  fflush(0);
+
+  for (size_t i = 0; i < racers.size(); ++i) {
+    Racer& racer = racers[i];
+    racer.pid = fork();
+    if (racer.pid == 0)
+      runChild(_entries[i], racer.in, racer.out, racer.err);
+    if (racer.pid == -1) {
+      endRace(racers);
+      reportError("Could not start a process for the portfolio.");
+    }
+    racer.running = true;
+  }
+
+  size_t winner = racers.size();
+  size_t lastFailed = racers.size();
+  size_t running = racers.size();
+  while (true) {
+    for (size_t i = 0; i < racers.size() && winner == racers.size(); ++i) {
+      bool succeeded;
+      if (!racers[i].running || !hasEnded(racers[i], succeeded))
+        continue;
+      --running;
+      if (succeeded)
+        winner = i;
+      else
+        lastFailed = i;
+    }
+    if (winner != racers.size() || running == 0)
+      break;
+
+    timespec pause;
+    pause.tv_sec = 0;
+    pause.tv_nsec = PollMilliseconds * 1000 * 1000;
+    nanosleep(&pause, 0);
+  }
+
+  if (winner == racers.size()) {
+    if (lastFailed != racers.size()) {
+      rewind(racers[lastFailed].err);
+      copyFile(racers[lastFailed].err, err);
+    }
+    endRace(racers);
+    reportError("Every entry of the portfolio failed.");
+  }
+
+  // Stop the others before copying so they do not compete for time.
+  stopRacers(racers);
+
+  rewind(racers[winner].err);
+  copyFile(racers[winner].err, err);
+  rewind(racers[winner].out);
+  copyFile(racers[winner].out, out);
+  endRace(racers);
+  return winner;
+#else
+  reportError("Running a portfolio is not supported on this platform.");
+  return 0;
+#endif
+}
+
+void Portfolio::parseEntries(const string& list, vector<string>& entries) {
+  entries.clear();
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    size_t end = list.find(',', begin);
+    if (end == string::npos)
+      end = list.size();
+    if (end > begin)
+      entries.push_back(list.substr(begin, end - begin));
+    begin = end + 1;
+  }
+}
+
+void Portfolio::runChild(const string& entry,
+                         FILE* in, FILE* out, FILE* err) {
+#ifdef FROBBY_HAS_FORK
+  int status = 0;
+  if (dup2(fileno(in), 0) == -1 ||
+      dup2(fileno(out), 1) == -1 ||
+      dup2(fileno(err), 2) == -1)
+    _exit(1);
+  clearerr(stdin);
+
+  try {
+    runEntry(entry);
+  } catch (const std::exception& e) {
+    displayException(e);
+    status = 1;
+  } catch (...) {
+    status = 1;
+  }
+  fflush(0);
+  _exit(status);
+#endif
+}
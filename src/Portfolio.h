@@ -0,0 +1,72 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef PORTFOLIO_GUARD
+#define PORTFOLIO_GUARD
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+/** Runs several algorithms for the same computation at the same time
+ and keeps the result of the one that finishes first.
+
+ Each entry of the portfolio is run by runEntry in a separate process
+ whose standard input is a copy of the input and whose standard output
+ and standard error go to temporary files. Once an entry finishes
+ successfully, the other processes are killed and the output and error
+ of the winner are passed on. The algorithms are run as processes
+ rather than threads since they use global state such as the arena and
+ the profiler, and killing a process cancels it at any point.
+
+ An entry fails if it reports an error. If every entry fails, the
+ error of the last one to fail is passed on and race reports an
+ error. */
+class Portfolio {
+ public:
+  Portfolio(const vector<string>& entries);
+  virtual ~Portfolio();
+
+  /** Runs the entries on the input read from in and writes the output
+   and error of the winner to out and err. Returns the index of the
+   winner. Reports an error if processes are not supported on this
+   platform. Only the processes started by race are waited for, so
+   other child processes of the caller are left alone.
+
+   The entries are forked from the calling process, and a forked child
+   of a process that has other threads may only call async-signal-safe
+   functions. So race must be called before any parallel region has
+   started threads, as is the case when only the input has been read. */
+  size_t race(FILE* in, FILE* out, FILE* err);
+
+  const vector<string>& getEntries() const {return _entries;}
+
+  /** Sets entries to the entries of the comma separated list. */
+  static void parseEntries(const string& list, vector<string>& entries);
+
+ protected:
+  /** Runs the entry with the given name. This is called in the
+   process of the entry with stdin, stdout and stderr redirected. */
+  virtual void runEntry(const string& entry) = 0;
+
+ private:
+  void runChild(const string& entry, FILE* in, FILE* out, FILE* err);
+
+  vector<string> _entries;
+};
+
+#endif
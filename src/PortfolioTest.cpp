@@ -0,0 +1,137 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "Portfolio.h"
+#include "tests.h"
+
+#include "error.h"
+
+// MinGW defines __GNUC__ but does not have fork.
+#if defined(__GNUC__) && !defined(__MINGW32__)
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+TEST_SUITE(Portfolio)
+
+namespace {
+  /** The entry fail reports an error, spin never finishes and echo
+   copies its input to its output. */
+  class TestPortfolio : public Portfolio {
+  public:
+    TestPortfolio(const char* list): Portfolio(parse(list)) {}
+
+  protected:
+    virtual void runEntry(const string& entry) {
+      if (entry == "fail")
+        reportError("fail");
+      if (entry == "spin")
+        for (;;)
+          ;
+      int c;
+      while ((c = getchar()) != EOF)
+        putchar(c);
+      fputs("echo", stderr);
+    }
+
+  private:
+    static vector<string> parse(const char* list) {
+      vector<string> entries;
+      parseEntries(list, entries);
+      return entries;
+    }
+  };
+
+  string readAll(FILE* file) {
+    rewind(file);
+    string str;
+    int c;
+    while ((c = getc(file)) != EOF)
+      str += static_cast<char>(c);
+    return str;
+  }
+
+  /** Races list on the input "input" and returns the index of the
+   winner. Sets out and err to what the winner wrote. */
+  size_t race(const char* list, string& out, string& err) {
+    FILE* inFile = tmpfile();
+    FILE* outFile = tmpfile();
+    FILE* errFile = tmpfile();
+    fputs("input", inFile);
+    rewind(inFile);
+    size_t winner;
+    try {
+      winner = TestPortfolio(list).race(inFile, outFile, errFile);
+    } catch (...) {
+      fclose(inFile);
+      fclose(outFile);
+      fclose(errFile);
+      throw;
+    }
+    out = readAll(outFile);
+    err = readAll(errFile);
+    fclose(inFile);
+    fclose(outFile);
+    fclose(errFile);
+    return winner;
+  }
+}
+
+TEST(Portfolio, ParseEntries) {
+  vector<string> entries;
+  Portfolio::parseEntries("slice,bigatti:median,,deform", entries);
+  ASSERT_EQ(entries.size(), 3u);
+  ASSERT_EQ(entries[0], "slice");
+  ASSERT_EQ(entries[1], "bigatti:median");
+  ASSERT_EQ(entries[2], "deform");
+}
+
+TEST(Portfolio, FirstToFinishWins) {
+  string out;
+  string err;
+  ASSERT_EQ(race("fail,spin,echo", out, err), 2u);
+  ASSERT_EQ(out, "input");
+  ASSERT_EQ(err, "echo");
+}
+
+TEST(Portfolio, AllFail) {
+  string out;
+  string err;
+  ASSERT_EXCEPTION(race("fail,fail", out, err), const FrobbyException&);
+}
+
+#if defined(__GNUC__) && !defined(__MINGW32__)
+TEST(Portfolio, OtherChildrenLeftAlone) {
+  // This child ends before the race, and its exit status must still be
+  // there to collect afterwards.
+  const pid_t other = fork();
+  if (other == 0)
+    _exit(3);
+  ASSERT_TRUE(other != -1);
+
+  string out;
+  string err;
+  ASSERT_EQ(race("fail,echo", out, err), 1u);
+
+  int status;
+  ASSERT_EQ(waitpid(other, &status, 0), other);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 3);
+}
+#endif
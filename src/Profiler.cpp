@@ -0,0 +1,177 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "Profiler.h"
+
+#include "MemoryBlocks.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cctype>
+
+#ifdef __GNUC__ // Only GCC defines this macro.
+#include <sys/resource.h>
+#endif
+
+Profiler::Phase::Phase(const string& nameParam, Phase* parentParam):
+  name(nameParam),
+  parent(parentParam),
+  callCount(0),
+  wallSeconds(0),
+  cpuSeconds(0),
+  peakMemoryUsage(0),
+  clocksAtBegin(0),
+  peakMemoryUsageOfParent(0) {
+}
+
+Profiler::Phase::~Phase() {
+  for (size_t i = 0; i < children.size(); ++i)
+    delete children[i];
+}
+
+Profiler::Profiler():
+  _enabled(false),
+  _root("", 0),
+  _current(&_root) {
+}
+
+Profiler::~Profiler() {
+}
+
+Profiler& Profiler::getSingleton() {
+  static Profiler singleton;
+  return singleton;
+}
+
+void Profiler::beginPhase(const char* nameParam) {
+  if (!_enabled || isInParallelRegion())
+    return;
+
+  // Phases are named by the messages printed for -time, so remove
+  // the punctuation at the end of those.
+  string name(nameParam);
+  while (!name.empty() && (name[name.size() - 1] == '.' ||
+                           isspace(name[name.size() - 1])))
+    name.resize(name.size() - 1);
+
+  Phase* phase = 0;
+  for (size_t i = 0; i < _current->children.size(); ++i) {
+    if (_current->children[i]->name == name) {
+      phase = _current->children[i];
+      break;
+    }
+  }
+  if (phase == 0) {
+    _current->children.reserve(_current->children.size() + 1);
+    phase = new Phase(name, _current);
+    _current->children.push_back(phase);
+  }
+
+  // The peak memory usage of the parent has to include the peak
+  // during this phase, so the peak from before this phase is saved
+  // and combined with the peak during this phase when it ends.
+  phase->peakMemoryUsageOfParent = MemoryBlocks::resetPeakMemoryUsage();
+  phase->wallTimer.reset();
+  phase->clocksAtBegin = clock();
+  _current = phase;
+}
+
+void Profiler::endPhase() {
+  if (!_enabled || isInParallelRegion())
+    return;
+  ASSERT(_current != &_root);
+
+  Phase& phase = *_current;
+  ++phase.callCount;
+  phase.wallSeconds += phase.wallTimer.getSeconds();
+  phase.cpuSeconds +=
+    static_cast<double>(clock() - phase.clocksAtBegin) / CLOCKS_PER_SEC;
+
+  // The peak memory usage of the parent is the larger of the peak
+  // before this phase and the peak during this phase.
+  const size_t peak = MemoryBlocks::getPeakMemoryUsage();
+  phase.peakMemoryUsage = std::max(phase.peakMemoryUsage, peak);
+  MemoryBlocks::raisePeakMemoryUsage(phase.peakMemoryUsageOfParent);
+
+  _current = phase.parent;
+}
+
+void Profiler::endAllPhases() {
+  while (_enabled && _current != &_root)
+    endPhase();
+}
+
+void Profiler::writeJson(FILE* out) const {
+  fprintf(out, "{\n  \"peakResidentBytes\": %lu,\n  \"phases\": ",
+          static_cast<unsigned long>(getPeakResidentBytes()));
+  writeJsonPhases(out, _root, 2);
+  fputs("\n}\n", out);
+}
+
+size_t Profiler::getPeakResidentBytes() {
+#ifdef __GNUC__
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  const size_t maxRss = static_cast<size_t>(usage.ru_maxrss);
+#ifdef __APPLE__
+  return maxRss; // bytes on Mac OS X
+#else
+  return maxRss * 1024; // kilobytes on Linux
+#endif
+#else
+  return 0;
+#endif
+}
+
+void Profiler::writeJsonPhases(FILE* out, const Phase& parent, size_t indent) {
+  const string pad(indent, ' ');
+  fputc('[', out);
+  bool first = true;
+  for (size_t i = 0; i < parent.children.size(); ++i) {
+    const Phase& phase = *parent.children[i];
+    if (phase.callCount == 0)
+      continue; // not ended yet
+
+    if (!first)
+      fputc(',', out);
+    first = false;
+
+    fprintf(out, "\n%s  {\n%s    \"name\": \"", pad.c_str(), pad.c_str());
+    for (size_t c = 0; c < phase.name.size(); ++c) {
+      const char ch = phase.name[c];
+      if (ch == '"' || ch == '\\')
+        fputc('\\', out);
+      if (static_cast<unsigned char>(ch) >= ' ')
+        fputc(ch, out);
+    }
+    fputs("\",\n", out);
+    fprintf(out, "%s    \"calls\": %lu,\n", pad.c_str(), phase.callCount);
+    fprintf(out, "%s    \"wallSeconds\": %.6f,\n",
+            pad.c_str(), phase.wallSeconds);
+    fprintf(out, "%s    \"cpuSeconds\": %.6f,\n",
+            pad.c_str(), phase.cpuSeconds);
+    fprintf(out, "%s    \"peakMemoryBytes\": %lu,\n", pad.c_str(),
+            static_cast<unsigned long>(phase.peakMemoryUsage));
+    fprintf(out, "%s    \"phases\": ", pad.c_str());
+    writeJsonPhases(out, phase, indent + 4);
+    fprintf(out, "\n%s  }", pad.c_str());
+  }
+  if (!first)
+    fprintf(out, "\n%s", pad.c_str());
+  fputc(']', out);
+}
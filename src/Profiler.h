@@ -0,0 +1,120 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef PROFILER_GUARD
+#define PROFILER_GUARD
+
+#include "WallTimer.h"
+#include <ctime>
+#include <vector>
+#include <string>
+
+/** Records the time and memory spent in each phase of a
+ computation. Phases can contain other phases, so the phases form a
+ tree. For each phase the profiler records how many times it was
+ entered and the total wall clock time and CPU time spent in it, as
+ well as the peak memory usage of arenas and buffer pools while it
+ was running. A phase that is entered several times from the same
+ parent phase is recorded once with the sum of the times. The report
+ is written in JSON format.
+
+ The profiler does nothing unless it has been enabled, so phases are
+ cheap to mark when it is not in use. Phases must be begun and ended
+ from the thread that began the computation. Calls from inside a
+ parallel region are ignored. */
+class Profiler {
+ public:
+  /** Returns the profiler for the whole program. */
+  static Profiler& getSingleton();
+
+  void setEnabled(bool enabled) {_enabled = enabled;}
+  bool isEnabled() const {return _enabled;}
+
+  /** Begins a phase with the given name inside the current phase. */
+  void beginPhase(const char* name);
+
+  /** Ends the most recently begun phase that has not been ended. */
+  void endPhase();
+
+  /** Ends every phase that has been begun and not ended. Use this when
+   an exception has skipped the calls to endPhase() of a computation,
+   so that the phases of the computation up to that point are
+   included in the report. */
+  void endAllPhases();
+
+  /** Writes the recorded phases to out in JSON format. Phases that
+   have not been ended yet are not included. The peak resident set
+   size of the process is included as well. */
+  void writeJson(FILE* out) const;
+
+  /** Returns the largest amount of physical memory that the process
+   has used so far in bytes, or zero if this is not known on this
+   platform. This includes all memory, not just arenas and buffer
+   pools. */
+  static size_t getPeakResidentBytes();
+
+ private:
+  Profiler();
+  ~Profiler();
+  Profiler(const Profiler&); // unavailable
+  void operator=(const Profiler&); // unavailable
+
+  struct Phase {
+    Phase(const string& name, Phase* parent);
+    ~Phase();
+
+    string name;
+    Phase* parent;
+    std::vector<Phase*> children;
+
+    unsigned long callCount;
+    double wallSeconds;
+    double cpuSeconds;
+    size_t peakMemoryUsage;
+
+    // State of a call that has been begun but not yet ended.
+    WallTimer wallTimer;
+    std::clock_t clocksAtBegin;
+    size_t peakMemoryUsageOfParent;
+  };
+
+  /** Writes a JSON array of the ended child phases of parent. */
+  static void writeJsonPhases(FILE* out, const Phase& parent, size_t indent);
+
+  bool _enabled;
+  Phase _root; /// the phases are the children of this
+  Phase* _current; /// the phase that new phases are begun inside
+};
+
+/** Marks a phase for the Profiler while an object of this class is
+ alive. */
+class ProfilePhase {
+ public:
+  ProfilePhase(const char* name) {
+    Profiler::getSingleton().beginPhase(name);
+  }
+
+  ~ProfilePhase() {
+    Profiler::getSingleton().endPhase();
+  }
+
+ private:
+  ProfilePhase(const ProfilePhase&); // unavailable
+  void operator=(const ProfilePhase&); // unavailable
+};
+
+#endif
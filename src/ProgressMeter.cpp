@@ -0,0 +1,136 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "ProgressMeter.h"
+
+ProgressReporter::~ProgressReporter() {
+}
+
+ProgressPrinter::ProgressPrinter(FILE* out):
+  _out(out) {
+  ASSERT(out != 0);
+}
+
+void ProgressPrinter::report(const ProgressReport& report) {
+  fprintf(_out, "Progress: %lu nodes, %lu base cases, %lu output terms, "
+          "%lu pending at depth %lu",
+          static_cast<unsigned long>(report.nodeCount),
+          static_cast<unsigned long>(report.baseCaseCount),
+          static_cast<unsigned long>(report.outputTermCount),
+          static_cast<unsigned long>(report.pendingCount),
+          static_cast<unsigned long>(report.depth));
+  if (report.estimatedNodeCount > 0)
+    fprintf(_out, ", about %.1f%% of an estimated %.0f nodes",
+            100 * report.doneFraction, report.estimatedNodeCount);
+  fprintf(_out, " (%.1fs).\n", report.milliseconds / 1000.0);
+  fflush(_out);
+}
+
+ProgressMeter::ProgressMeter():
+  _reporter(0),
+  _interval(0),
+  _nextReport(0),
+  _owner(0),
+  _nodeCount(0),
+  _baseCaseCount(0),
+  _outputTermCount(0),
+  _pendingCount(0),
+  _depth(0),
+  _rootWeight(0),
+  _baseCaseWeight(0),
+  _weightedEstimates(0) {
+}
+
+ProgressMeter& ProgressMeter::getSingleton() {
+  static ProgressMeter singleton;
+  return singleton;
+}
+
+void ProgressMeter::setReporter(ProgressReporter* reporter,
+                                unsigned long interval) {
+  _reporter = reporter;
+  _interval = interval;
+  _nextReport = _timer.getMilliseconds() + interval;
+}
+
+bool ProgressMeter::attach(const void* owner) {
+  ASSERT(owner != 0);
+  if (!isEnabled() || _owner != 0)
+    return false;
+  _owner = owner;
+
+  _nodeCount = 0;
+  _baseCaseCount = 0;
+  _outputTermCount = 0;
+  _pendingCount = 0;
+  _depth = 0;
+  _rootWeight = 0;
+  _baseCaseWeight = 0;
+  _weightedEstimates = 0;
+
+  _timer.reset();
+  _nextReport = _interval;
+  return true;
+}
+
+void ProgressMeter::detach(const void* owner) {
+  if (_owner == owner)
+    _owner = 0;
+}
+
+void ProgressMeter::addBaseCase(double probability, double estimate) {
+  ++_baseCaseCount;
+  // A probability can underflow to zero on a deep path. Such a base
+  // case has no weight anyway.
+  if (probability > 0) {
+    _baseCaseWeight += probability;
+    _weightedEstimates += probability * estimate;
+  }
+}
+
+void ProgressMeter::getReport(ProgressReport& report) const {
+  report.milliseconds = _timer.getMilliseconds();
+  report.nodeCount = _nodeCount;
+  report.baseCaseCount = _baseCaseCount;
+  report.outputTermCount = _outputTermCount;
+  report.pendingCount = _pendingCount;
+  report.depth = _depth;
+  if (_baseCaseWeight > 0 && _rootWeight > 0) {
+    report.doneFraction = _baseCaseWeight / _rootWeight;
+    if (report.doneFraction > 1)
+      report.doneFraction = 1; // due to rounding
+    report.estimatedNodeCount =
+      (_weightedEstimates / _baseCaseWeight) * _rootWeight;
+  } else {
+    report.doneFraction = 0;
+    report.estimatedNodeCount = 0;
+  }
+}
+
+void ProgressMeter::reportIfDue() {
+  if (_reporter == 0 || _owner == 0)
+    return;
+  const unsigned long now = _timer.getMilliseconds();
+  if (now < _nextReport)
+    return;
+  _nextReport = now + _interval;
+
+  ProgressReport report;
+  getReport(report);
+  _reporter->report(report);
+}
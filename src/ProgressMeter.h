@@ -0,0 +1,174 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef PROGRESS_METER_GUARD
+#define PROGRESS_METER_GUARD
+
+#include "WallTimer.h"
+#include <cstdio>
+
+/** A snapshot of how far the computation tree of an algorithm has
+ got. */
+struct ProgressReport {
+  /** The wall clock milliseconds since the tree was begun. */
+  unsigned long milliseconds;
+
+  /** The number of nodes of the tree that have been processed. */
+  size_t nodeCount;
+
+  /** The number of processed nodes that had no children. */
+  size_t baseCaseCount;
+
+  /** The number of terms that have been output. */
+  size_t outputTermCount;
+
+  /** The number of nodes that are waiting to be processed. */
+  size_t pendingCount;
+
+  /** The depth of the most recently processed node. */
+  size_t depth;
+
+  /** The estimated fraction of the tree that has been processed, or
+   zero if no base case has been reached yet. */
+  double doneFraction;
+
+  /** The estimated number of nodes of the whole tree, or zero if no
+   base case has been reached yet. */
+  double estimatedNodeCount;
+};
+
+/** Receives the reports of the ProgressMeter. */
+class ProgressReporter {
+ public:
+  virtual ~ProgressReporter();
+
+  virtual void report(const ProgressReport& report) = 0;
+};
+
+/** Writes each report as a line of text to a file. */
+class ProgressPrinter : public ProgressReporter {
+ public:
+  ProgressPrinter(FILE* out);
+
+  virtual void report(const ProgressReport& report);
+
+ private:
+  FILE* _out;
+};
+
+/** Measures how far the computation tree of the running algorithm has
+ got and reports this periodically. The Slice Algorithm and the
+ algorithm of Bigatti et.al. are measured through their TaskEngine,
+ where each task is a node, and the Euler characteristic algorithm
+ measures its own states.
+
+ Only one tree is measured at a time. An algorithm attaches to the
+ meter before it begins, and that fails if another algorithm is
+ already attached. So an algorithm that runs another algorithm for its
+ base cases is measured by its own tree only.
+
+ The size of the tree is estimated by Knuth's random probe estimator.
+ A random probe walks from the root to a base case choosing a child
+ uniformly at random at each node, and the estimate from the probe is
+ the sum over the nodes on the path of the product of the numbers of
+ children of the nodes above it. The tree is processed depth first
+ rather than by random probes, so the estimates of the base cases
+ that have been reached are averaged with each weighted by the
+ probability that a probe reaches it. This is the weighted backtrack
+ estimator of Kilby et.al. It needs no work beyond the computation
+ itself, it is biased towards the part of the tree done first and it
+ is exact once the tree is done. The done fraction is the total
+ probability of the base cases that have been reached.
+
+ The meter does nothing unless a reporter has been set. */
+class ProgressMeter {
+ public:
+  /** Returns the progress meter for the whole program. */
+  static ProgressMeter& getSingleton();
+
+  /** Passes a report to reporter every interval wall clock
+   milliseconds while a tree is being measured. A null reporter turns
+   the meter off. The meter does not take over ownership of
+   reporter. */
+  void setReporter(ProgressReporter* reporter, unsigned long interval);
+
+  bool isEnabled() const {return _reporter != 0;}
+
+  /** Begins measuring the tree of owner and resets the counts. Returns
+   false without doing anything if the meter is off or if another tree
+   is being measured. */
+  bool attach(const void* owner);
+
+  /** Ends measuring the tree of owner. Does nothing if owner is not
+   attached. */
+  void detach(const void* owner);
+
+  /** Records a root of the tree. A tree can have several roots. */
+  void addRoot() {_rootWeight += 1;}
+
+  /** Records that a node at the given depth has been processed and
+   that pendingCount nodes are waiting, and reports if that is due. */
+  void nodeDone(size_t depth, size_t pendingCount) {
+    _depth = depth;
+    _pendingCount = pendingCount;
+    if (++_nodeCount % WallTimer::StepsPerReading == 0)
+      reportIfDue();
+  }
+
+  /** Records a base case that a random probe from its root reaches
+   with the given probability, where Knuth's estimator gives the
+   estimate as the size of the tree. */
+  void addBaseCase(double probability, double estimate);
+
+  /** Records that count terms have been output. */
+  void addOutputTerms(size_t count) {_outputTermCount += count;}
+
+  /** Stores a report on the tree being measured into report. */
+  void getReport(ProgressReport& report) const;
+
+ private:
+  ProgressMeter();
+  ProgressMeter(const ProgressMeter&); // unavailable
+  void operator=(const ProgressMeter&); // unavailable
+
+  void reportIfDue();
+
+  ProgressReporter* _reporter;
+  unsigned long _interval;
+  unsigned long _nextReport; /// milliseconds on _timer
+  const void* _owner;
+  WallTimer _timer;
+
+  size_t _nodeCount;
+  size_t _baseCaseCount;
+  size_t _outputTermCount;
+  size_t _pendingCount;
+  size_t _depth;
+
+  /** The number of roots, which is the total probability of the base
+   cases of the whole tree. */
+  double _rootWeight;
+
+  /** The total probability of the base cases reached. */
+  double _baseCaseWeight;
+
+  /** The sum of the estimates of the base cases reached, each weighted
+   by its probability. */
+  double _weightedEstimates;
+};
+
+#endif
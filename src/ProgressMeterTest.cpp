@@ -0,0 +1,218 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "ProgressMeter.h"
+#include "tests.h"
+
+#include "TaskEngine.h"
+#include "Task.h"
+#include <cmath>
+
+TEST_SUITE(ProgressMeter)
+
+namespace {
+  /** Records the reports it is given. */
+  class RecordingReporter : public ProgressReporter {
+  public:
+    virtual void report(const ProgressReport& report) {
+      _reports.push_back(report);
+    }
+
+    const vector<ProgressReport>& getReports() const {return _reports;}
+
+  private:
+    vector<ProgressReport> _reports;
+  };
+
+  /** Sets the reporter of the meter while alive and turns the meter
+   off afterwards, so that tests do not leave it on for the rest of
+   the program. */
+  class EnableMeter {
+  public:
+    EnableMeter(ProgressReporter* reporter) {
+      ProgressMeter::getSingleton().setReporter(reporter, 0);
+    }
+
+    ~EnableMeter() {
+      ProgressMeter::getSingleton().setReporter(0, 0);
+    }
+  };
+
+  /** A task that is not a node of the tree, like the task that
+   gathers the results of an independence split. */
+  class GatherTask : public Task {
+  public:
+    virtual void run(TaskEngine&) {
+      delete this;
+    }
+
+    virtual void dispose() {
+      delete this;
+    }
+
+    virtual bool isTreeNode() const {
+      return false;
+    }
+  };
+
+  /** A task with value n adds tasks with values n - 1 and n - 2 if n
+   is at least 2, and before them a GatherTask if gather is true. The
+   tree of a task with value 7 has 41 nodes of which 21 are base
+   cases. The tree is uneven, so the random probes of Knuth's
+   estimator give different estimates. */
+  class FibonacciTask : public Task {
+  public:
+    FibonacciTask(size_t n, bool gather = false): _n(n), _gather(gather) {}
+
+    virtual void run(TaskEngine& engine) {
+      if (_n >= 2) {
+        if (_gather)
+          engine.addTask(new GatherTask());
+        engine.addTask(new FibonacciTask(_n - 1, _gather));
+        engine.addTask(new FibonacciTask(_n - 2, _gather));
+      }
+      delete this;
+    }
+
+    virtual void dispose() {
+      delete this;
+    }
+
+  private:
+    size_t _n;
+    bool _gather;
+  };
+
+  bool isClose(double a, double b) {
+    return fabs(a - b) < 1e-9 * (fabs(a) + fabs(b) + 1);
+  }
+}
+
+TEST(ProgressMeter, OffByDefault) {
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+  ASSERT_FALSE(meter.isEnabled());
+  int owner;
+  ASSERT_FALSE(meter.attach(&owner));
+}
+
+TEST(ProgressMeter, OneOwner) {
+  RecordingReporter reporter;
+  EnableMeter enable(&reporter);
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+  int a;
+  int b;
+  ASSERT_TRUE(meter.attach(&a));
+  ASSERT_FALSE(meter.attach(&b));
+  meter.detach(&b);
+  ASSERT_FALSE(meter.attach(&b));
+  meter.detach(&a);
+  ASSERT_TRUE(meter.attach(&b));
+  meter.detach(&b);
+}
+
+TEST(ProgressMeter, EstimateExactWhenDone) {
+  RecordingReporter reporter;
+  EnableMeter enable(&reporter);
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+
+  TaskEngine engine;
+  engine.addTask(new FibonacciTask(7));
+  engine.runTasks();
+
+  ProgressReport report;
+  meter.getReport(report);
+  ASSERT_EQ(report.nodeCount, 41u);
+  ASSERT_EQ(report.baseCaseCount, 21u);
+  ASSERT_EQ(report.pendingCount, 0u);
+  ASSERT_TRUE(isClose(report.doneFraction, 1));
+  ASSERT_TRUE(isClose(report.estimatedNodeCount, 41));
+}
+
+TEST(ProgressMeter, SeveralRoots) {
+  RecordingReporter reporter;
+  EnableMeter enable(&reporter);
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+
+  TaskEngine engine;
+  engine.addTask(new FibonacciTask(7));
+  engine.addTask(new FibonacciTask(2));
+  engine.runTasks();
+
+  ProgressReport report;
+  meter.getReport(report);
+  ASSERT_EQ(report.nodeCount, 44u);
+  ASSERT_TRUE(isClose(report.doneFraction, 1));
+  ASSERT_TRUE(isClose(report.estimatedNodeCount, 44));
+}
+
+TEST(ProgressMeter, NonTreeTasksLeftOut) {
+  RecordingReporter reporter;
+  EnableMeter enable(&reporter);
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+
+  TaskEngine engine;
+  engine.addTask(new FibonacciTask(7, true));
+  engine.runTasks();
+
+  ProgressReport report;
+  meter.getReport(report);
+  ASSERT_EQ(report.nodeCount, 41u);
+  ASSERT_EQ(report.baseCaseCount, 21u);
+  ASSERT_TRUE(isClose(report.doneFraction, 1));
+  ASSERT_TRUE(isClose(report.estimatedNodeCount, 41));
+}
+
+TEST(ProgressMeter, RunPendingTask) {
+  RecordingReporter reporter;
+  EnableMeter enable(&reporter);
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+
+  // Running a task out of order keeps it where it is in the tree.
+  TaskEngine engine;
+  engine.addTask(new FibonacciTask(7));
+  engine.addTask(new FibonacciTask(2));
+  engine.runPendingTask(0);
+  engine.runTasks();
+
+  ProgressReport report;
+  meter.getReport(report);
+  ASSERT_EQ(report.nodeCount, 44u);
+  ASSERT_TRUE(isClose(report.doneFraction, 1));
+  ASSERT_TRUE(isClose(report.estimatedNodeCount, 44));
+}
+
+TEST(ProgressMeter, Reports) {
+  RecordingReporter reporter;
+  EnableMeter enable(&reporter);
+
+  TaskEngine engine;
+  engine.addTask(new FibonacciTask(12));
+  engine.runTasks();
+
+  // The tree has 465 nodes and with an interval of zero there is a
+  // report every 16 nodes.
+  const vector<ProgressReport>& reports = reporter.getReports();
+  ASSERT_EQ(reports.size(), 465u / 16u);
+  for (size_t i = 0; i < reports.size(); ++i) {
+    ASSERT_EQ(reports[i].nodeCount, 16 * (i + 1));
+    ASSERT_TRUE(reports[i].doneFraction > 0);
+    ASSERT_TRUE(reports[i].doneFraction < 1);
+    if (i > 0)
+      ASSERT_TRUE(reports[i - 1].doneFraction < reports[i].doneFraction);
+  }
+}
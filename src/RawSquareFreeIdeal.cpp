@@ -19,6 +19,7 @@
 #include "RawSquareFreeIdeal.h"
 
 #include "Arena.h"
+#include "LocalArray.h"
 #include "Ideal.h"
 #include "RawSquareFreeTerm.h"
 #include "BigIdeal.h"
@@ -62,12 +63,13 @@ namespace {
 	}
   }
 
-  /** Removes those elements of [begin, end) that are not minimal. The
-   result is in the sub-range [begin, newEnd) where newEnd is the
-   returned value. @todo: use sort */
-   RSFIdeal::iterator minimize(RSFIdeal::iterator begin,
-							  RSFIdeal::iterator end,
-							  const size_t wordCount) {
+  /** Removes those elements of [begin, end) that are not minimal by
+   checking each pair of elements. The result is in the sub-range
+   [begin, newEnd) where newEnd is the returned value. This is faster
+   than minimize for small ranges. */
+  RSFIdeal::iterator minimizeAllPairs(RSFIdeal::iterator begin,
+									  RSFIdeal::iterator end,
+									  const size_t wordCount) {
 	for (RSFIdeal::iterator it = begin; it != end;) {
 	  for (RSFIdeal::const_iterator div = begin; div != end; ++div) {
 		if (Ops::divides(*div, *div + wordCount, *it) && div != it) {
@@ -81,6 +83,145 @@ namespace {
 	}
 	return end;
   }
+
+  /** Ranges with fewer elements than this are minimized by
+	  minimizeAllPairs. */
+  const size_t SortMinimizeThreshold = 64;
+
+  /** Returns true if an element of the range starting at begin whose
+	  index is in [kept, keptEnd) divides term. */
+  bool hasDivisor(const Word* term,
+				  RSFIdeal::const_iterator begin,
+				  const size_t* kept,
+				  const size_t* keptEnd,
+				  const size_t wordCount) {
+	for (; kept != keptEnd; ++kept) {
+	  const Word* div = *(begin + *kept);
+	  if (Ops::divides(div, div + wordCount, term))
+		return true;
+	}
+	return false;
+  }
+
+  /** Records term as element number index of blocks. The elements are
+	  stored in blocks of BitsPerWord elements, where bit k of word var
+	  of block b is set if var divides element b * BitsPerWord + k. */
+  void addToBlocks(const Word* term,
+				   Word* blocks,
+				   const size_t index,
+				   const size_t varCount) {
+	// This loop and the one in hasDivisorInBlocks are written without
+	// branches since the branches would be unpredictable.
+	Word* block = blocks + (index / BitsPerWord) * varCount;
+	const size_t bit = index % BitsPerWord;
+	for (size_t var = 0; var < varCount; ++var)
+	  block[var] |= static_cast<Word>(Ops::getExponent(term, var)) << bit;
+  }
+
+  /** Returns true if one of the first count elements of blocks divides
+	  term. outside is scratch space for varCount entries. */
+  bool hasDivisorInBlocks(const Word* term,
+						  const Word* blocks,
+						  const size_t count,
+						  size_t* outside,
+						  const size_t varCount) {
+	size_t* outsideEnd = outside;
+	for (size_t var = 0; var < varCount; ++var) {
+	  *outsideEnd = var;
+	  outsideEnd += !Ops::getExponent(term, var);
+	}
+
+	// An element divides term if no variable outside the support of
+	// term divides it. Usually only a few variables have to be looked
+	// at before every element of a block has been ruled out.
+	const Word* block = blocks;
+	for (size_t first = 0; first < count;
+		 first += BitsPerWord, block += varCount) {
+	  Word candidates = ~static_cast<Word>(0);
+	  if (count - first < BitsPerWord)
+		candidates = (static_cast<Word>(1) << (count - first)) - 1;
+	  for (const size_t* var = outside; var != outsideEnd; ++var)
+		if ((candidates &= ~block[*var]) == 0)
+		  break;
+	  if (candidates != 0)
+		return true;
+	}
+	return false;
+  }
+
+  /** Removes those elements of [begin, end) that are not minimal. The
+   result is in the sub-range [begin, newEnd) where newEnd is the
+   returned value. The elements that are kept retain their relative
+   order.
+
+   The elements are considered in order of increasing support, so an
+   element can only be divided by an element that has already been
+   kept. Once there are more kept elements than variables, the kept
+   elements are also stored as bit columns, which allows checking
+   BitsPerWord kept elements for divisibility at a time. */
+  RSFIdeal::iterator minimize(RSFIdeal::iterator begin,
+							  RSFIdeal::iterator end,
+							  const size_t varCount,
+							  const size_t wordCount) {
+	const size_t genCount = end - begin;
+	if (genCount < SortMinimizeThreshold)
+	  return minimizeAllPairs(begin, end, wordCount);
+
+	// Sort the elements by support using counting sort. Equal elements
+	// have the same support, so only the first of those is kept.
+	LocalArray<size_t> order(genCount);
+	{
+	  LocalArray<size_t> support(genCount);
+	  LocalArray<size_t> offsets(varCount + 2);
+	  for (size_t gen = 0; gen < genCount; ++gen) {
+		support[gen] = Ops::getSizeOfSupport(*(begin + gen), varCount);
+		++offsets[support[gen] + 1];
+	  }
+	  for (size_t supp = 1; supp < varCount + 2; ++supp)
+		offsets[supp] += offsets[supp - 1];
+	  for (size_t gen = 0; gen < genCount; ++gen)
+		order[offsets[support[gen]]++] = gen;
+	}
+
+	const size_t blockCount = (genCount - 1) / BitsPerWord + 1;
+	LocalArray<Word> isKept(blockCount);
+	LocalArray<size_t> kept(genCount);
+	LocalArray<Word> blocks(genCount > varCount ? blockCount * varCount : 0);
+	LocalArray<size_t> outside(varCount);
+	size_t keptCount = 0;
+	size_t blockedCount = 0;
+	for (size_t i = 0; i < genCount; ++i) {
+	  const size_t gen = order[i];
+	  const Word* term = *(begin + gen);
+	  if (keptCount <= varCount) {
+		if (hasDivisor(term, begin, kept.begin(), kept.begin() + keptCount,
+					   wordCount))
+		  continue;
+	  } else {
+		for (; blockedCount < keptCount; ++blockedCount)
+		  addToBlocks(*(begin + kept[blockedCount]), blocks.begin(),
+					  blockedCount, varCount);
+		if (hasDivisorInBlocks(term, blocks.begin(), keptCount,
+							   outside.begin(), varCount))
+		  continue;
+	  }
+
+	  isKept[gen / BitsPerWord] |= static_cast<Word>(1) << (gen % BitsPerWord);
+	  kept[keptCount] = gen;
+	  ++keptCount;
+	}
+
+	RSFIdeal::iterator newEnd = begin;
+	for (size_t gen = 0; gen < genCount; ++gen) {
+	  const Word bit = static_cast<Word>(1) << (gen % BitsPerWord);
+	  if ((isKept[gen / BitsPerWord] & bit) == 0)
+		continue;
+	  if (*newEnd != *(begin + gen))
+		Ops::assign(*newEnd, *newEnd + wordCount, *(begin + gen));
+	  ++newEnd;
+	}
+	return newEnd;
+  }
 }
 
 RSFIdeal* RSFIdeal::construct(void* buffer, size_t varCount) {
@@ -240,7 +381,8 @@ bool RSFIdeal::insert(const std::vector<std::string>& term) {
 }
 
 void RSFIdeal::minimize() {
-  iterator newEnd = ::minimize(begin(), end(), getWordsPerTerm());
+  iterator newEnd =
+	::minimize(begin(), end(), getVarCount(), getWordsPerTerm());
   _genCount = newEnd - begin();
   _memoryEnd = *newEnd;
   ASSERT(isValid());
@@ -364,14 +506,18 @@ static inline void countVarDividesBlockUpTo15(const Word* it,
 }
 
 void RSFIdeal::getVarDividesCounts(vector<size_t>& divCounts) const {
-  const size_t varCount = getVarCount();
-  const size_t wordCount = getWordsPerTerm();
   // We reserve BitsPerWord extra space. Otherwise we would have to
   // make sure not to index past the end of the vector of counts when
   // dealing with variables in the unused part of the last word.
   divCounts.reserve(getVarCount() + BitsPerWord);
   divCounts.resize(getVarCount());
-  size_t* divCountsBasePtr = &(divCounts.front());
+  if (!divCounts.empty())
+	getVarDividesCounts(&(divCounts.front()));
+}
+
+void RSFIdeal::getVarDividesCounts(size_t* divCountsBasePtr) const {
+  const size_t varCount = getVarCount();
+  const size_t wordCount = getWordsPerTerm();
   size_t* divCountsEnd = divCountsBasePtr + BitsPerWord * wordCount;
   memset(divCountsBasePtr, 0, sizeof(size_t) * varCount);
 
@@ -693,7 +839,7 @@ void RSFIdeal::colonReminimize(const Word* by) {
   // var is not relatively prime to [start, middle) and is relatively
   // prime to [middle, end).
 
-  iterator newMiddle = ::minimize(start, middle, getWordsPerTerm());
+  iterator newMiddle = ::minimize(start, middle, varCount, wordCount);
 
   iterator newEnd = newMiddle;
   for (iterator it = middle; it != stop; ++it) {
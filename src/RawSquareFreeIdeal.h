@@ -156,6 +156,11 @@ class RawSquareFreeIdeal {
   /** Sets counts[var] to the number of generators that var divides. */
   void getVarDividesCounts(vector<size_t>& counts) const;
 
+  /** As getVarDividesCounts above. counts must have space for
+	  getWordsPerTerm() * BitsPerWord entries, and the entries after
+	  getVarCount() are overwritten. */
+  void getVarDividesCounts(size_t* counts) const;
+
   /** Returns the index of the first generator that var divides or
 	  getGeneratorCount() if no such generator exists. */
   size_t getMultiple(size_t var) const;
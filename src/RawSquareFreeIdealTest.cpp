@@ -181,6 +181,51 @@ TEST(RawSquareFreeIdeal, MinimizeAndMinimizable) {
 	 "0001\n");
 }
 
+namespace {
+  /** Returns a generator on varCount variables with the given support
+	  for use with newRawSquareFreeIdealParse. */
+  string makeGen(size_t varCount, size_t a, size_t b, size_t c) {
+	string gen(varCount, '0');
+	if (a < varCount)
+	  gen[a] = '1';
+	if (b < varCount)
+	  gen[b] = '1';
+	if (c < varCount)
+	  gen[c] = '1';
+	return gen + '\n';
+  }
+}
+
+TEST(RawSquareFreeIdeal, MinimizeMany) {
+  // There are enough generators that minimize does not check every
+  // pair of generators.
+  const size_t varCount = 70;
+  const size_t none = varCount;
+  string edges;
+  string gens;
+  for (size_t var = 0; var < varCount; ++var) {
+	const size_t next = (var + 1) % varCount;
+	edges += makeGen(varCount, var, next, none);
+	gens += makeGen(varCount, var, next, (var + 2) % varCount);
+	gens += makeGen(varCount, var, next, none);
+  }
+  gens += edges + string(varCount, '1') + '\n';
+  TEST_MINIMIZE(gens.c_str(), edges.c_str());
+
+  string minGens;
+  for (size_t var = 0; var < varCount; ++var) {
+	if (var % 3 == 0) {
+	  gens += makeGen(varCount, var, none, none);
+	  minGens += makeGen(varCount, var, none, none);
+	} else if (var % 3 == 1 && var + 1 < varCount)
+	  minGens += makeGen(varCount, var, var + 1, none);
+  }
+  TEST_MINIMIZE(gens.c_str(), minGens.c_str());
+
+  gens += string(varCount, '0') + '\n';
+  TEST_MINIMIZE(gens.c_str(), (string(varCount, '0') + '\n').c_str());
+}
+
 #define TEST_COLON_REMINIMIZE_TERM(idealStr, colonStr, minimizedStr) {	\
 	RSFIdeal* ideal = newRawSquareFreeIdealParse(idealStr);				\
 	Word* colon = newTermParse(colonStr);								\
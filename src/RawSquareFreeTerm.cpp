@@ -22,6 +22,24 @@
 #include <vector>
 
 namespace SquareFreeTermOps {
+  namespace {
+	/** Returns the index of the lowest set bit of word, which must not
+	 be zero. */
+	inline size_t getLowestBit(Word word) {
+	  ASSERT(word != 0);
+#ifdef __GNUC__
+	  return static_cast<size_t>(__builtin_ctzl(word));
+#else
+	  size_t bit = 0;
+	  while ((word & 1) == 0) {
+		word >>= 1;
+		++bit;
+	  }
+	  return bit;
+#endif
+	}
+  }
+
   Word* newTermParse(const char* strParam) {
 	string str(strParam);
 	Word* term = newTerm(str.size());
@@ -73,13 +91,9 @@ namespace SquareFreeTermOps {
 	  return 0;
 	size_t count = 0;
 	while (true) {
-	  Word word = *a;
-	  // TODO: should be able to improve this set bit counting algorithm.
-	  while (word != 0) {
-		if ((word & 1) != 0)
-		  ++count;
-		word >>= 1;
-	  }
+	  // Each iteration clears the lowest set bit of word.
+	  for (Word word = *a; word != 0; word &= word - 1)
+		++count;
 
 	  if (varCount <= BitsPerWord)
 		return count;
@@ -357,13 +371,9 @@ namespace SquareFreeTermOps {
 	if (varCount == 0)
 	  return;
 	while (true) {
-	  Word word = *a;
-	  size_t* intraWordInc = inc;
-	  while (word != 0) {
-		*intraWordInc -= word & 1; // -1 if bit set
-		++intraWordInc;
-		word = word >> 1;
-	  }
+	  // word & (word - 1) clears the lowest set bit.
+	  for (Word word = *a; word != 0; word &= word - 1)
+		--inc[getLowestBit(word)];
 	  if (varCount <= BitsPerWord)
 		return;
 	  varCount -= BitsPerWord;
@@ -377,14 +387,8 @@ namespace SquareFreeTermOps {
 	if (varCount == 0)
 	  return;
 	while (true) {
-	  Word word = *a;
-	  size_t* intraWordInc = inc;
-	  while (word != 0) {
-		if (word & 1)
-		  *intraWordInc = 0;
-		++intraWordInc;
-		word = word >> 1;
-	  }
+	  for (Word word = *a; word != 0; word &= word - 1)
+		inc[getLowestBit(word)] = 0;
 	  if (varCount <= BitsPerWord)
 		return;
 	  varCount -= BitsPerWord;
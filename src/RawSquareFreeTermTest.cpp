@@ -466,6 +466,40 @@ TEST(RawSquareFreeTerm, IncrementAtSupport) {
   }
 }
 */
+TEST(RawSquareFreeTerm, DecrementAndZeroAtSupport) {
+  const size_t maxVarCount = 2 * BitsPerWord + 1;
+  for (size_t varCount = 0; varCount <= maxVarCount; ++varCount) {
+	Word* even = newTerm(varCount);
+	Word* third = newTerm(varCount);
+
+	vector<size_t> counts(varCount + BitsPerWord, 5);
+	vector<size_t> countsCorrect(varCount + BitsPerWord, 5);
+	size_t* countsPtr = &counts.front();
+
+	decrementAtSupport(even, countsPtr, varCount);
+	toZeroAtSupport(even, countsPtr, varCount);
+	ASSERT_TRUE_SILENT(counts == countsCorrect);
+
+	for (size_t var = 0; var < varCount; ++var) {
+	  if (var % 2 == 0) {
+		setExponent(even, var, 1);
+		countsCorrect[var] -= 1;
+	  }
+	  if (var % 3 == 0) {
+		setExponent(third, var, 1);
+		countsCorrect[var] = 0;
+	  }
+	}
+
+	decrementAtSupport(even, countsPtr, varCount);
+	toZeroAtSupport(third, countsPtr, varCount);
+	ASSERT_TRUE(counts == countsCorrect);
+
+	deleteTerm(even);
+	deleteTerm(third);
+  }
+}
+
 TEST(RawSquareFreeTerm, IsValid) {
   const size_t varCount = 2 * BitsPerWord;
   Word* a = newTerm(varCount);
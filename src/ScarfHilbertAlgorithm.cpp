@@ -27,23 +27,24 @@
 #include "ScarfParams.h"
 #include "IdealTree.h"
 #include "IdealOrderer.h"
+#include "Parallel.h"
+#include "Cancellation.h"
+#include "ElementDeleter.h"
 
 class UndeformConsumer : public CoefTermConsumer {
 public:
-  UndeformConsumer(Ideal& toDeform,
+  UndeformConsumer(const Deformer& deformer,
                    const TermTranslator& translator,
                    CoefBigTermConsumer& consumer,
-                   const IdealOrderer& order,
                    bool univar,
-                   bool canonical,
-                   bool doStrongDeformation):
+                   bool canonical):
     _univar(univar),
-    _tmp(toDeform.getVarCount()),
-    _deformer(toDeform, order, doStrongDeformation),
+    _tmp(translator.getVarCount()),
+    _deformer(deformer),
     _translator(translator),
     _canonical(canonical),
     _consumer(consumer),
-    _poly(toDeform.getVarCount()) {
+    _poly(translator.getVarCount()) {
   }
 
   virtual void consumeRing(const VarNames& names) {
@@ -70,6 +71,16 @@ public:
       _poly.add(coef, _tmp);
   }
 
+  /** Adds the polynomial accumulated by consumer to the polynomial
+   accumulated by this object. */
+  void add(const UndeformConsumer& consumer) {
+    ASSERT(_univar == consumer._univar);
+    if (_univar)
+      _uniPoly.add(consumer._uniPoly);
+    else
+      _poly.add(consumer._poly);
+  }
+
   virtual void doneConsuming() {
     if (_univar)
       _uniPoly.feedTo(_consumer, _canonical);
@@ -80,7 +91,7 @@ public:
 private:
   bool _univar;
   Term _tmp;
-  Deformer _deformer;
+  const Deformer& _deformer;
   const TermTranslator& _translator;
   bool _canonical;
   CoefBigTermConsumer& _consumer;
@@ -114,19 +125,33 @@ void ScarfHilbertAlgorithm::runGeneric(const Ideal& ideal,
                                        bool univariate,
                                        bool canonical) {
   Ideal deformed(ideal);
-  UndeformConsumer undeformer(deformed,
-                              _translator,
-                              consumer,
-                              *_deformationOrder,
-                              univariate,
-                              canonical,
-                              _params.getDeformToStronglyGeneric());
+  Deformer deformer(deformed,
+                    *_deformationOrder,
+                    _params.getDeformToStronglyGeneric());
+
+  // Each thread gets its own consumer so that the threads do not have
+  // to synchronize when they find a face. Debug output from several
+  // threads would be interleaved, so we use one thread in that case.
+  size_t threadCount = getMaxThreadCount();
+  if (_params.getPrintDebug())
+    threadCount = 1;
+  vector<UndeformConsumer*> undeformers;
+  ElementDeleter<vector<UndeformConsumer*> > undeformersDeleter(undeformers);
+  for (size_t i = 0; i < threadCount; ++i) {
+    exceptionSafePushBack(undeformers, auto_ptr<UndeformConsumer>
+      (new UndeformConsumer
+       (deformer, _translator, consumer, univariate, canonical)));
+  }
 
+  UndeformConsumer& undeformer = *undeformers.front();
   undeformer.consumeRing(_translator.getNames());
   undeformer.beginConsuming();
   ASSERT(_enumerationOrder.get() != 0);
   _enumerationOrder->order(deformed);
-  enumerateScarfComplex(deformed, undeformer);
+  enumerateScarfComplex
+    (deformed, vector<CoefTermConsumer*>(undeformers.begin(), undeformers.end()));
+  for (size_t i = 1; i < undeformers.size(); ++i)
+    undeformer.add(*undeformers[i]);
   undeformer.doneConsuming();
 
   if (_params.getPrintStatistics()) {
@@ -138,43 +163,49 @@ void ScarfHilbertAlgorithm::runGeneric(const Ideal& ideal,
   }
 }
 
-void ScarfHilbertAlgorithm::initializeEnumeration(const Ideal& ideal,
-                                                  size_t& activeStateCount) {
+bool ScarfHilbertAlgorithm::initializeEnumeration(const Ideal& ideal,
+                                                  const IdealTree& tree,
+                                                  size_t first,
+                                                  vector<State>& states,
+                                                  size_t& totalStates) const {
   ASSERT(ideal.getVarCount() == _translator.getVarCount());
+  ASSERT(first < ideal.getGeneratorCount());
 
-  if (_params.getPrintDebug()) {
-    fputs("Enumerating faces of Scarf complex of:\n", stderr);
-    ideal.print(stderr);
-  }
-
-  // Set up _states with enough entries. The maximal number of active
+  // Set up states with enough entries. The maximal number of active
   // entries at any time is one for each generator plus one for the
   // empty face. We need one more than this because we take a
   // reference to the next state even when there is no next state.
   size_t statesNeeded = ideal.getGeneratorCount() + 2;
-  if (_states.size() < statesNeeded) {
-    _states.resize(statesNeeded);
-    for (size_t i = 0; i < _states.size(); ++i) {
-      _states[i].term.reset(ideal.getVarCount());
-      _states[i].face.reserve(ideal.getVarCount());
+  if (states.size() < statesNeeded) {
+    states.resize(statesNeeded);
+    for (size_t i = 0; i < states.size(); ++i) {
+      states[i].term.reset(ideal.getVarCount());
+      states[i].face.reserve(ideal.getVarCount());
     }
   }
 
-  // Set up the initial state
-  activeStateCount = 0;
-  if (ideal.containsIdentity())
-    return;
-
-  ++activeStateCount;
-  _states[0].plus = true;
-  _states[0].pos = ideal.begin();
-  ASSERT(_states[0].term.isIdentity());
+  // This accounts for the state of the empty face where the first
+  // generator is considered.
+  ++totalStates;
+
+  // Set up the initial state as the face that contains only the
+  // first generator, if that is a face.
+  Exponent* firstTerm = *(ideal.begin() + first);
+  if (tree.strictlyContains(firstTerm))
+    return false;
+  states[0].plus = false;
+  states[0].pos = ideal.begin() + first + 1;
+  states[0].term = firstTerm;
+  states[0].face.clear();
+  states[0].face.push_back(firstTerm);
+  return true;
 }
 
 bool ScarfHilbertAlgorithm::doEnumerationStep(const Ideal& ideal,
                                               const IdealTree& tree,
                                               State& state,
-                                              State& nextState) {
+                                              State& nextState,
+                                              size_t& totalStates) const {
   if (_params.getPrintDebug()) {
     fputs("DEBUG:*Looking at element ", stderr);
     if (state.pos == ideal.end())
@@ -196,7 +227,7 @@ bool ScarfHilbertAlgorithm::doEnumerationStep(const Ideal& ideal,
 
   Exponent* termToAdd;
   while (true) {
-    ++_totalStates;
+    ++totalStates;
     if (state.face.size() == ideal.getVarCount() || state.pos == ideal.end())
       return false; // A base case
 
@@ -236,7 +267,8 @@ bool ScarfHilbertAlgorithm::doEnumerationStep(const Ideal& ideal,
 }
 
 void ScarfHilbertAlgorithm::doEnumerationBaseCase(const State& state,
-                                                  CoefTermConsumer& consumer) {
+                                                  CoefTermConsumer& consumer,
+                                                  size_t& totalFaces) const {
   if (_params.getPrintDebug()) {
     fputs("DEBUG: Found base case with lcm(face)=", stderr);
     state.term.print(stderr);
@@ -248,26 +280,92 @@ void ScarfHilbertAlgorithm::doEnumerationBaseCase(const State& state,
 
   // Every face ends up as a base case exactly once, so this is a
   // convenient place to count them.
-  ++_totalFaces;
+  ++totalFaces;
 }
 
-void ScarfHilbertAlgorithm::enumerateScarfComplex(const Ideal& ideal,
-                                                  CoefTermConsumer& consumer) {
-  ASSERT(Ideal(ideal).isWeaklyGeneric());
-
-  IdealTree tree(ideal);
+void ScarfHilbertAlgorithm::enumerateSubtree(const Ideal& ideal,
+                                             const IdealTree& tree,
+                                             size_t first,
+                                             vector<State>& states,
+                                             CoefTermConsumer& consumer,
+                                             size_t& totalStates,
+                                             size_t& totalFaces) const {
+  if (!initializeEnumeration(ideal, tree, first, states, totalStates))
+    return;
 
-  size_t activeStateCount = 0;
-  initializeEnumeration(ideal, activeStateCount);
+  Cancellation& cancellation = Cancellation::getSingleton();
+  size_t activeStateCount = 1;
   while (activeStateCount > 0) {
-    ASSERT(activeStateCount < _states.size());
-    State& currentState = _states[activeStateCount - 1];
-    State& nextState = _states[activeStateCount];
-    if (doEnumerationStep(ideal, tree, currentState, nextState))
+    cancellation.check();
+    ASSERT(activeStateCount < states.size());
+    State& currentState = states[activeStateCount - 1];
+    State& nextState = states[activeStateCount];
+    if (doEnumerationStep(ideal, tree, currentState, nextState, totalStates))
       ++activeStateCount;
     else {
-      doEnumerationBaseCase(currentState, consumer);
+      doEnumerationBaseCase(currentState, consumer, totalFaces);
       --activeStateCount;
     }
   }
 }
+
+void ScarfHilbertAlgorithm::enumerateScarfComplex
+(const Ideal& ideal, const vector<CoefTermConsumer*>& consumers) {
+  ASSERT(Ideal(ideal).isWeaklyGeneric());
+  ASSERT(!consumers.empty());
+
+  if (_params.getPrintDebug()) {
+    fputs("Enumerating faces of Scarf complex of:\n", stderr);
+    ideal.print(stderr);
+  }
+
+  if (ideal.containsIdentity())
+    return;
+
+  IdealTree tree(ideal);
+
+  // The non-empty faces are partitioned into subtrees according to
+  // their first generator in enumeration order. The subtrees do not
+  // depend on each other, so they are enumerated in parallel when
+  // that is possible. The subtrees for the first generators tend to
+  // be the largest, so they are scheduled first. With a single thread
+  // this is the same depth-first order as for a single tree.
+  const long subtreeCount = static_cast<long>(ideal.getGeneratorCount());
+  size_t totalStates = 0;
+  size_t totalFaces = 0;
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+  const int threadCount = static_cast<int>(consumers.size());
+#pragma omp parallel num_threads(threadCount) \
+  reduction(+: totalStates, totalFaces)
+#endif
+  {
+    vector<State> states;
+    CoefTermConsumer& consumer = *consumers[getThreadIndex()];
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (long subtree = 0; subtree < subtreeCount; ++subtree) {
+      if (catcher.hasCaught())
+        continue;
+      try {
+        enumerateSubtree(ideal, tree, static_cast<size_t>(subtree), states,
+                         consumer, totalStates, totalFaces);
+      } catch (...) {
+        catcher.catchCurrent();
+      }
+    }
+  }
+  catcher.rethrowIfCaught();
+
+  // The empty face is the last base case of a depth-first enumeration.
+  State emptyFace;
+  emptyFace.term.reset(ideal.getVarCount());
+  emptyFace.pos = ideal.end();
+  emptyFace.plus = true;
+  ++totalStates;
+  doEnumerationBaseCase(emptyFace, *consumers.front(), totalFaces);
+
+  _totalStates += totalStates;
+  _totalFaces += totalFaces;
+}
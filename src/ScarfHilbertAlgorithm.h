@@ -49,18 +49,35 @@ class ScarfHilbertAlgorithm {
     vector<Exponent*> face;
     bool plus;
   };
-  vector<State> _states;
 
+  /** Sends each face of the Scarf complex of ideal to one of
+   consumers. Each thread uses its own consumer, so there must be a
+   consumer for each thread. */
   void enumerateScarfComplex(const Ideal& ideal,
-                             CoefTermConsumer& consumer);
-  void initializeEnumeration(const Ideal& ideal,
-                             size_t& activeStateCount);
+                             const vector<CoefTermConsumer*>& consumers);
+
+  /** Enumerates the faces whose first generator in enumeration order
+   is the generator at index first. */
+  void enumerateSubtree(const Ideal& ideal,
+                        const IdealTree& tree,
+                        size_t first,
+                        vector<State>& states,
+                        CoefTermConsumer& consumer,
+                        size_t& totalStates,
+                        size_t& totalFaces) const;
+  bool initializeEnumeration(const Ideal& ideal,
+                             const IdealTree& tree,
+                             size_t first,
+                             vector<State>& states,
+                             size_t& totalStates) const;
   bool doEnumerationStep(const Ideal& ideal,
                          const IdealTree& tree,
                          State& state,
-                         State& nextState);
+                         State& nextState,
+                         size_t& totalStates) const;
   void doEnumerationBaseCase(const State& state,
-                             CoefTermConsumer& consumer);
+                             CoefTermConsumer& consumer,
+                             size_t& totalFaces) const;
 
   const TermTranslator& _translator;
   const ScarfParams& _params;
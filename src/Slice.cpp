@@ -26,6 +26,7 @@
 Slice::Slice(SliceStrategy& strategy):
   _varCount(0),
   _lcmUpdated(false),
+  _supportCountsUpdated(false),
   _lowerBoundHint(0),
   _strategy(strategy) {
 }
@@ -38,6 +39,8 @@ Slice::Slice(SliceStrategy& strategy,
   _varCount(multiply.getVarCount()),
   _lcm(multiply.getVarCount()),
   _lcmUpdated(false),
+  _supportCounts(multiply.getVarCount()),
+  _supportCountsUpdated(false),
   _lowerBoundHint(0),
   _strategy(strategy) {
   ASSERT(multiply.getVarCount() == ideal.getVarCount());
@@ -65,6 +68,23 @@ const Term& Slice::getLcm() const {
   return _lcm;
 }
 
+const Term& Slice::getSupportCounts() const {
+#ifdef DEBUG
+  if (_supportCountsUpdated) {
+    Term tmp(_varCount);
+    _ideal.getSupportCounts(tmp);
+    ASSERT(tmp == _supportCounts);
+  }
+#endif
+
+  if (!_supportCountsUpdated) {
+    _supportCounts.reset(_varCount);
+    getIdeal().getSupportCounts(_supportCounts);
+    _supportCountsUpdated = true;
+  }
+  return _supportCounts;
+}
+
 void Slice::print(FILE* file) const {
   fputs("Slice (multiply: ", file);
   _multiply.print(file);
@@ -81,6 +101,8 @@ Slice& Slice::operator=(const Slice& slice) {
   _multiply = slice._multiply;
   _lcm = slice._lcm;
   _lcmUpdated = slice._lcmUpdated;
+  _supportCounts = slice._supportCounts;
+  _supportCountsUpdated = slice._supportCountsUpdated;
   _lowerBoundHint = slice._lowerBoundHint;
 
   return *this;
@@ -93,6 +115,8 @@ void Slice::resetAndSetVarCount(size_t varCount) {
   _multiply.reset(varCount);
   _lcm.reset(varCount);
   _lcmUpdated = false;
+  _supportCounts.reset(varCount);
+  _supportCountsUpdated = false;
   _lowerBoundHint = 0;
 }
 
@@ -100,6 +124,7 @@ void Slice::clearIdealAndSubtract() {
   _ideal.clear();
   _subtract.clear();
   _lcmUpdated = false;
+  _supportCountsUpdated = false;
   _lowerBoundHint = 0;
 }
 
@@ -115,13 +140,40 @@ bool Slice::innerSlice(const Term& pivot) {
   _multiply.product(_multiply, pivot);
   bool idealChanged = _ideal.colonReminimize(pivot);
   bool subtractChanged = _subtract.colonReminimize(pivot);
+  return updateAfterInnerColon(pivot, count, idealChanged, subtractChanged);
+}
+
+bool Slice::setToInnerSliceOf(const Slice& slice, const Term& pivot) {
+  ASSERT(&slice != this);
+  ASSERT(slice.getVarCount() == pivot.getVarCount());
+
+  _varCount = slice._varCount;
+  _multiply = slice._multiply;
+  _lcm = slice._lcm;
+  _lcmUpdated = slice._lcmUpdated;
+  _supportCounts = slice._supportCounts;
+  _supportCountsUpdated = slice._supportCountsUpdated;
+  _lowerBoundHint = slice._lowerBoundHint;
+
+  _multiply.product(_multiply, pivot);
+  bool idealChanged = _ideal.setToColonReminimize(slice._ideal, pivot);
+  bool subtractChanged =
+    _subtract.setToColonReminimize(slice._subtract, pivot);
+  return updateAfterInnerColon(pivot, slice._ideal.getGeneratorCount(),
+                               idealChanged, subtractChanged);
+}
+
+bool Slice::updateAfterInnerColon(const Term& pivot, size_t generatorCount,
+                                  bool idealChanged, bool subtractChanged) {
   bool changed = idealChanged || subtractChanged;
+  if (idealChanged)
+    _supportCountsUpdated = false;
   if (changed) {
     normalize();
     _lowerBoundHint = pivot.getFirstNonZeroExponent();
   }
 
-  if (_ideal.getGeneratorCount() == count)
+  if (_ideal.getGeneratorCount() == generatorCount)
     _lcm.colon(_lcm, pivot);
   else
     _lcmUpdated = false;
@@ -129,21 +181,7 @@ bool Slice::innerSlice(const Term& pivot) {
   return changed;
 }
 
-void Slice::outerSlice(const Term& pivot) {
-  ASSERT(getVarCount() == pivot.getVarCount());
-
-  size_t count = getIdeal().getGeneratorCount();
-  _ideal.removeStrictMultiples(pivot);
-  if (getIdeal().getGeneratorCount() != count)
-    _lcmUpdated = false;
-
-  if (pivot.getSizeOfSupport() > 1)
-    getSubtract().insertReminimize(pivot);
-
-  _lowerBoundHint = pivot.getFirstNonZeroExponent();
-}
-
-// Helper class for normalize().
+// Helper class for outerSlice() and normalize().
 class StrictMultiplePredicate {
 public:
   StrictMultiplePredicate(const Exponent* term, size_t varCount):
@@ -159,6 +197,17 @@ private:
   size_t _varCount;
 };
 
+void Slice::outerSlice(const Term& pivot) {
+  ASSERT(getVarCount() == pivot.getVarCount());
+
+  removeFromIdealIf(StrictMultiplePredicate(pivot.begin(), _varCount));
+
+  if (pivot.getSizeOfSupport() > 1)
+    getSubtract().insertReminimize(pivot);
+
+  _lowerBoundHint = pivot.getFirstNonZeroExponent();
+}
+
 bool Slice::adjustMultiply() {
   bool changed = false;
   while (true) {
@@ -192,10 +241,8 @@ bool Slice::normalize() {
   Ideal::const_iterator stop = _subtract.end();
   for (Ideal::const_iterator it = _subtract.begin(); it != stop; ++it) {
     StrictMultiplePredicate pred(*it, _varCount);
-    if (_ideal.removeIf(pred)) {
+    if (removeFromIdealIf(pred))
       removedAny = true;
-      _lcmUpdated = false;
-    }
   }
 
   return removedAny;
@@ -254,6 +301,8 @@ void Slice::swap(Slice& slice) {
   _multiply.swap(slice._multiply);
   _lcm.swap(slice._lcm);
   std::swap(_lcmUpdated, slice._lcmUpdated);
+  _supportCounts.swap(slice._supportCounts);
+  std::swap(_supportCountsUpdated, slice._supportCountsUpdated);
   _ideal.swap(slice._ideal);
   _subtract.swap(slice._subtract);
   std::swap(_lowerBoundHint, slice._lowerBoundHint);
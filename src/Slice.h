@@ -123,6 +123,16 @@ class Slice : public Task {
   */
   const Term& getLcm() const;
 
+  /** Returns the number of generators of getIdeal() that each
+   variable divides. Like the lcm, the counts are stored. They are
+   updated when generators are removed from the ideal and are only
+   recomputed after a change that may alter the support of
+   generators, and the child slices of a split inherit them, so
+   calling this method should be regarded as an inexpensive
+   operation.
+  */
+  const Term& getSupportCounts() const;
+
   /** Write a text representation of this object to file in a format
    appropriate for debugging. */
   void print(FILE* file) const;
@@ -170,6 +180,15 @@ class Slice : public Task {
   */
   virtual bool innerSlice(const Term& pivot);
 
+  /** Sets this object to the inner slice of slice according to
+   pivot. This has the same effect as assigning slice to this object
+   and then calling innerSlice(pivot), but the colon is done while
+   copying the ideals, so the generators are only passed over once
+   and the copy costs no more than the colon does anyway. slice must
+   not be this object. Returns the same as innerSlice().
+  */
+  virtual bool setToInnerSliceOf(const Slice& slice, const Term& pivot);
+
   /** Sets this object to the outer slice according to pivot. To be
    precise, the slice \f$(I,S,q)\f$ is replaced by \f$(I,S+\ideal
    p,q)\f$ where \f$p\f$ is the pivot, and the slice is then
@@ -262,6 +281,14 @@ class Slice : public Task {
   */
   virtual bool getLowerBound(Term& bound, size_t var) const = 0;
 
+  /** Removes those generators of getIdeal() for which pred returns
+   true. Returns true if any generators were removed. This keeps the
+   stored support counts up to date, so use this method rather than
+   calling removeIf on _ideal directly.
+  */
+  template<class Predicate>
+  bool removeFromIdealIf(Predicate pred);
+
   /** The \f$I\f$ of a slice \f$(I,S,q)\f$. */
   Ideal _ideal;
 
@@ -292,6 +319,15 @@ class Slice : public Task {
   */
   mutable bool _lcmUpdated;
 
+  /** The support counts of getIdeal() if _supportCountsUpdated is
+   true, and otherwise the value is undefined. These member variables
+   are mutable for the same reason as _lcm and _lcmUpdated.
+  */
+  mutable Term _supportCounts;
+
+  /** Indicates whether _supportCounts is correct. */
+  mutable bool _supportCountsUpdated;
+
   /** A hint that starting simplification through a lower bound at the
    variable indicated by _lowerBoundHint is likely to yield a
    simplification, or at least more likely than a random other
@@ -301,6 +337,51 @@ class Slice : public Task {
   size_t _lowerBoundHint;
 
   SliceStrategy& _strategy;
+
+ private:
+  /** Does the part of innerSlice and setToInnerSliceOf that comes
+   after the colon by pivot. generatorCount is the number of
+   generators of the ideal before the colon, and idealChanged and
+   subtractChanged are what the colons of the ideal and of subtract
+   returned. Returns the same as innerSlice. */
+  bool updateAfterInnerColon(const Term& pivot, size_t generatorCount,
+                             bool idealChanged, bool subtractChanged);
+
+  /** Predicate for removeFromIdealIf(). Forwards to another predicate
+   and subtracts the support of each term that is to be removed from
+   counts, unless counts is null. */
+  template<class Predicate>
+  class SupportCountsUpdater {
+  public:
+    SupportCountsUpdater(Predicate pred, Term* counts, size_t varCount):
+      _pred(pred), _counts(counts), _varCount(varCount) {}
+
+    bool operator()(const Exponent* term) {
+      if (!_pred(term))
+        return false;
+      if (_counts != 0)
+        for (size_t var = 0; var < _varCount; ++var)
+          if (term[var] > 0)
+            (*_counts)[var] -= 1;
+      return true;
+    }
+
+  private:
+    Predicate _pred;
+    Term* _counts;
+    size_t _varCount;
+  };
 };
 
+template<class Predicate>
+inline bool Slice::removeFromIdealIf(Predicate pred) {
+  Term* counts = _supportCountsUpdated ? &_supportCounts : 0;
+  SupportCountsUpdater<Predicate> updater(pred, counts, _varCount);
+  if (!_ideal.removeIf(updater))
+    return false;
+
+  _lcmUpdated = false;
+  return true;
+}
+
 #endif
@@ -0,0 +1,133 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SliceCheckpoint.h"
+
+#include "Slice.h"
+#include "Term.h"
+#include "error.h"
+
+namespace {
+  /** Every checkpoint file begins with this. The number at the end is
+   the version of the format. */
+  const char* Magic = "Frobby slice checkpoint 2\n";
+
+  /** Every output file begins with this. */
+  const char* OutputMagic = "Frobby slice checkpoint output 1\n";
+}
+
+SliceCheckpoint::SliceCheckpoint(const string& fileName, size_t varCount,
+                                 TermConsumer* consumer):
+  _fileName(fileName),
+  _varCount(varCount),
+  _consumer(consumer),
+  _outputCount(0) {
+  ASSERT(consumer != 0);
+}
+
+SliceCheckpoint::~SliceCheckpoint() {
+}
+
+void SliceCheckpoint::beginRun() {
+  _output.openForWriting(getOutputFileName(), OutputMagic);
+  _outputCount = 0;
+}
+
+void SliceCheckpoint::beginConsuming() {
+  _consumer->beginConsuming();
+}
+
+void SliceCheckpoint::consume(const Term& term) {
+  ASSERT(term.getVarCount() == _varCount);
+  _output.writeTerm(term.begin(), _varCount);
+  ++_outputCount;
+  _consumer->consume(term);
+}
+
+void SliceCheckpoint::doneConsuming() {
+  _consumer->doneConsuming();
+}
+
+void SliceCheckpoint::write(const Ideal& input,
+                            const vector<const Slice*>& slices) {
+  // The output has to be in the output file before the checkpoint
+  // that refers to it replaces the previous checkpoint.
+  _output.flush();
+
+  const string tmpFileName = _fileName + ".tmp";
+  {
+    SliceFile out;
+    out.openForWriting(tmpFileName, Magic);
+    out.writeWord(_varCount);
+    out.writeWord(SliceFile::hashIdeal(input));
+    out.writeWord(_outputCount);
+    out.writeWord(slices.size());
+    for (size_t i = 0; i < slices.size(); ++i) {
+      ASSERT(slices[i]->getVarCount() == _varCount);
+      out.writeSlice(*slices[i]);
+    }
+    out.close();
+  }
+
+  SliceFile::replaceFile(tmpFileName, _fileName);
+}
+
+size_t SliceCheckpoint::beginResume(const Ideal& input) {
+  _in.openForReading(_fileName, Magic, "checkpoint");
+  if (_in.readWord() != _varCount ||
+      _in.readWord() != SliceFile::hashIdeal(input))
+    reportError("The checkpoint file \"" + _fileName +
+                "\" was written for a different input or action.");
+
+  const size_t outputCount = _in.readWord();
+  const size_t sliceCount = _in.readWord();
+
+  _output.openForUpdating(getOutputFileName(), OutputMagic,
+                          "checkpoint output");
+  Term term(_varCount);
+  for (size_t i = 0; i < outputCount; ++i) {
+    _output.readTerm(term);
+    _consumer->consume(term);
+  }
+  _output.beginWriting();
+  _outputCount = outputCount;
+
+  return sliceCount;
+}
+
+void SliceCheckpoint::readSlice(Ideal& ideal, Ideal& subtract,
+                                Term& multiply) {
+  ASSERT(ideal.getVarCount() == _varCount);
+  ASSERT(subtract.getVarCount() == _varCount);
+  ASSERT(multiply.getVarCount() == _varCount);
+  _in.readSlice(ideal, subtract, multiply);
+}
+
+void SliceCheckpoint::endResume() {
+  _in.close();
+}
+
+void SliceCheckpoint::removeFile() {
+  _output.close();
+  remove(getOutputFileName().c_str());
+  remove(_fileName.c_str());
+}
+
+string SliceCheckpoint::getOutputFileName() const {
+  return _fileName + ".output";
+}
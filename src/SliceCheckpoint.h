@@ -0,0 +1,107 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SLICE_CHECKPOINT_GUARD
+#define SLICE_CHECKPOINT_GUARD
+
+#include "TermConsumer.h"
+#include "SliceFile.h"
+#include <string>
+#include <vector>
+
+class Ideal;
+class Slice;
+class Term;
+
+/** Saves the state of a run of the Slice Algorithm to a file so that
+ the run can be resumed after it has been interrupted. The state is
+ the pending slices, given by their ideal, subtract and multiply, and
+ the output that has been produced so far.
+
+ SliceCheckpoint is placed between the algorithm and the consumer of
+ the output, and it appends each term that it passes on to an output
+ file next to the checkpoint file. A checkpoint records the pending
+ slices and how many terms of the output file belong to it, so
+ writing a checkpoint takes time proportional to the pending slices
+ rather than to the output. When a run is resumed, the recorded terms
+ are passed on to the new consumer before the pending slices are
+ processed, so the output of a resumed run is the same as that of a
+ run that was never interrupted.
+
+ The files are written in a binary format. The checkpoint includes a
+ hash of the input ideal so that it is not resumed with the wrong
+ input. */
+class SliceCheckpoint : public TermConsumer {
+ public:
+  /** Passes terms on to consumer and writes checkpoints to fileName.
+   The output is recorded in fileName with the suffix .output added. */
+  SliceCheckpoint(const string& fileName, size_t varCount,
+                  TermConsumer* consumer);
+  virtual ~SliceCheckpoint();
+
+  /** Creates the output file for a run that is not resumed. Either this
+   or beginResume must be called before any terms are consumed. */
+  void beginRun();
+
+  virtual void beginConsuming();
+  virtual void consume(const Term& term);
+  virtual void doneConsuming();
+
+  /** Writes a checkpoint of a run on input with the given pending
+   slices, where the last slice is to be processed first. The
+   checkpoint is written to a temporary file that then replaces the
+   previous checkpoint, so the previous checkpoint remains intact if
+   Frobby is stopped while writing. */
+  void write(const Ideal& input, const vector<const Slice*>& slices);
+
+  /** Opens the checkpoint file to resume a run on input. Reports an
+   error if the file cannot be read or if it was written for another
+   input. The output recorded for the checkpoint is passed on to the
+   consumer as if it had just been computed, so beginConsuming must
+   have been called. Output after that in the output file is from
+   after the checkpoint, so it is overwritten as the run goes on.
+   Returns the number of pending slices, which must then be read using
+   readSlice. */
+  size_t beginResume(const Ideal& input);
+
+  /** Reads the next pending slice from the checkpoint file. The slices
+   are read in the order they were given to write. */
+  void readSlice(Ideal& ideal, Ideal& subtract, Term& multiply);
+
+  /** Closes the checkpoint file after all slices have been read. */
+  void endResume();
+
+  /** Deletes the checkpoint file and the output file. Call this once
+   the run is done. */
+  void removeFile();
+
+ private:
+  string getOutputFileName() const;
+
+  string _fileName;
+  size_t _varCount;
+  TermConsumer* _consumer;
+  SliceFile _in;
+
+  /** The output is appended to this file. */
+  SliceFile _output;
+
+  /** The number of terms written to _output. */
+  size_t _outputCount;
+};
+
+#endif
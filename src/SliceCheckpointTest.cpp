@@ -0,0 +1,133 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SliceCheckpoint.h"
+#include "tests.h"
+
+#include "MsmStrategy.h"
+#include "MsmSlice.h"
+#include "DecomRecorder.h"
+#include "SplitStrategy.h"
+#include "Term.h"
+#include "error.h"
+
+TEST_SUITE(SliceCheckpoint)
+
+namespace {
+  const char* FileName = "frobbySliceCheckpointTest.tmp";
+
+  Ideal makeIdeal(const char* a, const char* b, const char* c) {
+    Ideal ideal(3);
+    ideal.insert(Term(a));
+    ideal.insert(Term(b));
+    ideal.insert(Term(c));
+    return ideal;
+  }
+}
+
+TEST(SliceCheckpoint, RoundTrip) {
+  const Ideal input = makeIdeal("4 0 0", "0 4 0", "1 1 1");
+  const Ideal output = makeIdeal("3 3 0", "0 3 3", "3 0 3");
+  const Ideal sliceIdeal = makeIdeal("2 0 0", "0 2 0", "1 1 1");
+  const Ideal sliceSubtract(Term("1 1 0"));
+  const Term sliceMultiply("1 2 3");
+
+  Ideal written(3);
+  DecomRecorder writtenRecorder(&written);
+  auto_ptr<SplitStrategy> split = SplitStrategy::createStrategy("median");
+  MsmStrategy strategy(&writtenRecorder, split.get());
+  {
+    SliceCheckpoint checkpoint(FileName, 3, &writtenRecorder);
+    checkpoint.beginRun();
+    for (Ideal::const_iterator it = output.begin(); it != output.end(); ++it)
+      checkpoint.consume(Term(*it, 3));
+
+    MsmSlice slice(strategy, sliceIdeal, sliceSubtract, sliceMultiply,
+                   &checkpoint);
+    vector<const Slice*> slices;
+    slices.push_back(&slice);
+    checkpoint.write(input, slices);
+  }
+  ASSERT_EQ(written, output);
+
+  Ideal resumed(3);
+  DecomRecorder resumedRecorder(&resumed);
+  SliceCheckpoint checkpoint(FileName, 3, &resumedRecorder);
+  ASSERT_EQ(checkpoint.beginResume(input), 1u);
+  ASSERT_EQ(resumed, output);
+
+  Ideal ideal(3);
+  Ideal subtract(3);
+  Term multiply(3);
+  checkpoint.readSlice(ideal, subtract, multiply);
+  checkpoint.endResume();
+  ASSERT_EQ(ideal, sliceIdeal);
+  ASSERT_EQ(subtract, sliceSubtract);
+  ASSERT_EQ(multiply, sliceMultiply);
+
+  checkpoint.removeFile();
+}
+
+TEST(SliceCheckpoint, WrongInput) {
+  Ideal recorded(3);
+  DecomRecorder recorder(&recorded);
+  SliceCheckpoint checkpoint(FileName, 3, &recorder);
+  checkpoint.beginRun();
+  checkpoint.write(makeIdeal("4 0 0", "0 4 0", "1 1 1"),
+                   vector<const Slice*>());
+
+  ASSERT_EXCEPTION(checkpoint.beginResume(makeIdeal("4 0 0", "0 4 0", "0 0 4")),
+                   const FrobbyException&);
+  checkpoint.removeFile();
+}
+
+TEST(SliceCheckpoint, OutputAfterCheckpoint) {
+  const Ideal input = makeIdeal("4 0 0", "0 4 0", "1 1 1");
+  Ideal written(3);
+  DecomRecorder writtenRecorder(&written);
+  {
+    SliceCheckpoint checkpoint(FileName, 3, &writtenRecorder);
+    checkpoint.beginRun();
+    checkpoint.consume(Term("3 3 0"));
+    checkpoint.write(input, vector<const Slice*>());
+    checkpoint.consume(Term("0 3 3"));
+  }
+
+  // The term consumed after the checkpoint is not part of it, and the
+  // resumed run writes its own output over it.
+  Ideal resumed(3);
+  DecomRecorder resumedRecorder(&resumed);
+  {
+    SliceCheckpoint checkpoint(FileName, 3, &resumedRecorder);
+    ASSERT_EQ(checkpoint.beginResume(input), 0u);
+    checkpoint.endResume();
+    ASSERT_EQ(resumed, Ideal(Term("3 3 0")));
+    checkpoint.consume(Term("3 0 3"));
+    checkpoint.write(input, vector<const Slice*>());
+  }
+
+  Ideal resumedAgain(3);
+  DecomRecorder resumedAgainRecorder(&resumedAgain);
+  SliceCheckpoint checkpoint(FileName, 3, &resumedAgainRecorder);
+  ASSERT_EQ(checkpoint.beginResume(input), 0u);
+  checkpoint.endResume();
+  Ideal expected(Term("3 3 0"));
+  expected.insert(Term("3 0 3"));
+  ASSERT_EQ(resumedAgain, expected);
+  checkpoint.removeFile();
+}
@@ -40,8 +40,13 @@
 #include "VarSorter.h"
 #include "StatisticsStrategy.h"
 #include "IrreducibleIdealSplitter.h"
-#include "SizeMaxIndepSetAlg.h"
 #include "SliceParams.h"
+#include "SliceShards.h"
+#include "SquareFreeDecomAlg.h"
+#include "SquareFreeHilbertAlg.h"
+#include "SquareFreeMaxIndepSetAlg.h"
+#include "RawSquareFreeIdeal.h"
+#include "RawSquareFreeTerm.h"
 #include "error.h"
 #include "display.h"
 
@@ -77,6 +82,12 @@ SliceFacade::~SliceFacade() {
 
 void SliceFacade::computeMultigradedHilbertSeries() {
   ASSERT(isFirstComputation());
+  if (useSquareFreeAlgorithms()) {
+    produceSquareFreeHilbertSeries(false);
+    return;
+  }
+
+  chooseSplit(SplitChooser::HilbertSeries);
   beginAction("Computing multigraded Hilbert-Poincare series.");
 
   auto_ptr<CoefTermConsumer> consumer = _common.makeTranslatedPolyConsumer();
@@ -84,6 +95,7 @@ void SliceFacade::computeMultigradedHilbertSeries() {
   consumer->consumeRing(_common.getNames());
   consumer->beginConsuming();
   HilbertStrategy strategy(consumer.get(), _split.get());
+  setShardOptions(strategy);
   runSliceAlgorithmWithOptions(strategy);
   consumer->doneConsuming();
 
@@ -92,6 +104,12 @@ void SliceFacade::computeMultigradedHilbertSeries() {
 
 void SliceFacade::computeUnivariateHilbertSeries() {
   ASSERT(isFirstComputation());
+  if (useSquareFreeAlgorithms()) {
+    produceSquareFreeHilbertSeries(true);
+    return;
+  }
+
+  chooseSplit(SplitChooser::HilbertSeries);
   beginAction("Computing univariate Hilbert-Poincare series.");
 
   auto_ptr<CoefTermConsumer> consumer =
@@ -100,6 +118,7 @@ void SliceFacade::computeUnivariateHilbertSeries() {
   consumer->consumeRing(_common.getNames());
   consumer->beginConsuming();
   HilbertStrategy strategy(consumer.get(), _split.get());
+  setShardOptions(strategy);
   runSliceAlgorithmWithOptions(strategy);
   consumer->doneConsuming();
 
@@ -108,6 +127,10 @@ void SliceFacade::computeUnivariateHilbertSeries() {
 
 void SliceFacade::computeIrreducibleDecomposition(bool encode) {
   ASSERT(isFirstComputation());
+  if (useSquareFreeAlgorithms()) {
+    produceSquareFreeCovers(*_common.makeTranslatedIdealConsumer(!encode));
+    return;
+  }
   produceEncodedIrrDecom(*_common.makeTranslatedIdealConsumer(!encode));
 }
 
@@ -125,6 +148,20 @@ mpz_class SliceFacade::computeDimension(bool codimension) {
   // todo: inline?
   takeRadical();
 
+  if (_params.getUseSquareFree()) {
+    noteOptionsBypassedBySquareFree(_params.isSplitGiven());
+    beginAction("Computing dimension of square free ideal.");
+    SquareFreeMaxIndepSetAlg alg;
+    alg.run(_common.getIdeal());
+    const mpz_class dimension = alg.getMaxIndepSetSize();
+    endAction();
+
+    if (codimension)
+      return _common.getIdeal().getVarCount() - dimension;
+    else
+      return dimension;
+  }
+
   beginAction("Preparing to compute dimension.");
 
   vector<mpz_class> v;
@@ -228,11 +265,14 @@ void SliceFacade::computePrimaryDecomposition() {
 
 void SliceFacade::computeMaximalStaircaseMonomials() {
   ASSERT(isFirstComputation());
+  chooseSplit(SplitChooser::Decomposition);
   beginAction("Computing maximal staircase monomials.");
 
   auto_ptr<TermConsumer> consumer = _common.makeTranslatedIdealConsumer();
   consumer->consumeRing(_common.getNames());
   MsmStrategy strategy(consumer.get(), _split.get());
+  setCheckpointOptions(strategy);
+  setShardOptions(strategy);
   runSliceAlgorithmWithOptions(strategy);
 
   endAction();
@@ -265,6 +305,12 @@ void SliceFacade::computeAlexanderDual(const vector<mpz_class>& point) {
   }
   endAction();
 
+  // The covers are the generators of the dual on the lcm.
+  if (point == lcm && useSquareFreeAlgorithms()) {
+    produceSquareFreeCovers(*_common.makeTranslatedIdealConsumer());
+    return;
+  }
+
   beginAction("Preparing to compute Alexander dual.");
   _common.getTranslator().dualize(point);
   endAction();
@@ -286,6 +332,11 @@ void SliceFacade::computeAlexanderDual() {
 void SliceFacade::computeAssociatedPrimes() {
   ASSERT(isFirstComputation());
 
+  if (useSquareFreeAlgorithms()) {
+    produceSquareFreeCovers(*_common.makeTranslatedIdealConsumer());
+    return;
+  }
+
   size_t varCount = _common.getIdeal().getVarCount();
 
   // Obtain generators of radical from irreducible decomposition.
@@ -361,10 +412,13 @@ bool SliceFacade::solveStandardProgram
 
 void SliceFacade::produceEncodedIrrDecom(TermConsumer& consumer) {
   ASSERT(isFirstComputation());
+  chooseSplit(SplitChooser::Decomposition);
   beginAction("Computing irreducible decomposition.");
 
   _common.addPurePowersAtInfinity();
   MsmStrategy strategy(&consumer, _split.get());
+  setCheckpointOptions(strategy);
+  setShardOptions(strategy);
 
   consumer.consumeRing(_common.getNames());
   runSliceAlgorithmWithOptions(strategy);
@@ -394,6 +448,7 @@ bool SliceFacade::solveProgram(const vector<mpz_class>& grading,
     _params.useBoundElimination(true);
   }
 
+  chooseSplit(SplitChooser::Decomposition);
   beginAction("Solving optimization program.");
 
   OptimizeStrategy::BoundSetting boundSetting;
@@ -464,6 +519,53 @@ void SliceFacade::getLcmOfIdeal(vector<mpz_class>& bigLcm) {
     bigLcm.push_back(_common.getTranslator().getExponent(var, lcm));
 }
 
+bool SliceFacade::useSquareFreeAlgorithms() {
+  ASSERT(isFirstComputation());
+  return _params.getUseSquareFree() &&
+    _params.getCheckpointFile().empty() &&
+    _params.getShardCount() == 0 &&
+    _common.isProperSquareFreeIdeal();
+}
+
+void SliceFacade::produceSquareFreeCovers(TermConsumer& consumer) {
+  ASSERT(useSquareFreeAlgorithms());
+  noteOptionsBypassedBySquareFree(_params.isSplitGiven());
+  beginAction("Computing vertex covers of square free ideal.");
+
+  const size_t varCount = _common.getIdeal().getVarCount();
+  SquareFreeDecomAlg alg;
+  alg.run(_common.getIdeal());
+  const RawSquareFreeIdeal& covers = alg.getCovers();
+
+  consumer.consumeRing(_common.getNames());
+  consumer.beginConsuming();
+  Term term(varCount);
+  RawSquareFreeIdeal::const_iterator stop = covers.end();
+  for (RawSquareFreeIdeal::const_iterator it = covers.begin();
+       it != stop; ++it) {
+    for (size_t var = 0; var < varCount; ++var)
+      term[var] = SquareFreeTermOps::getExponent(*it, var);
+    consumer.consume(term);
+  }
+  consumer.doneConsuming();
+
+  endAction();
+}
+
+void SliceFacade::produceSquareFreeHilbertSeries(bool univariate) {
+  ASSERT(useSquareFreeAlgorithms());
+  noteOptionsBypassedBySquareFree(_params.isSplitGiven());
+  beginAction("Computing Hilbert-Poincare series of square free ideal.");
+
+  SquareFreeHilbertAlg alg(_common.getTranslator());
+  alg.setComputeUnivariate(univariate);
+  alg.run(_common.getIdeal());
+  alg.feedOutputTo(_common.getPolyConsumer(),
+                   _params.getProduceCanonicalOutput());
+
+  endAction();
+}
+
 void SliceFacade::runSliceAlgorithmWithOptions(SliceStrategy& strategy) {
   ASSERT(isFirstComputation());
   strategy.setUseIndependence(_params.getUseIndependenceSplits());
@@ -488,3 +590,38 @@ void SliceFacade::runSliceAlgorithmWithOptions(SliceStrategy& strategy) {
   ASSERT(strategyWithOptions != 0);
   strategyWithOptions->run(_common.getIdeal());
 }
+
+void SliceFacade::chooseSplit(SplitChooser::Kind kind) {
+  if (string(_split->getName()) != "auto")
+    return;
+
+  beginAction("Choosing split strategy.");
+  const char* name = SplitChooser(kind).choose(_common.getIdeal());
+  _split = SplitStrategy::createStrategy(name);
+  _params.setSplit(name);
+  endAction();
+
+  printMessage("Chose the split strategy ");
+  printMessage(name);
+  printMessage(".\n");
+}
+
+void SliceFacade::setCheckpointOptions(MsmStrategy& strategy) {
+  if (_params.getCheckpointFile().empty()) {
+    if (_params.getResume())
+      reportError("Resuming a computation requires specifying the "
+                  "checkpoint file\nusing -checkpoint.");
+    return;
+  }
+  strategy.setCheckpoint(_params.getCheckpointFile(),
+                         _params.getCheckpointInterval(),
+                         _params.getResume());
+}
+
+void SliceFacade::setShardOptions(SliceStrategyCommon& strategy) {
+  if (_params.getShardCount() == 0)
+    return;
+  if (!_params.getCheckpointFile().empty())
+    reportError("Checkpoints cannot be used together with shards.");
+  strategy.setShards(auto_ptr<SliceShards>(new SliceShards(_params)));
+}
@@ -18,6 +18,7 @@
 #define SLICE_FACADE_GUARD
 
 #include "SplitStrategy.h"
+#include "SplitChooser.h"
 #include "Ideal.h"
 #include "Facade.h"
 #include "SliceParams.h"
@@ -31,6 +32,8 @@
 
 class BigIdeal;
 class BigTermConsumer;
+class MsmStrategy;
+class SliceStrategyCommon;
 class CoefBigTermConsumer;
 class SliceStrategy;
 class IOHandler;
@@ -218,8 +221,36 @@ class SliceFacade : public Facade {
 
   void getLcmOfIdeal(vector<mpz_class>& lcm);
 
+  /** Returns true if the ideal is square free and the parameters allow
+   using the algorithms specialized to that case instead of the Slice
+   Algorithm. Checkpoints and shards are only supported by the Slice
+   Algorithm. */
+  bool useSquareFreeAlgorithms();
+
+  /** Computes the minimal vertex covers of the square free ideal and
+   passes them to consumer. The variables of each cover generate an
+   irreducible component, and they are passed on as the product of
+   those variables. */
+  void produceSquareFreeCovers(TermConsumer& consumer);
+
+  /** Computes the Hilbert-Poincare series of the square free ideal. */
+  void produceSquareFreeHilbertSeries(bool univariate);
+
   void runSliceAlgorithmWithOptions(SliceStrategy& strategy);
 
+  /** Replaces the split strategy auto by the strategy that
+   SplitChooser picks for the ideal. The name of the chosen strategy is
+   also stored in the parameters so that shards use it too. */
+  void chooseSplit(SplitChooser::Kind kind);
+
+  /** Sets up strategy to write checkpoints or to resume from one if
+   the parameters say so. */
+  void setCheckpointOptions(MsmStrategy& strategy);
+
+  /** Sets up strategy to split the computation into shards if the
+   parameters say so. */
+  void setShardOptions(SliceStrategyCommon& strategy);
+
   SliceParams _params;
   CommonParamsHelper _common;
   auto_ptr<SplitStrategy> _split;
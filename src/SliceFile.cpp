@@ -0,0 +1,198 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SliceFile.h"
+
+#include "Slice.h"
+#include "Ideal.h"
+#include "Term.h"
+#include "error.h"
+#include <cstring>
+#include <vector>
+
+SliceFile::SliceFile():
+  _file(0),
+  _writing(false) {
+}
+
+SliceFile::~SliceFile() {
+  if (_file != 0)
+    fclose(_file);
+}
+
+void SliceFile::openForWriting(const string& fileName, const char* magic) {
+  ASSERT(_file == 0);
+  _fileName = fileName;
+  _writing = true;
+  _file = fopen(fileName.c_str(), "wb");
+  if (_file == 0)
+    reportError("Could not open file \"" + fileName + "\" for writing.");
+  fputs(magic, _file);
+}
+
+void SliceFile::openForReading(const string& fileName, const char* magic,
+                               const char* description) {
+  open(fileName, "rb", magic, description);
+}
+
+void SliceFile::openForUpdating(const string& fileName, const char* magic,
+                                const char* description) {
+  open(fileName, "r+b", magic, description);
+}
+
+void SliceFile::beginWriting() {
+  ASSERT(_file != 0 && !_writing);
+  // The C standard requires a seek between reading and writing.
+  if (fseek(_file, 0, SEEK_CUR) != 0)
+    reportError("Could not write to file \"" + _fileName + "\".");
+  _writing = true;
+}
+
+void SliceFile::flush() {
+  ASSERT(_file != 0 && _writing);
+  if (fflush(_file) != 0 || ferror(_file) != 0)
+    reportError("Could not write to file \"" + _fileName + "\".");
+}
+
+void SliceFile::close() {
+  ASSERT(_file != 0);
+  const bool failed = _writing && ferror(_file) != 0;
+  const bool closeFailed = fclose(_file) != 0;
+  _file = 0;
+  if (_writing && (failed || closeFailed))
+    reportError("Could not write to file \"" + _fileName + "\".");
+}
+
+void SliceFile::writeWord(size_t word) {
+  ASSERT(_file != 0 && _writing);
+  if (word > 0xFFFFFFFFul)
+    reportError("A number is too large to be written to the file \"" +
+                _fileName + "\".");
+  for (size_t byte = 0; byte < 4; ++byte)
+    fputc(static_cast<int>((word >> (8 * byte)) & 0xFF), _file);
+}
+
+void SliceFile::writeTerm(const Exponent* term, size_t varCount) {
+  for (size_t var = 0; var < varCount; ++var)
+    writeWord(term[var]);
+}
+
+void SliceFile::writeIdeal(const Ideal& ideal) {
+  writeWord(ideal.getGeneratorCount());
+  Ideal::const_iterator stop = ideal.end();
+  for (Ideal::const_iterator it = ideal.begin(); it != stop; ++it)
+    writeTerm(*it, ideal.getVarCount());
+}
+
+void SliceFile::writeInteger(const mpz_class& integer) {
+  const string str = integer.get_str(16);
+  writeWord(str.size());
+  fwrite(str.data(), 1, str.size(), _file);
+}
+
+void SliceFile::writeSlice(const Slice& slice) {
+  writeIdeal(slice.getIdeal());
+  writeIdeal(slice.getSubtract());
+  writeTerm(slice.getMultiply().begin(), slice.getVarCount());
+}
+
+unsigned int SliceFile::readWord() {
+  ASSERT(_file != 0 && !_writing);
+  unsigned int word = 0;
+  for (size_t byte = 0; byte < 4; ++byte) {
+    const int c = getc(_file);
+    if (c == EOF)
+      reportCorrupt();
+    word |= static_cast<unsigned int>(c) << (8 * byte);
+  }
+  return word;
+}
+
+void SliceFile::readTerm(Term& term) {
+  for (size_t var = 0; var < term.getVarCount(); ++var)
+    term[var] = readWord();
+}
+
+void SliceFile::readIdeal(Ideal& ideal, Term& tmp) {
+  ASSERT(tmp.getVarCount() == ideal.getVarCount());
+  ideal.clear();
+  const size_t generatorCount = readWord();
+  for (size_t i = 0; i < generatorCount; ++i) {
+    readTerm(tmp);
+    ideal.insert(tmp);
+  }
+}
+
+void SliceFile::readInteger(mpz_class& integer) {
+  const size_t size = readWord();
+  string str(size, ' ');
+  if (size > 0 && fread(&str[0], 1, size, _file) != size)
+    reportCorrupt();
+  if (integer.set_str(str, 16) != 0)
+    reportCorrupt();
+}
+
+void SliceFile::readSlice(Ideal& ideal, Ideal& subtract, Term& multiply) {
+  readIdeal(ideal, multiply);
+  readIdeal(subtract, multiply);
+  readTerm(multiply);
+}
+
+unsigned int SliceFile::hashIdeal(const Ideal& ideal) {
+  // This is the 32 bit FNV-1a hash, taken over the exponents.
+  unsigned int hash = 2166136261u;
+  hash = (hash ^ static_cast<unsigned int>(ideal.getVarCount())) * 16777619u;
+  hash = (hash ^ static_cast<unsigned int>(ideal.getGeneratorCount())) *
+    16777619u;
+  Ideal::const_iterator stop = ideal.end();
+  for (Ideal::const_iterator it = ideal.begin(); it != stop; ++it)
+    for (size_t var = 0; var < ideal.getVarCount(); ++var)
+      hash = (hash ^ (*it)[var]) * 16777619u;
+  return hash & 0xFFFFFFFFu;
+}
+
+void SliceFile::replaceFile(const string& from, const string& to) {
+  // Some platforms do not let rename replace an existing file.
+  if (rename(from.c_str(), to.c_str()) != 0) {
+    remove(to.c_str());
+    if (rename(from.c_str(), to.c_str()) != 0)
+      reportError("Could not rename file \"" + from +
+                  "\" to \"" + to + "\".");
+  }
+}
+
+void SliceFile::open(const string& fileName, const char* mode,
+                     const char* magic, const char* description) {
+  ASSERT(_file == 0);
+  _fileName = fileName;
+  _writing = false;
+  _file = fopen(fileName.c_str(), mode);
+  if (_file == 0)
+    reportError("Could not open file \"" + fileName + "\" for reading.");
+
+  const size_t magicSize = strlen(magic);
+  vector<char> read(magicSize);
+  if (fread(&read[0], 1, magicSize, _file) != magicSize ||
+      memcmp(&read[0], magic, magicSize) != 0)
+    reportError("The file \"" + fileName + "\" is not a " +
+                description + " file.");
+}
+
+void SliceFile::reportCorrupt() {
+  reportError("The file \"" + _fileName + "\" is truncated or corrupt.");
+}
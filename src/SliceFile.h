@@ -0,0 +1,110 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SLICE_FILE_GUARD
+#define SLICE_FILE_GUARD
+
+#include <string>
+#include <cstdio>
+
+class Ideal;
+class Term;
+class Slice;
+
+/** A binary file that stores terms, ideals and the state of slices,
+ such as the checkpoints of SliceCheckpoint and the shards of
+ SliceShards. Numbers are stored as 32 bit little endian so that the
+ files do not depend on the platform. Every file begins with a line of
+ text that identifies what kind of file it is.
+
+ Errors are reported through reportError. The file is closed when the
+ SliceFile is destructed. */
+class SliceFile {
+ public:
+  SliceFile();
+  ~SliceFile();
+
+  /** Creates the file fileName and writes magic to it. */
+  void openForWriting(const string& fileName, const char* magic);
+
+  /** Opens the file fileName and checks that it begins with
+   magic. description names the kind of file in error messages. */
+  void openForReading(const string& fileName, const char* magic,
+                      const char* description);
+
+  /** Opens the file fileName like openForReading, but so that it can
+   also be written to after calling beginWriting. */
+  void openForUpdating(const string& fileName, const char* magic,
+                       const char* description);
+
+  /** Switches a file opened with openForUpdating from reading to
+   writing. What has been read is kept and the rest of the file is
+   overwritten. */
+  void beginWriting();
+
+  /** Passes what has been written to the operating system, so that it
+   is in the file even if Frobby is stopped. */
+  void flush();
+
+  /** Closes the file. Reports an error if writing it failed. */
+  void close();
+
+  const string& getFileName() const {return _fileName;}
+
+  void writeWord(size_t word);
+  void writeTerm(const Exponent* term, size_t varCount);
+  void writeIdeal(const Ideal& ideal);
+  void writeInteger(const mpz_class& integer);
+
+  /** Writes the ideal, subtract and multiply of slice. */
+  void writeSlice(const Slice& slice);
+
+  unsigned int readWord();
+  void readTerm(Term& term);
+
+  /** Reads an ideal into ideal, which must have the right number of
+   variables. tmp is used as temporary storage. */
+  void readIdeal(Ideal& ideal, Term& tmp);
+  void readInteger(mpz_class& integer);
+
+  /** Reads the state of a slice written by writeSlice. */
+  void readSlice(Ideal& ideal, Ideal& subtract, Term& multiply);
+
+  /** Returns a hash of the generators of ideal in order. This is
+   written to files to check that they are used with the same input
+   as they were written for. */
+  static unsigned int hashIdeal(const Ideal& ideal);
+
+  /** Renames the file from to to, replacing to if it exists. Writing
+   to a temporary file and then renaming it ensures that to is never
+   left half written. */
+  static void replaceFile(const string& from, const string& to);
+
+ private:
+  /** Opens fileName with the given fopen mode and checks that it
+   begins with magic. */
+  void open(const string& fileName, const char* mode,
+            const char* magic, const char* description);
+
+  void reportCorrupt();
+
+  FILE* _file;
+  string _fileName;
+  bool _writing;
+};
+
+#endif
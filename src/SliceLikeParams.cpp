@@ -19,13 +19,18 @@
 #include "SliceLikeParams.h"
 
 #include "CliParams.h"
+#include "TreeTrace.h"
+#include "ProgressMeter.h"
+#include "display.h"
 
 SliceLikeParams::SliceLikeParams():
-  _useSimplification(true) {
+  _useSimplification(true),
+  _useSquareFree(true) {
 }
 
 namespace {
   static const char* UseSimplificationName = "simplify";
+  static const char* UseSquareFreeName = "squareFree";
 }
 
 void addSliceLikeParams(CliParams& params) {
@@ -34,4 +39,25 @@ void addSliceLikeParams(CliParams& params) {
 void extractCliValues(SliceLikeParams& slice, const CliParams& cli) {
   extractCliValues(static_cast<CommonParams&>(slice), cli);
   slice.useSimplification(getBool(cli, UseSimplificationName));
+  if (cli.hasParam(UseSquareFreeName))
+    slice.useSquareFree(getBool(cli, UseSquareFreeName));
+}
+
+void noteOptionsBypassedBySquareFree(bool splitGiven) {
+  vector<string> bypassed;
+  if (splitGiven)
+    bypassed.push_back("-split");
+  if (TreeTrace::getSingleton().isEnabled())
+    bypassed.push_back("-trace");
+  if (ProgressMeter::getSingleton().isEnabled())
+    bypassed.push_back("-progress");
+  if (bypassed.empty())
+    return;
+
+  string options = bypassed[0];
+  for (size_t i = 1; i < bypassed.size(); ++i)
+    options += (i + 1 == bypassed.size() ? " and " : ", ") + bypassed[i];
+  displayNote("The input ideal is square free, so it is handled by the\n"
+              "algorithms for square free ideals, which ignore " + options +
+              ".\nUse -squareFree off to use the general algorithms instead.");
 }
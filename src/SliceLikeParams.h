@@ -32,11 +32,22 @@ class SliceLikeParams : public CommonParams {
   bool getUseSimplification() const {return _useSimplification;}
   void useSimplification(bool value) {_useSimplification = value;}
 
+  /** Use algorithms specialized to square free ideals when the ideal
+      is square free. */
+  bool getUseSquareFree() const {return _useSquareFree;}
+  void useSquareFree(bool value) {_useSquareFree = value;}
+
  private:
   bool _useSimplification;
+  bool _useSquareFree;
 };
 
 void addSliceLikeParams(CliParams& params);
 void extractCliValues(SliceLikeParams& slice, const CliParams& cli);
 
+/** Displays a note if -split, -trace or -progress was given even
+ though it has no effect, since the ideal is handled by the algorithms
+ for square free ideals. splitGiven tells if -split was given. */
+void noteOptionsBypassedBySquareFree(bool splitGiven);
+
 #endif
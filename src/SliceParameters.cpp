@@ -24,7 +24,10 @@
 
 SliceParameters::SliceParameters(bool exposeBoundParam,
                                  bool exposeIndependenceParam,
-                                 bool supportBigattiAlgorithm):
+                                 bool supportBigattiAlgorithm,
+                                 bool exposeCheckpointParams,
+                                 bool exposeShardParams,
+                                 bool exposeSquareFreeParam):
   _exposeBoundParam(exposeBoundParam),
   _exposeIndependenceParam(exposeIndependenceParam),
 
@@ -61,6 +64,12 @@ SliceParameters::SliceParameters(bool exposeBoundParam,
    "Perform simplification when possible.",
    true),
 
+  _useSquareFree
+  ("squareFree",
+   "Use algorithms specialized to square free ideals when the input ideal\n"
+   "is square free.",
+   true),
+
   _minimal
   ("minimal",
    "Specifies that the input ideal is minimally generated by the given "
@@ -90,15 +99,70 @@ SliceParameters::SliceParameters(bool exposeBoundParam,
   _split
   ("split",
    "The split selection strategy to use. Slice options are maxlabel, minlabel,\n"
-   "varlabel, minimum, median, maximum, mingen, indep and gcd. Optimization\n"
-   "computations support the specialized strategy degree as well.",
-   "median") {
+   "varlabel, minimum, median, maximum, mingen, indep, gcd and auto. The\n"
+   "strategy auto chooses among minimum and median based on the input.\n"
+   "Optimization computations support the specialized strategy degree as\n"
+   "well.",
+   "median"),
+
+  _checkpoint
+  ("checkpoint",
+   "Periodically save the state of the computation to the given file, so\n"
+   "that the computation can be resumed with -resume if it is interrupted.\n"
+   "The file is deleted when the computation is done. The output produced\n"
+   "so far is saved to the file with the suffix .output added. Independence\n"
+   "splits are not performed when this option is given.",
+   ""),
+
+  _checkpointInterval
+  ("checkpointInterval",
+   "The number of seconds between saving the state of the computation\n"
+   "when -checkpoint is given.",
+   600),
+
+  _resume
+  ("resume",
+   "Resume the computation saved in the file given by -checkpoint. The\n"
+   "input must be the same as for the computation that was saved. The\n"
+   "output is the same as if the computation had not been interrupted.",
+   false),
+
+  _shards
+  ("shards",
+   "Split the computation into this many shards that are solved by\n"
+   "separate processes. This lets the computation use several cores or\n"
+   "machines. The value 0 turns this off.",
+   0),
+
+  _shardPrefix
+  ("shardPrefix",
+   "The prefix of the names of the files that store the shards and their\n"
+   "results. Shard i is stored in PREFIX.i and its result in PREFIX.i.out.",
+   "frobbyShard"),
+
+  _shardFrontier
+  ("shardFrontier",
+   "The number of slices to split the computation into before\n"
+   "distributing them among the shards. The value 0 uses 16 slices per\n"
+   "shard.",
+   0),
+
+  _shardStep
+  ("shardStep",
+   "Which steps of a sharded computation to carry out. The option all\n"
+   "solves the shards using local processes. The option split only writes\n"
+   "the shard files, which can then be solved using the action solveshard,\n"
+   "for example on other machines. The option merge outputs the combined\n"
+   "result of the solved shards.",
+   "all") {
   addParameter(&_minimal);
   addParameter(&_split);
   addParameter(&_printStatistics);
   if (exposeIndependenceParam)
     addParameter(&_useIndependence);
   addParameter(&_useSimplification);
+  if (exposeSquareFreeParam)
+    addParameter(&_useSquareFree);
   addParameter(&_printDebug);
   if (_exposeBoundParam) {
     addParameter(&_useBoundSimplification);
@@ -106,6 +170,19 @@ SliceParameters::SliceParameters(bool exposeBoundParam,
   }
   addParameter(&_canonical);
 
+  if (exposeCheckpointParams) {
+    addParameter(&_checkpoint);
+    addParameter(&_checkpointInterval);
+    addParameter(&_resume);
+  }
+
+  if (exposeShardParams) {
+    addParameter(&_shards);
+    addParameter(&_shardPrefix);
+    addParameter(&_shardFrontier);
+    addParameter(&_shardStep);
+  }
+
   if (supportBigattiAlgorithm) {
     addParameter(&_useBigattiGeneric);
     addParameter(&_widenPivot);
@@ -116,6 +193,8 @@ SliceParameters::SliceParameters(bool exposeBoundParam,
       (" Slice algorithm only.");
     _useIndependence.appendToDescription
       (" Slice algorithm only.");
+    _shards.appendToDescription
+      ("\nSlice algorithm only.");
     _minimal.appendToDescription
       ("\nSlice algorithm only.");
     _canonical.appendToDescription
@@ -20,6 +20,7 @@
 #include "ParameterGroup.h"
 #include "BoolParameter.h"
 #include "StringParameter.h"
+#include "IntegerParameter.h"
 
 class SliceFacade;
 class BigattiFacade;
@@ -40,10 +41,19 @@ class SliceParameters : public ParameterGroup {
    @param exposeIndependenceParam Make available the parameter to turn
      independence splits on or off.
    @param supportBigattiAlgorithm Adjust messages
+   @param exposeCheckpointParams Make available the parameters for
+     writing checkpoints and resuming from them.
+   @param exposeShardParams Make available the parameters for
+     splitting the computation into shards solved by other processes.
+   @param exposeSquareFreeParam Make available the parameter to turn
+     the algorithms for square free ideals on or off.
   */
   SliceParameters(bool exposeBoundParams = false,
                   bool exposeIndependenceParam = true,
-                  bool supportBigattiAlgorithm = false);
+                  bool supportBigattiAlgorithm = false,
+                  bool exposeCheckpointParams = false,
+                  bool exposeShardParams = false,
+                  bool exposeSquareFreeParam = false);
 
   /** Set the value of the independence split option. This is useful
    for setting the default value before parsing the user-supplied
@@ -97,12 +107,22 @@ class SliceParameters : public ParameterGroup {
   BoolParameter _useBoundSimplification;
   BoolParameter _useIndependence;
   BoolParameter _useSimplification;
+  BoolParameter _useSquareFree;
   BoolParameter _minimal;
   BoolParameter _canonical;
   BoolParameter _useBigattiGeneric;
   BoolParameter _widenPivot;
 
   StringParameter _split;
+
+  StringParameter _checkpoint;
+  IntegerParameter _checkpointInterval;
+  BoolParameter _resume;
+
+  IntegerParameter _shards;
+  StringParameter _shardPrefix;
+  IntegerParameter _shardFrontier;
+  StringParameter _shardStep;
 };
 
 #endif
@@ -24,16 +24,30 @@
 
 SliceParams::SliceParams():
   _split("median"),
+  _splitGiven(false),
   _useIndependence(true),
   _useBoundElimination(true),
-  _useBoundSimplification(true) {
+  _useBoundSimplification(true),
+  _checkpointInterval(600),
+  _resume(false),
+  _shardCount(0),
+  _shardPrefix("frobbyShard"),
+  _shardFrontier(0),
+  _shardStep("all") {
 }
 
 SliceParams::SliceParams(const CliParams& cli):
   _split("median"),
+  _splitGiven(false),
   _useIndependence(true),
   _useBoundElimination(true),
-  _useBoundSimplification(true) {
+  _useBoundSimplification(true),
+  _checkpointInterval(600),
+  _resume(false),
+  _shardCount(0),
+  _shardPrefix("frobbyShard"),
+  _shardFrontier(0),
+  _shardStep("all") {
   extractCliValues(*this, cli);
 }
 
@@ -42,6 +56,13 @@ namespace {
   const char* UseIndependenceName = "independence";
   const char* UseBoundElimination = "bound";
   const char* UseBoundSimplification = "boundSimplify";
+  const char* CheckpointFileName = "checkpoint";
+  const char* CheckpointIntervalName = "checkpointInterval";
+  const char* ResumeName = "resume";
+  const char* ShardCountName = "shards";
+  const char* ShardPrefixName = "shardPrefix";
+  const char* ShardFrontierName = "shardFrontier";
+  const char* ShardStepName = "shardStep";
 }
 
 void addSliceParams(CliParams& params) {
@@ -50,12 +71,27 @@ void addSliceParams(CliParams& params) {
 void extractCliValues(SliceParams& slice, const CliParams& cli) {
   extractCliValues(static_cast<SliceLikeParams&>(slice), cli);
   slice.setSplit(getString(cli, SplitParamName));
+  slice.setSplitGiven(cli.getParam(SplitParamName).wasGiven());
   if (cli.hasParam(UseIndependenceName))
     slice.useIndependenceSplits(getBool(cli, UseIndependenceName));
   if (cli.hasParam(UseBoundElimination))
     slice.useBoundElimination(getBool(cli, UseBoundElimination));
   if (cli.hasParam(UseBoundSimplification))
     slice.useBoundElimination(getBool(cli, UseBoundSimplification));
+  if (cli.hasParam(CheckpointFileName))
+    slice.setCheckpointFile(getString(cli, CheckpointFileName));
+  if (cli.hasParam(CheckpointIntervalName))
+    slice.setCheckpointInterval(getInt(cli, CheckpointIntervalName));
+  if (cli.hasParam(ResumeName))
+    slice.setResume(getBool(cli, ResumeName));
+  if (cli.hasParam(ShardCountName))
+    slice.setShardCount(getInt(cli, ShardCountName));
+  if (cli.hasParam(ShardPrefixName))
+    slice.setShardPrefix(getString(cli, ShardPrefixName));
+  if (cli.hasParam(ShardFrontierName))
+    slice.setShardFrontier(getInt(cli, ShardFrontierName));
+  if (cli.hasParam(ShardStepName))
+    slice.setShardStep(getString(cli, ShardStepName));
 }
 
 void validateSplit(const SliceParams& params,
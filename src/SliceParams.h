@@ -30,6 +30,11 @@ class SliceParams : public SliceLikeParams {
   const string& getSplit() const {return _split;}
   void setSplit(const string& name) {_split = name;}
 
+  /** Returns true if the split strategy was given explicitly instead
+   of being left at the default. */
+  bool isSplitGiven() const {return _splitGiven;}
+  void setSplitGiven(bool value) {_splitGiven = value;}
+
   bool getUseIndependenceSplits() const {return _useIndependence;}
   void useIndependenceSplits(bool value) {_useIndependence = value;}
 
@@ -44,11 +49,55 @@ class SliceParams : public SliceLikeParams {
   bool getUseBoundSimplification() const {return _useBoundSimplification;}
   void useBoundSimplification(bool value) {_useBoundSimplification = value;}
 
+  /** Returns the file to write checkpoints of the computation to, or
+   the empty string if no checkpoints are to be written. */
+  const string& getCheckpointFile() const {return _checkpointFile;}
+  void setCheckpointFile(const string& name) {_checkpointFile = name;}
+
+  /** Returns the number of seconds between checkpoints. */
+  unsigned int getCheckpointInterval() const {return _checkpointInterval;}
+  void setCheckpointInterval(unsigned int seconds) {
+    _checkpointInterval = seconds;
+  }
+
+  /** Returns whether to resume the computation saved in the
+   checkpoint file instead of starting from the beginning. */
+  bool getResume() const {return _resume;}
+  void setResume(bool value) {_resume = value;}
+
+  /** Returns the number of shards to split the computation into, or
+   zero if it is not to be split. See SliceShards. */
+  size_t getShardCount() const {return _shardCount;}
+  void setShardCount(size_t count) {_shardCount = count;}
+
+  /** Returns the prefix of the names of the shard files. */
+  const string& getShardPrefix() const {return _shardPrefix;}
+  void setShardPrefix(const string& prefix) {_shardPrefix = prefix;}
+
+  /** Returns the number of slices to expand the slice tree to before
+   distributing them among the shards. Zero means a default that
+   depends on the number of shards. */
+  size_t getShardFrontier() const {return _shardFrontier;}
+  void setShardFrontier(size_t size) {_shardFrontier = size;}
+
+  /** Returns which steps of a sharded computation to carry out. The
+   options are all, split and merge. */
+  const string& getShardStep() const {return _shardStep;}
+  void setShardStep(const string& step) {_shardStep = step;}
+
  private:
   string _split;
+  bool _splitGiven;
   bool _useIndependence;
   bool _useBoundElimination;
   bool _useBoundSimplification;
+  string _checkpointFile;
+  unsigned int _checkpointInterval;
+  bool _resume;
+  size_t _shardCount;
+  string _shardPrefix;
+  size_t _shardFrontier;
+  string _shardStep;
 };
 
 void addIdealParams(CliParams& params);
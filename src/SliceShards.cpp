@@ -0,0 +1,334 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SliceShards.h"
+
+#include "MsmStrategy.h"
+#include "HilbertStrategy.h"
+#include "SplitStrategy.h"
+#include "Slice.h"
+#include "Ideal.h"
+#include "Term.h"
+#include "FrobbyStringStream.h"
+#include "display.h"
+#include "error.h"
+#include "Parallel.h"
+#include <algorithm>
+
+// MinGW defines __GNUC__ but does not have fork.
+#if defined(__GNUC__) && !defined(__MINGW32__)
+#define FROBBY_HAS_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+namespace {
+  /** Every shard file begins with this. The number at the end is the
+   version of the format. */
+  const char* ShardMagic = "Frobby slice shard 1\n";
+
+  /** Every result file begins with this. */
+  const char* ResultMagic = "Frobby slice shard result 1\n";
+
+  /** Orders slices by decreasing number of generators. */
+  class LargerSlice {
+  public:
+    LargerSlice(const vector<Slice*>& slices): _slices(slices) {}
+    bool operator()(size_t a, size_t b) const {
+      return _slices[a]->getIdeal().getGeneratorCount() >
+        _slices[b]->getIdeal().getGeneratorCount();
+    }
+  private:
+    const vector<Slice*>& _slices;
+  };
+
+  void solveWithStrategy(SliceStrategyCommon& strategy,
+                         const SliceParams& params,
+                         SliceFile& in, size_t varCount) {
+    strategy.setUseIndependence(params.getUseIndependenceSplits());
+    strategy.setUseSimplification(params.getUseSimplification());
+    strategy.runSlices(in, in.readWord(), varCount);
+  }
+
+#ifdef FROBBY_HAS_FORK
+  /** Solves the shard in the current process, which is a worker, and
+   then exits the process. */
+  void runWorker(const string& shardFileName, const SliceParams& params) {
+    int status = 0;
+    try {
+      SliceShards::solveShard(shardFileName, params);
+    } catch (const std::exception& e) {
+      displayException(e);
+      status = 1;
+    } catch (...) {
+      status = 1;
+    }
+    fflush(0);
+    _exit(status);
+  }
+#endif
+}
+
+SliceShards::SliceShards(const SliceParams& params):
+  _params(params),
+  _prefix(params.getShardPrefix()),
+  _shardCount(params.getShardCount()),
+  _frontierSize(params.getShardFrontier()) {
+  if (_shardCount == 0)
+    reportError("The number of shards must be positive.");
+  if (_prefix.empty())
+    reportError("The prefix of the shard file names must not be empty.");
+  if (_frontierSize == 0)
+    _frontierSize = 16 * _shardCount;
+  if (_frontierSize < _shardCount)
+    _frontierSize = _shardCount;
+
+  const string& step = params.getShardStep();
+  if (step == "all")
+    _step = AllSteps;
+  else if (step == "split")
+    _step = SplitStep;
+  else if (step == "merge")
+    _step = MergeStep;
+  else
+    reportError("Unknown shard step \"" + step +
+                "\". Options are all, split and merge.");
+}
+
+string SliceShards::getShardFileName(size_t shard) const {
+  ASSERT(shard < _shardCount);
+  FrobbyStringStream name;
+  name << _prefix << '.' << shard;
+  return name;
+}
+
+string SliceShards::getRootResultFileName() const {
+  return getResultFileName(_prefix + ".root");
+}
+
+string SliceShards::getResultFileName(const string& shardFileName) {
+  return shardFileName + ".out";
+}
+
+void SliceShards::writeShards(Kind kind, const Ideal& input,
+                              const vector<Slice*>& slices) {
+  // Assign each slice to the shard that has the fewest generators so
+  // far, taking the largest slices first.
+  vector<size_t> order(slices.size());
+  for (size_t i = 0; i < slices.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), LargerSlice(slices));
+
+  vector<vector<const Slice*> > shards(_shardCount);
+  vector<size_t> load(_shardCount);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const Slice* slice = slices[order[i]];
+    const size_t shard =
+      std::min_element(load.begin(), load.end()) - load.begin();
+    shards[shard].push_back(slice);
+    load[shard] += slice->getIdeal().getGeneratorCount() + 1;
+  }
+
+  const unsigned int hash = SliceFile::hashIdeal(input);
+  for (size_t shard = 0; shard < _shardCount; ++shard) {
+    SliceFile out;
+    out.openForWriting(getShardFileName(shard), ShardMagic);
+    out.writeWord(kind);
+    out.writeWord(input.getVarCount());
+    out.writeWord(hash);
+    out.writeWord(shards[shard].size());
+    for (size_t i = 0; i < shards[shard].size(); ++i)
+      out.writeSlice(*shards[shard][i]);
+    out.close();
+  }
+}
+
+void SliceShards::runLocalWorkers() {
+#ifdef FROBBY_HAS_FORK
+  // Only the forking thread exists in the child, so a child of a
+  // process with OpenMP threads can deadlock on a lock that one of the
+  // missing threads held. The parallel parts of Frobby have run by now.
+  if (getMaxThreadCount() > 1) {
+    removeFiles();
+    reportError("Shards can only be solved as local processes when Frobby\n"
+                "runs on a single thread. Set OMP_NUM_THREADS to 1, or use\n"
+                "-shardStep split, solve each shard using the action\n"
+                "solveshard and then use -shardStep merge.");
+  }
+
+  // Buffered output would otherwise be written by each worker too.
+  fflush(0);
+
+  vector<pid_t> workers;
+  bool failed = false;
+  for (size_t shard = 0; shard < _shardCount; ++shard) {
+    const pid_t pid = fork();
+    if (pid == 0)
+      runWorker(getShardFileName(shard), _params);
+    if (pid == -1) {
+      failed = true;
+      break;
+    }
+    workers.push_back(pid);
+  }
+
+  for (size_t i = 0; i < workers.size(); ++i) {
+    int status;
+    if (waitpid(workers[i], &status, 0) == -1 ||
+        !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      failed = true;
+  }
+
+  if (failed) {
+    removeFiles();
+    reportError("A worker process failed to solve its shard.");
+  }
+#else
+  reportError("Running shards as local processes is not supported on this\n"
+              "platform. Use -shardStep split, solve each shard using the\n"
+              "action solveshard and then use -shardStep merge.");
+#endif
+}
+
+void SliceShards::mergeResults(const Ideal& input, TermConsumer& consumer) {
+  mergeResults(input, IdealKind, &consumer, 0);
+}
+
+void SliceShards::mergeResults(const Ideal& input,
+                               CoefTermConsumer& consumer) {
+  mergeResults(input, PolynomialKind, 0, &consumer);
+}
+
+void SliceShards::mergeResults(const Ideal& input, Kind kind,
+                               TermConsumer* consumer,
+                               CoefTermConsumer* coefConsumer) {
+  mergeResult(getRootResultFileName(), input, kind, consumer, coefConsumer);
+  for (size_t shard = 0; shard < _shardCount; ++shard)
+    mergeResult(getResultFileName(getShardFileName(shard)),
+                input, kind, consumer, coefConsumer);
+}
+
+void SliceShards::mergeResult(const string& fileName, const Ideal& input,
+                              Kind kind, TermConsumer* consumer,
+                              CoefTermConsumer* coefConsumer) {
+  SliceFile in;
+  in.openForReading(fileName, ResultMagic, "shard result");
+  if (in.readWord() != static_cast<unsigned int>(kind) ||
+      in.readWord() != input.getVarCount() ||
+      in.readWord() != SliceFile::hashIdeal(input))
+    reportError("The shard result file \"" + fileName +
+                "\" was written for a different input or action,\n"
+                "or with a different value of -canon.");
+
+  Term term(input.getVarCount());
+  mpz_class coef;
+  while (in.readWord() != 0) {
+    if (kind == PolynomialKind) {
+      in.readInteger(coef);
+      in.readTerm(term);
+      coefConsumer->consume(coef, term);
+    } else {
+      in.readTerm(term);
+      consumer->consume(term);
+    }
+  }
+  in.close();
+}
+
+void SliceShards::removeFiles() {
+  remove(getRootResultFileName().c_str());
+  for (size_t shard = 0; shard < _shardCount; ++shard) {
+    const string shardFileName = getShardFileName(shard);
+    remove(shardFileName.c_str());
+    remove(getResultFileName(shardFileName).c_str());
+  }
+}
+
+void SliceShards::solveShard(const string& shardFileName,
+                             const SliceParams& params) {
+  SliceFile in;
+  in.openForReading(shardFileName, ShardMagic, "shard");
+  const unsigned int kind = in.readWord();
+  const size_t varCount = in.readWord();
+  const unsigned int hash = in.readWord();
+  if (kind != IdealKind && kind != PolynomialKind)
+    reportError("The shard file \"" + shardFileName + "\" is corrupt.");
+
+  auto_ptr<SplitStrategy> split =
+    SplitStrategy::createStrategy(params.getSplit().c_str());
+  ASSERT(split.get() != 0);
+
+  ResultWriter writer(getResultFileName(shardFileName),
+                      static_cast<Kind>(kind), varCount, hash);
+  if (kind == IdealKind) {
+    MsmStrategy strategy(&writer, split.get());
+    solveWithStrategy(strategy, params, in, varCount);
+  } else {
+    if (!split->isPivotSplit())
+      reportError("Label split strategy is not appropriate "
+                  "in this context.");
+    HilbertStrategy strategy(&writer, split.get());
+    solveWithStrategy(strategy, params, in, varCount);
+  }
+  in.close();
+  writer.close();
+}
+
+SliceShards::ResultWriter::ResultWriter(const string& fileName, Kind kind,
+                                        size_t varCount,
+                                        unsigned int inputHash):
+  _fileName(fileName),
+  _kind(kind),
+  _varCount(varCount) {
+  _file.openForWriting(_fileName + ".tmp", ResultMagic);
+  _file.writeWord(kind);
+  _file.writeWord(varCount);
+  _file.writeWord(inputHash);
+}
+
+void SliceShards::ResultWriter::consumeRing(const VarNames& names) {
+}
+
+void SliceShards::ResultWriter::beginConsuming() {
+}
+
+void SliceShards::ResultWriter::consume(const Term& term) {
+  ASSERT(_kind == IdealKind);
+  ASSERT(term.getVarCount() == _varCount);
+  _file.writeWord(1);
+  _file.writeTerm(term.begin(), _varCount);
+}
+
+void SliceShards::ResultWriter::consume(const mpz_class& coef,
+                                        const Term& term) {
+  ASSERT(_kind == PolynomialKind);
+  ASSERT(term.getVarCount() == _varCount);
+  _file.writeWord(1);
+  _file.writeInteger(coef);
+  _file.writeTerm(term.begin(), _varCount);
+}
+
+void SliceShards::ResultWriter::doneConsuming() {
+}
+
+void SliceShards::ResultWriter::close() {
+  _file.writeWord(0);
+  _file.close();
+  SliceFile::replaceFile(_fileName + ".tmp", _fileName);
+}
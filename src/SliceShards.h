@@ -0,0 +1,131 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SLICE_SHARDS_GUARD
+#define SLICE_SHARDS_GUARD
+
+#include "TermConsumer.h"
+#include "CoefTermConsumer.h"
+#include "SliceFile.h"
+#include "SliceParams.h"
+#include <string>
+#include <vector>
+
+class Ideal;
+class Slice;
+
+/** Splits a run of the Slice Algorithm into shards that are solved by
+ separate processes, and merges the results.
+
+ The slice tree is expanded until there is a frontier of at least
+ getFrontierSize() slices. The output produced while doing so is
+ written to the root result file, and the frontier slices are
+ distributed among getShardCount() shard files so that the shards have
+ about the same total number of generators. Each shard is then solved
+ by a worker process that writes a result file, and finally the
+ results are merged by passing them on to the consumer of the
+ original run. For decompositions this concatenates the outputs, and
+ for Hilbert-Poincare series the terms of the polynomials are passed on
+ so that the consumer adds them up.
+
+ The steps can be run one at a time, which allows the workers to be
+ run on other machines by a batch scheduler: SplitStep writes the shard
+ files, the action solveshard solves one shard and MergeStep merges the
+ results. AllSteps runs the workers as local processes.
+
+ The files include a hash of the input so that results are not merged
+ into a run on another input. */
+class SliceShards {
+ public:
+  enum Step {AllSteps, SplitStep, MergeStep};
+
+  /** Whether a shard comes from a computation of a decomposition or
+   of a Hilbert-Poincare series. */
+  enum Kind {IdealKind = 0, PolynomialKind = 1};
+
+  /** Reads the sharding options from params. Reports an error if they
+   are invalid. params is also used to set up the strategies of local
+   workers. */
+  SliceShards(const SliceParams& params);
+
+  Step getStep() const {return _step;}
+  size_t getShardCount() const {return _shardCount;}
+  size_t getFrontierSize() const {return _frontierSize;}
+
+  string getShardFileName(size_t shard) const;
+  string getRootResultFileName() const;
+  static string getResultFileName(const string& shardFileName);
+
+  /** Distributes slices among the shard files. */
+  void writeShards(Kind kind, const Ideal& input,
+                   const vector<Slice*>& slices);
+
+  /** Solves each shard in a separate process and waits for them to be
+   done. Reports an error if a worker fails, if processes are not
+   supported on this platform or if Frobby runs on several threads. */
+  void runLocalWorkers();
+
+  /** Passes the root result and the results of the shards on to
+   consumer. */
+  void mergeResults(const Ideal& input, TermConsumer& consumer);
+  void mergeResults(const Ideal& input, CoefTermConsumer& consumer);
+
+  /** Deletes the shard and result files. */
+  void removeFiles();
+
+  /** Solves the shard in shardFileName using the options in params
+   and writes the result file. */
+  static void solveShard(const string& shardFileName,
+                         const SliceParams& params);
+
+  /** Writes the output of a run of the Slice Algorithm to a result
+   file. The file is written under a temporary name and renamed by
+   close, so a result file is never left incomplete. */
+  class ResultWriter : public TermConsumer, public CoefTermConsumer {
+  public:
+    ResultWriter(const string& fileName, Kind kind,
+                 size_t varCount, unsigned int inputHash);
+
+    virtual void consumeRing(const VarNames& names);
+    virtual void beginConsuming();
+    virtual void consume(const Term& term);
+    virtual void consume(const mpz_class& coef, const Term& term);
+    virtual void doneConsuming();
+
+    void close();
+
+  private:
+    SliceFile _file;
+    string _fileName;
+    Kind _kind;
+    size_t _varCount;
+  };
+
+ private:
+  void mergeResult(const string& fileName, const Ideal& input, Kind kind,
+                   TermConsumer* consumer, CoefTermConsumer* coefConsumer);
+  void mergeResults(const Ideal& input, Kind kind,
+                    TermConsumer* consumer, CoefTermConsumer* coefConsumer);
+
+  SliceParams _params;
+  string _prefix;
+  size_t _shardCount;
+  size_t _frontierSize;
+  Step _step;
+};
+
+#endif
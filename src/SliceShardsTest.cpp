@@ -0,0 +1,151 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SliceShards.h"
+#include "tests.h"
+
+#include "MsmStrategy.h"
+#include "HilbertStrategy.h"
+#include "DecomRecorder.h"
+#include "CoefTermConsumer.h"
+#include "SplitStrategy.h"
+#include "Polynomial.h"
+#include "Term.h"
+#include "error.h"
+
+TEST_SUITE(SliceShards)
+
+namespace {
+  const char* Prefix = "frobbySliceShardsTest";
+
+  Ideal makeInput() {
+    Ideal ideal(3);
+    ideal.insert(Term("4 0 0"));
+    ideal.insert(Term("0 4 0"));
+    ideal.insert(Term("0 0 4"));
+    ideal.insert(Term("2 2 0"));
+    ideal.insert(Term("0 2 2"));
+    ideal.insert(Term("1 1 1"));
+    return ideal;
+  }
+
+  SliceParams makeParams(const char* step) {
+    SliceParams params;
+    params.setShardCount(3);
+    params.setShardPrefix(Prefix);
+    params.setShardFrontier(5);
+    params.setShardStep(step);
+    return params;
+  }
+
+  class PolynomialRecorder : public CoefTermConsumer {
+  public:
+    PolynomialRecorder(Polynomial& poly): _poly(poly) {}
+    virtual void consumeRing(const VarNames& names) {}
+    virtual void beginConsuming() {}
+    virtual void consume(const mpz_class& coef, const Term& term) {
+      _poly.add(coef, term);
+    }
+    virtual void doneConsuming() {}
+  private:
+    Polynomial& _poly;
+  };
+
+  void decompose(const Ideal& input, Ideal& decom, const char* step) {
+    DecomRecorder recorder(&decom);
+    auto_ptr<SplitStrategy> split = SplitStrategy::createStrategy("median");
+    MsmStrategy strategy(&recorder, split.get());
+    if (step != 0)
+      strategy.setShards
+        (auto_ptr<SliceShards>(new SliceShards(makeParams(step))));
+    strategy.run(input);
+  }
+
+  void hilbert(const Ideal& input, Polynomial& poly, const char* step) {
+    PolynomialRecorder recorder(poly);
+    auto_ptr<SplitStrategy> split = SplitStrategy::createStrategy("median");
+    HilbertStrategy strategy(&recorder, split.get());
+    if (step != 0)
+      strategy.setShards
+        (auto_ptr<SliceShards>(new SliceShards(makeParams(step))));
+    strategy.run(input);
+  }
+
+  void solveShards() {
+    SliceShards shards(makeParams("all"));
+    for (size_t shard = 0; shard < shards.getShardCount(); ++shard)
+      SliceShards::solveShard(shards.getShardFileName(shard), SliceParams());
+  }
+}
+
+TEST(SliceShards, Decomposition) {
+  const Ideal input = makeInput();
+  Ideal expected(3);
+  decompose(input, expected, 0);
+
+  Ideal split(3);
+  decompose(input, split, "split");
+  ASSERT_TRUE(split.isZeroIdeal());
+  solveShards();
+
+  Ideal merged(3);
+  decompose(input, merged, "merge");
+  SliceShards(makeParams("all")).removeFiles();
+
+  merged.sortReverseLex();
+  expected.sortReverseLex();
+  ASSERT_EQ(merged, expected);
+}
+
+TEST(SliceShards, HilbertSeries) {
+  const Ideal input = makeInput();
+  Polynomial expected(3);
+  hilbert(input, expected, 0);
+
+  Polynomial split(3);
+  hilbert(input, split, "split");
+  solveShards();
+
+  Polynomial merged(3);
+  hilbert(input, merged, "merge");
+  SliceShards(makeParams("all")).removeFiles();
+
+  merged.sortTermsReverseLex();
+  expected.sortTermsReverseLex();
+  ASSERT_EQ(merged.getTermCount(), expected.getTermCount());
+  for (size_t i = 0; i < merged.getTermCount(); ++i) {
+    ASSERT_EQ(merged.getCoef(i), expected.getCoef(i));
+    ASSERT_EQ(merged.getTerm(i), expected.getTerm(i));
+  }
+}
+
+TEST(SliceShards, WrongInput) {
+  Ideal decom(3);
+  decompose(makeInput(), decom, "split");
+  solveShards();
+
+  Ideal other = makeInput();
+  other.insert(Term("3 0 1"));
+  ASSERT_EXCEPTION(decompose(other, decom, "merge"),
+                   const FrobbyException&);
+  SliceShards(makeParams("all")).removeFiles();
+}
+
+TEST(SliceShards, UnknownStep) {
+  ASSERT_EXCEPTION(SliceShards(makeParams("foo")), const FrobbyException&);
+}
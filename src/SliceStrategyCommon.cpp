@@ -18,8 +18,11 @@
 #include "SliceStrategyCommon.h"
 #include "ElementDeleter.h"
 #include "TaskEngine.h"
+#include "TreeTrace.h"
 
 #include "Slice.h"
+#include "SliceFile.h"
+#include "Ideal.h"
 
 SliceStrategyCommon::SliceStrategyCommon(const SplitStrategy* splitStrategy):
   _split(splitStrategy),
@@ -36,6 +39,11 @@ SliceStrategyCommon::~SliceStrategyCommon() {
   }
 }
 
+void SliceStrategyCommon::disposePendingTasks() {
+  while (_tasks.getPendingTaskCount() > 0)
+    _tasks.removeNextTask()->dispose();
+}
+
 void SliceStrategyCommon::freeSlice(auto_ptr<Slice> slice) {
   ASSERT(slice.get() != 0);
   ASSERT(debugIsValidSlice(slice.get()));
@@ -52,6 +60,76 @@ void SliceStrategyCommon::setUseSimplification(bool use) {
   _useSimplification = use;
 }
 
+void SliceStrategyCommon::setShards(auto_ptr<SliceShards> shards) {
+  _shards = shards;
+}
+
+void SliceStrategyCommon::runSlices(SliceFile& file, size_t sliceCount,
+                                    size_t varCount) {
+  Ideal ideal(varCount);
+  Ideal subtract(varCount);
+  Term multiply(varCount);
+  for (size_t i = 0; i < sliceCount; ++i) {
+    file.readSlice(ideal, subtract, multiply);
+    auto_ptr<Slice> slice = makeSlice(ideal, subtract, multiply);
+    simplify(*slice);
+    _tasks.addTask(slice.release());
+  }
+  _tasks.runTasks();
+}
+
+void SliceStrategyCommon::splitIntoShards(SliceShards::Kind kind,
+                                          const Ideal& input) {
+  ASSERT(hasShards());
+  const bool useIndependence = _useIndependence;
+  _useIndependence = false;
+
+  vector<Slice*> frontier;
+  try {
+    // The largest slice is run where it is on the stack rather than
+    // being removed and added back, so the ProgressMeter sees it as
+    // the child that it is and not as another root.
+    while (_tasks.getPendingTaskCount() > 0 &&
+           _tasks.getPendingTaskCount() < _shards->getFrontierSize()) {
+      // Split the largest slice, as that is where most of the work is.
+      size_t largest = 0;
+      for (size_t i = 1; i < _tasks.getPendingTaskCount(); ++i)
+        if (getPendingSlice(i).getIdeal().getGeneratorCount() >
+            getPendingSlice(largest).getIdeal().getGeneratorCount())
+          largest = i;
+      _tasks.runPendingTask(largest);
+    }
+
+    while (_tasks.getPendingTaskCount() > 0) {
+      frontier.push_back(0);
+      Task* task = _tasks.removeNextTask();
+      ASSERT(dynamic_cast<Slice*>(task) != 0);
+      frontier.back() = static_cast<Slice*>(task);
+    }
+    _shards->writeShards(kind, input, frontier);
+  } catch (...) {
+    _useIndependence = useIndependence;
+    while (!frontier.empty()) {
+      if (frontier.back() != 0)
+        freeSlice(auto_ptr<Slice>(frontier.back()));
+      frontier.pop_back();
+    }
+    throw;
+  }
+
+  _useIndependence = useIndependence;
+  while (!frontier.empty()) {
+    freeSlice(auto_ptr<Slice>(frontier.back()));
+    frontier.pop_back();
+  }
+}
+
+Slice& SliceStrategyCommon::getPendingSlice(size_t index) const {
+  Task* task = _tasks.getPendingTask(index);
+  ASSERT(dynamic_cast<Slice*>(task) != 0);
+  return *static_cast<Slice*>(task);
+}
+
 bool SliceStrategyCommon::simplify(Slice& slice) {
   if (getUseSimplification())
     return slice.simplify();
@@ -86,10 +164,15 @@ void SliceStrategyCommon::pivotSplit(auto_ptr<Slice> slice) {
   ASSERT(!slice->getIdeal().contains(_pivotTmp));
   ASSERT(!slice->getSubtract().contains(_pivotTmp));
 
+  TreeTrace& trace = TreeTrace::getSingleton();
+  if (trace.isEnabled())
+    trace.setNodeKind(TreeTrace::PivotSplit,
+                      _pivotTmp.getFirstNonZeroExponent(),
+                      _pivotTmp.getSizeOfSupport());
+
   // Set slice2 to the inner slice.
   auto_ptr<Slice> slice2 = newSlice();
-  *slice2 = *slice;
-  slice2->innerSlice(_pivotTmp);
+  slice2->setToInnerSliceOf(*slice, _pivotTmp);
   simplify(*slice2);
 
   // Set slice to the outer slice.
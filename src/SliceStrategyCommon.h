@@ -20,6 +20,7 @@
 #include "SliceStrategy.h"
 #include "SplitStrategy.h"
 #include "TaskEngine.h"
+#include "SliceShards.h"
 
 #include <vector>
 #include <string>
@@ -27,6 +28,7 @@
 
 class Slice;
 class SplitStrategy;
+class SliceFile;
 
 /** This class adds code to the SliceStrategy base class that is
  useful for derived classes. The public interface is unchanged.
@@ -41,10 +43,26 @@ class SliceStrategyCommon : public SliceStrategy {
   virtual void setUseIndependence(bool use);
   virtual void setUseSimplification(bool use);
 
+  /** Split the run into shards that are solved by other processes
+   instead of running the whole computation in this process. See
+   SliceShards. */
+  void setShards(auto_ptr<SliceShards> shards);
+
+  /** Runs the Slice Algorithm on the sliceCount slices stored next in
+   file instead of on an ideal. The output is passed on to the
+   consumer of the strategy. This is used to solve a shard. */
+  void runSlices(SliceFile& file, size_t sliceCount, size_t varCount);
+
  protected:
   /** Simplifies slice and returns true if it changed. */
   virtual bool simplify(Slice& slice);
 
+  /** Allocate a slice of the correct type with the given state that
+   passes its output on to the consumer of the strategy. */
+  virtual auto_ptr<Slice> makeSlice(const Ideal& ideal,
+                                    const Ideal& subtract,
+                                    const Term& multiply) = 0;
+
   /** Directly allocate a slice of the correct type using new. */
   virtual auto_ptr<Slice> allocateSlice() = 0;
 
@@ -77,8 +95,30 @@ class SliceStrategyCommon : public SliceStrategy {
   /** Returns true if slices should be simplified. */
   bool getUseSimplification() const;
 
+  /** Returns true if the run is to be split into shards. */
+  bool hasShards() const {return _shards.get() != 0;}
+
+  /** Expands the pending slices until there are enough of them to
+   write the shards, and then writes them. Independence splits are
+   not performed while doing this, as their consumers cannot be
+   stored in the shard files. */
+  void splitIntoShards(SliceShards::Kind kind, const Ideal& input);
+
+  /** Returns the pending task at index of _tasks, which must be a
+   slice. */
+  Slice& getPendingSlice(size_t index) const;
+
+  /** Disposes the tasks that are still pending, which happens when a
+   run is stopped by an exception. Disposing a slice calls virtual
+   methods of the strategy, so derived classes must call this from
+   their destructor. */
+  void disposePendingTasks();
+
   const SplitStrategy* _split;
 
+  /** The shards that the run is split into, if any. */
+  auto_ptr<SliceShards> _shards;
+
   /** This keeps track of pending tasks to process. These are slices
    and other events. */
   TaskEngine _tasks;
@@ -0,0 +1,65 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SolveShardAction.h"
+
+#include "SliceShards.h"
+#include "SliceParams.h"
+#include "error.h"
+
+SolveShardAction::SolveShardAction():
+  Action
+(staticGetName(),
+ "Solve one shard of a computation split using -shardStep split.",
+ "Solve one shard of a Slice Algorithm computation that has been split\n"
+ "into shards by running irrdecom, alexdual, maxstandard or hilbert with\n"
+ "-shards N -shardStep split. The result is written to the name of the\n"
+ "shard file with .out appended. Once all shards have been solved, the\n"
+ "output of the computation is obtained by running the original\n"
+ "action on the same input with -shardStep merge.\n\n"
+ "The shards can be solved in any order and on different machines. The\n"
+ "split selection strategy and other options of the Slice Algorithm are\n"
+ "those given to this action, not those of the original action.",
+ false),
+
+  _shard
+  ("shard",
+   "The shard file to solve.",
+   ""),
+
+  _sliceParams(false, true, false, false, false) {
+}
+
+void SolveShardAction::obtainParameters(vector<Parameter*>& parameters) {
+  parameters.push_back(&_shard);
+  _sliceParams.obtainParameters(parameters);
+  Action::obtainParameters(parameters);
+}
+
+void SolveShardAction::perform() {
+  if (_shard.getValue().empty())
+    reportError("Specify the shard file to solve using -shard.");
+
+  SliceParams params(_params);
+  validateSplit(params, true, false);
+  SliceShards::solveShard(_shard.getValue(), params);
+}
+
+const char* SolveShardAction::staticGetName() {
+  return "solveshard";
+}
@@ -0,0 +1,75 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SplitChooser.h"
+
+#include "Ideal.h"
+#include "Term.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+  /** Exponents up to this value are small. */
+  const Exponent SmallExponent = 3;
+
+  /** Ideals with at least this many generators per variable have many
+   generators. */
+  const size_t ManyGeneratorsPerVar = 100;
+
+  /** Returns true if most of the positive exponents of each variable
+   are distinct. This is a cheap approximation of being generic. */
+  bool hasMostlyDistinctExponents(const Ideal& ideal) {
+    size_t positive = 0;
+    size_t distinct = 0;
+    vector<Exponent> exponents;
+    exponents.reserve(ideal.getGeneratorCount());
+    for (size_t var = 0; var < ideal.getVarCount(); ++var) {
+      exponents.clear();
+      Ideal::const_iterator stop = ideal.end();
+      for (Ideal::const_iterator it = ideal.begin(); it != stop; ++it)
+        if ((*it)[var] > 0)
+          exponents.push_back((*it)[var]);
+      std::sort(exponents.begin(), exponents.end());
+      positive += exponents.size();
+      distinct += std::unique(exponents.begin(), exponents.end()) -
+        exponents.begin();
+    }
+    return 2 * distinct >= positive;
+  }
+}
+
+SplitChooser::SplitChooser(Kind kind):
+  _kind(kind) {
+}
+
+const char* SplitChooser::choose(const Ideal& ideal) const {
+  const size_t varCount = ideal.getVarCount();
+  if (varCount == 0 || ideal.getGeneratorCount() == 0)
+    return "median";
+
+  Term lcm(varCount);
+  ideal.getLcm(lcm);
+  if (lcm.getMaxExponent() <= SmallExponent)
+    return "minimum";
+
+  if (_kind == Decomposition ||
+      ideal.getGeneratorCount() >= ManyGeneratorsPerVar * varCount ||
+      !hasMostlyDistinctExponents(ideal))
+    return "median";
+  return "minimum";
+}
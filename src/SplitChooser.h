@@ -0,0 +1,46 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SPLIT_CHOOSER_GUARD
+#define SPLIT_CHOOSER_GUARD
+
+class Ideal;
+
+/** Chooses the pivot split strategy that the split strategy auto
+ stands for in a run of the Slice Algorithm on a given ideal.
+
+ The choice is made from cheap features of the ideal. Small exponents
+ favor the minimum strategy, since then the median seldom gives a
+ different pivot and the minimum does not need to sort the
+ generators. Many generators per variable favor the median strategy,
+ as do decompositions in general. Hilbert-Poincare series of ideals
+ with few generators per variable and mostly distinct exponents are
+ computed faster using the minimum strategy. */
+class SplitChooser {
+ public:
+  enum Kind {Decomposition, HilbertSeries};
+
+  SplitChooser(Kind kind);
+
+  /** Returns the name of the pivot split strategy to use on ideal. */
+  const char* choose(const Ideal& ideal) const;
+
+ private:
+  Kind _kind;
+};
+
+#endif
@@ -0,0 +1,86 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SplitChooser.h"
+#include "tests.h"
+
+#include "Ideal.h"
+#include "Term.h"
+#include <string>
+
+TEST_SUITE(SplitChooser)
+
+namespace {
+  /** Returns an ideal with distinct exponents. */
+  Ideal makeGeneric() {
+    Ideal ideal(3);
+    ideal.insert(Term("9 0 0"));
+    ideal.insert(Term("0 9 0"));
+    ideal.insert(Term("0 0 9"));
+    ideal.insert(Term("1 2 3"));
+    ideal.insert(Term("3 1 2"));
+    ideal.insert(Term("2 3 1"));
+    return ideal;
+  }
+
+  /** Returns an ideal where most exponents are repeated. */
+  Ideal makeRepeated() {
+    Ideal ideal(4);
+    ideal.insert(Term("5 0 0 0"));
+    ideal.insert(Term("0 5 0 0"));
+    ideal.insert(Term("0 0 5 0"));
+    ideal.insert(Term("0 0 0 5"));
+    ideal.insert(Term("4 4 0 0"));
+    ideal.insert(Term("4 0 4 0"));
+    ideal.insert(Term("4 0 0 4"));
+    ideal.insert(Term("0 4 4 0"));
+    ideal.insert(Term("0 4 0 4"));
+    ideal.insert(Term("0 0 4 4"));
+    ideal.insert(Term("3 3 3 0"));
+    ideal.insert(Term("3 3 0 3"));
+    ideal.insert(Term("3 0 3 3"));
+    ideal.insert(Term("0 3 3 3"));
+    return ideal;
+  }
+
+  /** Returns an ideal with small exponents. */
+  Ideal makeSmall() {
+    Ideal ideal(3);
+    ideal.insert(Term("3 0 0"));
+    ideal.insert(Term("0 3 0"));
+    ideal.insert(Term("0 0 3"));
+    ideal.insert(Term("1 2 1"));
+    ideal.insert(Term("2 1 1"));
+    return ideal;
+  }
+
+  string choose(SplitChooser::Kind kind, const Ideal& ideal) {
+    return SplitChooser(kind).choose(ideal);
+  }
+}
+
+TEST(SplitChooser, Choose) {
+  ASSERT_EQ(choose(SplitChooser::Decomposition, makeSmall()), "minimum");
+  ASSERT_EQ(choose(SplitChooser::HilbertSeries, makeSmall()), "minimum");
+
+  ASSERT_EQ(choose(SplitChooser::Decomposition, makeGeneric()), "median");
+  ASSERT_EQ(choose(SplitChooser::HilbertSeries, makeGeneric()), "minimum");
+
+  ASSERT_EQ(choose(SplitChooser::Decomposition, makeRepeated()), "median");
+  ASSERT_EQ(choose(SplitChooser::HilbertSeries, makeRepeated()), "median");
+}
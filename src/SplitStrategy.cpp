@@ -60,6 +60,12 @@ public:
   }
 
 protected:
+  // Returns the median of the positive exponents of var among the
+  // generators of the slice. This sorts the generators by their
+  // exponent of var. The sort takes less than 1% of the time of the
+  // Slice Algorithm. A selection that leaves the order alone is not
+  // faster by itself, and it changes the order of the output and the
+  // shape of the slice tree.
   Exponent getMedianPositiveExponentOf(Slice& slice, size_t var) const {
     slice.singleDegreeSortIdeal(var);
     Ideal::const_iterator end = slice.getIdeal().end();
@@ -77,8 +83,7 @@ protected:
   mutable Term coVariableForGetBestVar;
   size_t getBestVar(const Slice& slice) const {
     Term& co = coVariableForGetBestVar;
-    co.reset(slice.getVarCount());
-    slice.getIdeal().getSupportCounts(co);
+    co = slice.getSupportCounts();
 
     const Term& lcm = slice.getLcm();
     for (size_t var = 0; var < slice.getVarCount(); ++var)
@@ -103,8 +108,7 @@ class LabelSplit : public SplitStrategyCommon {
 protected:
   mutable Term _counts;
   void setCounts(const Slice& slice) const {
-    _counts.reset(slice.getVarCount());
-    slice.getIdeal().getSupportCounts(_counts);
+    _counts = slice.getSupportCounts();
   }
 
   mutable Term _oneCounts;
@@ -261,6 +265,20 @@ public:
   }
 };
 
+/** This is the strategy that SliceFacade replaces by the strategy
+ that SplitChooser picks for the computation at hand. If it is used
+ directly, such as when solving a shard, it is the same as median. */
+class AutoSplit : public MedianSplit {
+public:
+  virtual const char* getName() const {
+    return staticGetName();
+  }
+
+  static const char* staticGetName() {
+    return "auto";
+  }
+};
+
 class IndependencePivotSplit : public MedianSplit {
 public:
   virtual const char* getName() const {
@@ -484,6 +502,7 @@ namespace {
     nameFactoryRegister<MinimumSplit>(factory);
     nameFactoryRegister<MedianSplit>(factory);
     nameFactoryRegister<MaximumSplit>(factory);
+    nameFactoryRegister<AutoSplit>(factory);
     nameFactoryRegister<MinGenSplit>(factory);
     nameFactoryRegister<IndependencePivotSplit>(factory);
     nameFactoryRegister<GcdSplit>(factory);
@@ -0,0 +1,170 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SquareFreeDecomAlg.h"
+
+#include "RawSquareFreeIdeal.h"
+#include "RawSquareFreeTerm.h"
+#include "LocalArray.h"
+#include "Cancellation.h"
+#include "Ideal.h"
+#include <algorithm>
+
+namespace Ops = SquareFreeTermOps;
+
+namespace {
+  size_t getWordsOfMemoryFor(size_t varCount, size_t genCount) {
+	const size_t bytes =
+	  RawSquareFreeIdeal::getBytesOfMemoryFor(varCount, genCount);
+	if (bytes == 0)
+	  throw bad_alloc();
+	return (bytes - 1) / sizeof(Word) + 1;
+  }
+}
+
+SquareFreeDecomAlg::SquareFreeDecomAlg():
+  _covers(0),
+  _original(0),
+  _varCount(0),
+  _wordCount(0) {
+}
+
+SquareFreeDecomAlg::~SquareFreeDecomAlg() {
+  deleteRawSquareFreeIdeal(_covers);
+}
+
+void SquareFreeDecomAlg::run(const RawSquareFreeIdeal& ideal) {
+  _original = &ideal;
+  _varCount = ideal.getVarCount();
+  _wordCount = ideal.getWordsPerTerm();
+  _cover.assign(_wordCount, 0);
+  _private.resize(_wordCount);
+  _found.clear();
+
+  LocalArray<Word> buffer
+	(getWordsOfMemoryFor(_varCount, ideal.getGeneratorCount()));
+  RawSquareFreeIdeal* copy =
+	RawSquareFreeIdeal::construct(buffer.begin(), ideal);
+  copy->minimize();
+  compute(*copy);
+
+  const size_t coverCount = _found.size() / _wordCount;
+  deleteRawSquareFreeIdeal(_covers);
+  _covers = 0;
+  _covers = newRawSquareFreeIdeal(_varCount, coverCount);
+  for (size_t i = 0; i < coverCount; ++i)
+	_covers->insert(&_found[i * _wordCount]);
+  _original = 0;
+}
+
+void SquareFreeDecomAlg::run(const Ideal& ideal) {
+  ASSERT(ideal.isSquareFree());
+  const size_t bytes = RawSquareFreeIdeal::getBytesOfMemoryFor
+	(ideal.getVarCount(), ideal.getGeneratorCount());
+  if (bytes == 0)
+	throw bad_alloc();
+  LocalArray<Word> buffer((bytes - 1) / sizeof(Word) + 1);
+  run(*RawSquareFreeIdeal::construct(buffer.begin(), ideal));
+}
+
+const RawSquareFreeIdeal& SquareFreeDecomAlg::getCovers() const {
+  ASSERT(_covers != 0);
+  return *_covers;
+}
+
+void SquareFreeDecomAlg::compute(RawSquareFreeIdeal& ideal) {
+  Cancellation::getSingleton().check();
+  const size_t genCount = ideal.getGeneratorCount();
+  if (genCount == 1 && Ops::isIdentity(ideal.getGenerator(0), _varCount))
+	return; // Nothing can cover the identity.
+
+  size_t pivot = 0;
+  if (genCount > 0) {
+	ideal.getVarDividesCounts(_varCounts);
+	for (size_t var = 1; var < _varCount; ++var)
+	  if (_varCounts[var] > _varCounts[pivot])
+		pivot = var;
+  }
+  if (genCount == 0 || _varCounts[pivot] <= 1) {
+	baseCase(ideal, 0);
+	return;
+  }
+
+  // The covers that contain the pivot are the pivot together with a
+  // cover of the generators that the pivot does not divide.
+  Ops::setExponent(&_cover[0], pivot, 1);
+  if (isIrredundant()) {
+	LocalArray<Word> buffer(getWordsOfMemoryFor(_varCount, genCount));
+	RawSquareFreeIdeal* nonMultiples =
+	  RawSquareFreeIdeal::construct(buffer.begin(), _varCount);
+	nonMultiples->insertNonMultiples(pivot, ideal);
+	compute(*nonMultiples);
+  }
+  Ops::setExponent(&_cover[0], pivot, 0);
+
+  // The covers that do not contain the pivot are the covers of the
+  // ideal with the pivot set to 1.
+  ideal.colonReminimize(pivot);
+  compute(ideal);
+}
+
+void SquareFreeDecomAlg::baseCase(const RawSquareFreeIdeal& ideal,
+								  size_t gen) {
+  if (gen == ideal.getGeneratorCount()) {
+	if (isIrredundant())
+	  _found.insert(_found.end(), _cover.begin(), _cover.end());
+	return;
+  }
+
+  // The generators are relatively prime, so each cover picks one
+  // variable from each of them.
+  const Word* term = ideal.getGenerator(gen);
+  for (size_t var = 0; var < _varCount; ++var) {
+	if (Ops::getExponent(term, var) == 0)
+	  continue;
+	Ops::setExponent(&_cover[0], var, 1);
+	baseCase(ideal, gen + 1);
+	Ops::setExponent(&_cover[0], var, 0);
+  }
+}
+
+bool SquareFreeDecomAlg::isIrredundant() {
+  // A variable of the cover is needed if it is the only variable of
+  // the cover that divides some generator of the original ideal.
+  std::fill(_private.begin(), _private.end(), 0);
+  RawSquareFreeIdeal::const_iterator stop = _original->end();
+  for (RawSquareFreeIdeal::const_iterator it = _original->begin();
+	   it != stop; ++it) {
+	size_t hitWord = _wordCount;
+	Word hit = 0;
+	for (size_t word = 0; word < _wordCount; ++word) {
+	  const Word common = (*it)[word] & _cover[word];
+	  if (common == 0)
+		continue;
+	  if (hitWord != _wordCount || (common & (common - 1)) != 0) {
+		hitWord = _wordCount;
+		break;
+	  }
+	  hitWord = word;
+	  hit = common;
+	}
+	if (hitWord != _wordCount)
+	  _private[hitWord] |= hit;
+  }
+  return std::equal(_private.begin(), _private.end(), _cover.begin());
+}
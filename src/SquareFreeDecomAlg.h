@@ -0,0 +1,91 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SQUARE_FREE_DECOM_ALG_GUARD
+#define SQUARE_FREE_DECOM_ALG_GUARD
+
+#include <vector>
+
+class RawSquareFreeIdeal;
+class Ideal;
+
+/** Computes the irreducible decomposition of a square free ideal
+ while keeping the ideal in the bit-packed representation of
+ RawSquareFreeIdeal.
+
+ The irreducible components of a square free ideal I are generated by
+ variables. A set of variables generates a component if and only if it
+ is a minimal vertex cover of the hypergraph whose edges are the
+ supports of the generators of I. The product of the variables of each
+ cover gives the generators of the Alexander dual of I and the
+ components are also the associated primes of I, so all three are
+ computed here.
+
+ The algorithm picks a pivot variable x that divides as many
+ generators as possible. The covers that contain x are x together with
+ a cover of the generators that x does not divide, and the covers that
+ do not contain x are the covers of the ideal with x set to 1. A cover
+ found this way need not be minimal, so the branch is discarded as soon
+ as some variable of the cover is not the only variable of the cover
+ that divides some generator. The base case is an ideal whose
+ generators are pairwise relatively prime, where a cover picks one
+ variable from each generator. */
+class SquareFreeDecomAlg {
+ public:
+  SquareFreeDecomAlg();
+  ~SquareFreeDecomAlg();
+
+  /** Computes the covers of ideal. If ideal contains the identity then
+   there are no covers, and if it has no generators then the identity
+   is the only cover. */
+  void run(const RawSquareFreeIdeal& ideal);
+
+  /** As run(const RawSquareFreeIdeal&) for an ideal whose exponents
+   are all 0 or 1. */
+  void run(const Ideal& ideal);
+
+  /** Returns the covers computed by the most recent call to run. */
+  const RawSquareFreeIdeal& getCovers() const;
+
+ private:
+  SquareFreeDecomAlg(const SquareFreeDecomAlg&); // not available
+  void operator=(const SquareFreeDecomAlg&); // not available
+
+  void compute(RawSquareFreeIdeal& ideal);
+  void baseCase(const RawSquareFreeIdeal& ideal, size_t gen);
+
+  /** Returns true if each variable of _cover is the only variable of
+   _cover that divides some generator of _original. */
+  bool isIrredundant();
+
+  RawSquareFreeIdeal* _covers;
+
+  const RawSquareFreeIdeal* _original;
+  size_t _varCount;
+  size_t _wordCount;
+
+  /** The variables picked for the cover being built. */
+  vector<Word> _cover;
+
+  /** The covers found so far, one after the other. */
+  vector<Word> _found;
+
+  vector<Word> _private;
+  vector<size_t> _varCounts;
+};
+
+#endif
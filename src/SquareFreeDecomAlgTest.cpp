@@ -0,0 +1,77 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SquareFreeDecomAlg.h"
+#include "tests.h"
+
+#include "RawSquareFreeIdeal.h"
+#include "RawSquareFreeTerm.h"
+
+TEST_SUITE(SquareFreeDecomAlg)
+
+namespace {
+  bool hasCovers(const char* ideal, const char* covers) {
+	RawSquareFreeIdeal* in = newRawSquareFreeIdealParse(ideal);
+	RawSquareFreeIdeal* expected = newRawSquareFreeIdealParse(covers);
+
+	SquareFreeDecomAlg alg;
+	alg.run(*in);
+	RawSquareFreeIdeal* actual = newRawSquareFreeIdeal(alg.getCovers());
+	actual->sortLexAscending();
+	expected->sortLexAscending();
+	const bool equal = (*actual == *expected);
+
+	deleteRawSquareFreeIdeal(in);
+	deleteRawSquareFreeIdeal(expected);
+	deleteRawSquareFreeIdeal(actual);
+	return equal;
+  }
+}
+
+TEST(SquareFreeDecomAlg, Path) {
+  ASSERT_TRUE(hasCovers("1100\n0110\n0011\n", "1010\n0110\n0101\n"));
+}
+
+TEST(SquareFreeDecomAlg, NotMinimallyGenerated) {
+  ASSERT_TRUE(hasCovers("1100\n1110\n0110\n1000\n", "1100\n1010\n"));
+}
+
+TEST(SquareFreeDecomAlg, RelativelyPrime) {
+  ASSERT_TRUE(hasCovers("1100\n0011\n", "1010\n1001\n0110\n0101\n"));
+}
+
+TEST(SquareFreeDecomAlg, Triangle) {
+  ASSERT_TRUE(hasCovers("110\n011\n101\n", "110\n011\n101\n"));
+}
+
+TEST(SquareFreeDecomAlg, Identity) {
+  RawSquareFreeIdeal* in = newRawSquareFreeIdealParse("000\n110\n");
+  SquareFreeDecomAlg alg;
+  alg.run(*in);
+  ASSERT_EQ(alg.getCovers().getGeneratorCount(), 0u);
+  deleteRawSquareFreeIdeal(in);
+}
+
+TEST(SquareFreeDecomAlg, NoGenerators) {
+  RawSquareFreeIdeal* in = newRawSquareFreeIdeal(3, 0);
+  SquareFreeDecomAlg alg;
+  alg.run(*in);
+  ASSERT_EQ(alg.getCovers().getGeneratorCount(), 1u);
+  ASSERT_TRUE(SquareFreeTermOps::isIdentity(alg.getCovers().getGenerator(0), 3));
+  deleteRawSquareFreeIdeal(in);
+}
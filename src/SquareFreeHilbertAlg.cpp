@@ -0,0 +1,178 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SquareFreeHilbertAlg.h"
+
+#include "RawSquareFreeIdeal.h"
+#include "RawSquareFreeTerm.h"
+#include "LocalArray.h"
+#include "Cancellation.h"
+#include "TermTranslator.h"
+#include "CoefBigTermConsumer.h"
+#include "Ideal.h"
+
+namespace Ops = SquareFreeTermOps;
+
+namespace {
+  /** Returns the number of words needed to store an ideal with the
+   given number of variables and generators. */
+  size_t getWordsOfMemoryFor(size_t varCount, size_t genCount) {
+	const size_t bytes =
+	  RawSquareFreeIdeal::getBytesOfMemoryFor(varCount, genCount);
+	if (bytes == 0)
+	  throw bad_alloc();
+	return (bytes - 1) / sizeof(Word) + 1;
+  }
+}
+
+SquareFreeHilbertAlg::SquareFreeHilbertAlg(const TermTranslator& translator):
+  _translator(translator),
+  _varCount(translator.getVarCount()),
+  _computeUnivariate(false),
+  _multiply(_varCount),
+  _baseTerm(_varCount),
+  _outputMultivariate(_varCount) {
+}
+
+void SquareFreeHilbertAlg::run(const RawSquareFreeIdeal& ideal) {
+  ASSERT(ideal.getVarCount() == _varCount);
+  ASSERT(_factors.empty());
+
+  LocalArray<Word> buffer
+	(getWordsOfMemoryFor(_varCount, ideal.getGeneratorCount()));
+  RawSquareFreeIdeal* copy =
+	RawSquareFreeIdeal::construct(buffer.begin(), ideal);
+  copy->minimize();
+  compute(*copy);
+}
+
+void SquareFreeHilbertAlg::run(const Ideal& ideal) {
+  ASSERT(ideal.getVarCount() == _varCount);
+  ASSERT(ideal.isSquareFree());
+  ASSERT(_factors.empty());
+
+  LocalArray<Word> buffer
+	(getWordsOfMemoryFor(_varCount, ideal.getGeneratorCount()));
+  RawSquareFreeIdeal* copy =
+	RawSquareFreeIdeal::construct(buffer.begin(), ideal);
+  copy->minimize();
+  compute(*copy);
+}
+
+void SquareFreeHilbertAlg::feedOutputTo(CoefBigTermConsumer& consumer,
+										bool inCanonicalOrder) {
+  if (_computeUnivariate)
+	_outputUnivariate.feedTo(consumer, inCanonicalOrder);
+  else
+	_outputMultivariate.feedTo(_translator, consumer, inCanonicalOrder);
+}
+
+void SquareFreeHilbertAlg::compute(RawSquareFreeIdeal& ideal) {
+  Cancellation::getSingleton().check();
+  const size_t genCount = ideal.getGeneratorCount();
+  if (genCount == 1 && Ops::isIdentity(ideal.getGenerator(0), _varCount))
+	return; // The numerator of the whole ring is zero.
+
+  size_t pivot = 0;
+  if (genCount > 0) {
+	ideal.getVarDividesCounts(_varCounts);
+	for (size_t var = 1; var < _varCount; ++var)
+	  if (_varCounts[var] > _varCounts[pivot])
+		pivot = var;
+  }
+  if (genCount == 0 || _varCounts[pivot] <= 1) {
+	baseCase(ideal);
+	return;
+  }
+
+  {
+	LocalArray<Word> buffer(getWordsOfMemoryFor(_varCount, genCount));
+	RawSquareFreeIdeal* nonMultiples =
+	  RawSquareFreeIdeal::construct(buffer.begin(), _varCount);
+	nonMultiples->insertNonMultiples(pivot, ideal);
+	_factors.push_back(pivot);
+	compute(*nonMultiples);
+	_factors.pop_back();
+  }
+
+  ideal.colonReminimize(pivot);
+  _multiply[pivot] = 1;
+  compute(ideal);
+  _multiply[pivot] = 0;
+}
+
+void SquareFreeHilbertAlg::baseCase(const RawSquareFreeIdeal& ideal) {
+  _baseVars.clear();
+  _baseEnds.clear();
+  for (size_t i = 0; i < _factors.size(); ++i) {
+	_baseVars.push_back(_factors[i]);
+	_baseEnds.push_back(_baseVars.size());
+  }
+  RawSquareFreeIdeal::const_iterator stop = ideal.end();
+  for (RawSquareFreeIdeal::const_iterator it = ideal.begin();
+	   it != stop; ++it) {
+	for (size_t var = 0; var < _varCount; ++var)
+	  if (Ops::getExponent(*it, var) != 0)
+		_baseVars.push_back(var);
+	_baseEnds.push_back(_baseVars.size());
+  }
+
+  if (!_computeUnivariate) {
+	_baseTerm = _multiply;
+	outputProduct(0, true);
+	return;
+  }
+
+  // Multiply out the product of (1 - t^d) where d is the degree of
+  // each factor.
+  _basePoly.clear();
+  _basePoly.push_back(1);
+  size_t begin = 0;
+  for (size_t factor = 0; factor < _baseEnds.size(); ++factor) {
+	const size_t degree = _baseEnds[factor] - begin;
+	begin = _baseEnds[factor];
+	const size_t oldSize = _basePoly.size();
+	_basePoly.resize(oldSize + degree);
+	for (size_t e = oldSize; e > 0; --e)
+	  _basePoly[e - 1 + degree] -= _basePoly[e - 1];
+  }
+
+  const size_t multiplyDegree = _multiply.getSizeOfSupport();
+  for (size_t e = 0; e < _basePoly.size(); ++e) {
+	if (_basePoly[e] != 0) {
+	  _tmp = multiplyDegree + e;
+	  _outputUnivariate.add(_basePoly[e], _tmp);
+	}
+  }
+}
+
+void SquareFreeHilbertAlg::outputProduct(size_t factor, bool plus) {
+  if (factor == _baseEnds.size()) {
+	_outputMultivariate.add(plus, _baseTerm);
+	return;
+  }
+  outputProduct(factor + 1, plus);
+
+  const size_t begin = factor == 0 ? 0 : _baseEnds[factor - 1];
+  const size_t end = _baseEnds[factor];
+  for (size_t i = begin; i < end; ++i)
+	_baseTerm[_baseVars[i]] = 1;
+  outputProduct(factor + 1, !plus);
+  for (size_t i = begin; i < end; ++i)
+	_baseTerm[_baseVars[i]] = 0;
+}
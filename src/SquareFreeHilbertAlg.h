@@ -0,0 +1,97 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SQUARE_FREE_HILBERT_ALG_GUARD
+#define SQUARE_FREE_HILBERT_ALG_GUARD
+
+#include "Term.h"
+#include "HashPolynomial.h"
+#include "UniHashPolynomial.h"
+#include <vector>
+
+class RawSquareFreeIdeal;
+class Ideal;
+class TermTranslator;
+class CoefBigTermConsumer;
+
+/** Computes the numerator of the Hilbert-Poincare series of a square
+ free ideal while keeping the ideal in the bit-packed representation
+ of RawSquareFreeIdeal.
+
+ The algorithm picks a pivot variable x that divides as many
+ generators as possible and then uses that
+
+   N(I) = x * N(I : x) + (1 - x) * N(J)
+
+ where N(I) is the numerator for I and J is generated by the
+ generators of I that x does not divide. Neither I : x nor J involve
+ x. The base case is an ideal whose generators are pairwise relatively
+ prime, since then N(I) is the product of (1 - g) over the generators
+ g of I.
+
+ The translator is only used to produce the output, so it must map
+ the exponents 0 and 1 of every variable to 0 and 1. */
+class SquareFreeHilbertAlg {
+ public:
+  SquareFreeHilbertAlg(const TermTranslator& translator);
+
+  /** Grade each variable by the same variable t if value is true, and
+   otherwise use the fine grading. */
+  void setComputeUnivariate(bool value) {_computeUnivariate = value;}
+
+  /** Computes the numerator for ideal. ideal need not be minimally
+   generated. */
+  void run(const RawSquareFreeIdeal& ideal);
+
+  /** As run(const RawSquareFreeIdeal&) for an ideal whose exponents
+   are all 0 or 1. */
+  void run(const Ideal& ideal);
+
+  /** Feeds the computed numerator to consumer. This is done in
+   canonical order if inCanonicalOrder is true. */
+  void feedOutputTo(CoefBigTermConsumer& consumer, bool inCanonicalOrder);
+
+ private:
+  void compute(RawSquareFreeIdeal& ideal);
+  void baseCase(const RawSquareFreeIdeal& ideal);
+  void outputProduct(size_t factor, bool plus);
+
+  const TermTranslator& _translator;
+  const size_t _varCount;
+  bool _computeUnivariate;
+
+  /** The numerator of the ideal being processed is multiplied by
+   _multiply and by (1 - x) for each variable x in _factors. */
+  Term _multiply;
+  vector<size_t> _factors;
+
+  /** The base case expands a product of factors (1 - m) where each m
+   is square free. The variables that divide factor i are those in
+   _baseVars from index _baseEnds[i - 1] to _baseEnds[i]. */
+  vector<size_t> _baseVars;
+  vector<size_t> _baseEnds;
+  Term _baseTerm;
+  vector<mpz_class> _basePoly;
+  mpz_class _tmp;
+
+  vector<size_t> _varCounts;
+
+  HashPolynomial _outputMultivariate;
+  UniHashPolynomial _outputUnivariate;
+};
+
+#endif
@@ -0,0 +1,513 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SquareFreeMaxIndepSetAlg.h"
+
+#include "RawSquareFreeIdeal.h"
+#include "RawSquareFreeTerm.h"
+#include "LocalArray.h"
+#include "Ideal.h"
+#include "Cancellation.h"
+#include <algorithm>
+
+namespace Ops = SquareFreeTermOps;
+
+namespace {
+  size_t getWordsOfMemoryFor(size_t varCount, size_t genCount) {
+	const size_t bytes =
+	  RawSquareFreeIdeal::getBytesOfMemoryFor(varCount, genCount);
+	if (bytes == 0)
+	  throw bad_alloc();
+	return (bytes - 1) / sizeof(Word) + 1;
+  }
+
+  inline bool hasBit(const Word* set, size_t bit) {
+	return (set[bit / BitsPerWord] >> (bit % BitsPerWord)) & 1;
+  }
+
+  inline void setBit(Word* set, size_t bit) {
+	set[bit / BitsPerWord] |= static_cast<Word>(1) << (bit % BitsPerWord);
+  }
+
+  inline void clearBit(Word* set, size_t bit) {
+	set[bit / BitsPerWord] &= ~(static_cast<Word>(1) << (bit % BitsPerWord));
+  }
+
+  /** Returns the index of the lowest set bit of word, which must not
+   be zero. */
+  inline size_t getLowestBit(Word word) {
+	ASSERT(word != 0);
+#ifdef __GNUC__
+	return static_cast<size_t>(__builtin_ctzl(word));
+#else
+	size_t bit = 0;
+	while ((word & 1) == 0) {
+	  word >>= 1;
+	  ++bit;
+	}
+	return bit;
+#endif
+  }
+
+  /** Returns the lowest element of set from the word at index word
+   and on, or wordCount * BitsPerWord if there is none. Updates word
+   to the index of the word of that element. */
+  inline size_t getLowestElement(const Word* set, size_t& word,
+								 size_t wordCount) {
+	for (; word < wordCount; ++word)
+	  if (set[word] != 0)
+		return word * BitsPerWord + getLowestBit(set[word]);
+	return wordCount * BitsPerWord;
+  }
+
+  inline size_t getBitCount(Word word) {
+	// This counts the bits in parallel within each byte and then adds
+	// up the bytes using a multiplication.
+	const Word ones = ~static_cast<Word>(0);
+	word -= (word >> 1) & (ones / 3);
+	word = (word & (ones / 5)) + ((word >> 2) & (ones / 5));
+	word = (word + (word >> 4)) & (ones / 17);
+	return static_cast<size_t>((word * (ones / 255)) >> (BitsPerWord - 8));
+  }
+
+  inline size_t getBitCount(const Word* set, size_t wordCount) {
+	size_t count = 0;
+	for (size_t word = 0; word < wordCount; ++word)
+	  count += getBitCount(set[word]);
+	return count;
+  }
+
+  inline bool isEmpty(const Word* set, size_t wordCount) {
+	for (size_t word = 0; word < wordCount; ++word)
+	  if (set[word] != 0)
+		return false;
+	return true;
+  }
+
+  /** Orders variables by increasing value of a vector. */
+  class SmallerValue {
+  public:
+	SmallerValue(const vector<size_t>& values): _values(values) {}
+	bool operator()(size_t a, size_t b) const {
+	  return _values[a] < _values[b];
+	}
+  private:
+	const vector<size_t>& _values;
+  };
+}
+
+SquareFreeMaxIndepSetAlg::SquareFreeMaxIndepSetAlg():
+  _varCount(0),
+  _wordCount(0),
+  _threadCount(getMaxThreadCount()),
+  _noIndependentSets(false),
+  _best(0) {
+}
+
+void SquareFreeMaxIndepSetAlg::setThreadCount(size_t count) {
+  ASSERT(count > 0);
+  _threadCount = count;
+}
+
+void SquareFreeMaxIndepSetAlg::run(const RawSquareFreeIdeal& ideal) {
+  {
+	LocalArray<Word> buffer
+	  (getWordsOfMemoryFor(ideal.getVarCount(), ideal.getGeneratorCount()));
+	RawSquareFreeIdeal* copy =
+	  RawSquareFreeIdeal::construct(buffer.begin(), ideal);
+	copy->minimize();
+	makeGraph(*copy);
+  }
+  if (_noIndependentSets)
+	return;
+
+  _best = 0;
+  greedy();
+
+  prepare(_root, 0);
+  _root.set.assign(_wordCount, 0);
+  _root.candidates[0] = _vertices;
+  if (partition(_root, 0) <= _best)
+	return;
+
+  // The subtrees of the first level are searched in parallel. The
+  // subtrees with the largest bounds come last, so they are scheduled
+  // first.
+  const bool splitOnEdge = !_root.edge[0].empty();
+  const long subtreeCount = static_cast<long>
+	(splitOnEdge ? _root.edge[0].size() : _root.order[0].size());
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+  const int threadCount = static_cast<int>(_threadCount);
+#pragma omp parallel num_threads(threadCount)
+#endif
+  {
+	Search search;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+	for (long i = subtreeCount - 1; i >= 0; --i) {
+	  if (catcher.hasCaught())
+		continue;
+	  try {
+		searchSubtree(search, static_cast<size_t>(i));
+	  } catch (...) {
+		catcher.catchCurrent();
+	  }
+	}
+  }
+  catcher.rethrowIfCaught();
+}
+
+void SquareFreeMaxIndepSetAlg::run(const Ideal& ideal) {
+  ASSERT(ideal.isSquareFree());
+  LocalArray<Word> buffer
+	(getWordsOfMemoryFor(ideal.getVarCount(), ideal.getGeneratorCount()));
+  run(*RawSquareFreeIdeal::construct(buffer.begin(), ideal));
+}
+
+mpz_class SquareFreeMaxIndepSetAlg::getMaxIndepSetSize() const {
+  if (_noIndependentSets)
+	return -1;
+  else
+	return static_cast<unsigned long>(_best);
+}
+
+void SquareFreeMaxIndepSetAlg::makeGraph(const RawSquareFreeIdeal& ideal) {
+  const size_t genCount = ideal.getGeneratorCount();
+  _varCount = ideal.getVarCount();
+  _wordCount = _varCount / BitsPerWord + 1;
+  _noIndependentSets =
+	genCount == 1 && Ops::isIdentity(ideal.getGenerator(0), _varCount);
+
+  // Renumber the vertices by increasing degree.
+  vector<size_t> degrees;
+  ideal.getVarDividesCounts(degrees);
+  vector<size_t> newToOld(_varCount);
+  for (size_t var = 0; var < _varCount; ++var)
+	newToOld[var] = var;
+  std::stable_sort(newToOld.begin(), newToOld.end(), SmallerValue(degrees));
+  vector<size_t> oldToNew(_varCount);
+  for (size_t var = 0; var < _varCount; ++var)
+	oldToNew[newToOld[var]] = var;
+
+  _adjacent.assign(_varCount * _wordCount, 0);
+  bool hasGraphEdges = false;
+  _hyperEdges.clear();
+  _hyperEdgesOf.clear();
+  _hyperEdgesOf.resize(_varCount);
+  _vertices.assign(_wordCount, 0);
+  for (size_t var = 0; var < _varCount; ++var)
+	setBit(&_vertices[0], var);
+
+  vector<size_t> edge;
+  for (size_t gen = 0; gen < genCount; ++gen) {
+	edge.clear();
+	for (size_t var = 0; var < _varCount; ++var)
+	  if (Ops::getExponent(ideal.getGenerator(gen), var) != 0)
+		edge.push_back(oldToNew[var]);
+
+	if (edge.size() == 1)
+	  clearBit(&_vertices[0], edge[0]);
+	else if (edge.size() == 2) {
+	  hasGraphEdges = true;
+	  setBit(&_adjacent[edge[0] * _wordCount], edge[1]);
+	  setBit(&_adjacent[edge[1] * _wordCount], edge[0]);
+	} else if (edge.size() > 2) {
+	  const size_t index = _hyperEdges.size() / _wordCount;
+	  _hyperEdges.resize(_hyperEdges.size() + _wordCount);
+	  for (size_t i = 0; i < edge.size(); ++i) {
+		setBit(&_hyperEdges[index * _wordCount], edge[i]);
+		_hyperEdgesOf[edge[i]].push_back(index);
+	  }
+	}
+  }
+  if (!hasGraphEdges)
+	_adjacent.clear();
+}
+
+void SquareFreeMaxIndepSetAlg::greedy() {
+  // Vertices of small degree exclude few other vertices, so picking
+  // them first tends to give a large independent set to start out
+  // with.
+  vector<Word> set(_wordCount);
+  vector<Word> candidates(_vertices);
+  size_t size = 0;
+  for (size_t var = 0; var < _varCount; ++var) {
+	if (hasBit(&candidates[0], var)) {
+	  include(var, &set[0], &candidates[0]);
+	  ++size;
+	}
+  }
+  improve(size);
+}
+
+void SquareFreeMaxIndepSetAlg::searchSubtree(Search& search, size_t subtree) {
+  prepare(search, 1);
+  search.live[0] = _root.live[0];
+  search.set.assign(_wordCount, 0);
+  Word* set = &search.set[0];
+  Word* candidates = &search.candidates[1][0];
+  std::copy(_vertices.begin(), _vertices.end(), candidates);
+
+  size_t size = 0;
+  const vector<size_t>& edge = _root.edge[0];
+  if (!edge.empty()) {
+	// Include the vertices of the edge before the subtree and exclude
+	// the vertex of the subtree.
+	for (size_t i = 0; i < subtree; ++i) {
+	  if (!hasBit(candidates, edge[i]))
+		return;
+	  include(edge[i], set, candidates);
+	  ++size;
+	}
+	clearBit(candidates, edge[subtree]);
+  } else {
+	// Include the vertex of the subtree and exclude the vertices after
+	// it.
+	const vector<size_t>& order = _root.order[0];
+	if (_root.bound[0][subtree] <= _best)
+	  return;
+	for (size_t i = subtree + 1; i < order.size(); ++i)
+	  clearBit(candidates, order[i]);
+	include(order[subtree], set, candidates);
+	++size;
+  }
+
+  if (isEmpty(candidates, _wordCount))
+	improve(size);
+  else
+	this->search(search, 1, size);
+}
+
+void SquareFreeMaxIndepSetAlg::search(Search& search, size_t depth,
+									  size_t size) {
+  Word* candidates = &search.candidates[depth][0];
+  const size_t candidateCount = getBitCount(candidates, _wordCount);
+  if (size + candidateCount <= _best)
+	return;
+  Cancellation::getSingleton().check();
+
+  const size_t total = partition(search, depth);
+  if (size + total <= _best)
+	return;
+
+  const vector<size_t>& edge = search.edge[depth];
+  if (edge.empty() && total == candidateCount) {
+	// No two candidates are in an edge together with the set, so all
+	// of them can be included.
+	improve(size + total);
+	return;
+  }
+  prepare(search, depth + 1);
+
+  Word* next = &search.candidates[depth + 1][0];
+  Word* set = &search.set[0];
+
+  if (!edge.empty()) {
+	// Some vertex of the edge must be left out. Branch on which vertex
+	// of the edge is the first one to be left out.
+	size_t included = 0;
+	for (; included < edge.size(); ++included) {
+	  std::copy(candidates, candidates + _wordCount, next);
+	  clearBit(next, edge[included]);
+	  if (isEmpty(next, _wordCount))
+		improve(size + included);
+	  else
+		this->search(search, depth + 1, size + included);
+
+	  if (!hasBit(candidates, edge[included]))
+		break;
+	  include(edge[included], set, candidates);
+	}
+	for (size_t i = 0; i < included && i < edge.size(); ++i)
+	  clearBit(set, edge[i]);
+	return;
+  }
+
+  const vector<size_t>& order = search.order[depth];
+  const vector<size_t>& bound = search.bound[depth];
+  for (size_t i = order.size(); i > 0; --i) {
+	if (size + bound[i - 1] <= _best)
+	  return;
+	const size_t var = order[i - 1];
+
+	std::copy(candidates, candidates + _wordCount, next);
+	include(var, set, next);
+	if (isEmpty(next, _wordCount))
+	  improve(size + 1);
+	else
+	  this->search(search, depth + 1, size + 1);
+	clearBit(set, var);
+	clearBit(candidates, var);
+  }
+}
+
+size_t SquareFreeMaxIndepSetAlg::partition(Search& search, size_t depth) {
+  vector<size_t>& order = search.order[depth];
+  vector<size_t>& bound = search.bound[depth];
+  vector<size_t>& edge = search.edge[depth];
+  order.clear();
+  bound.clear();
+  edge.clear();
+
+  search.uncolored = search.candidates[depth];
+  search.clique.resize(_wordCount);
+  Word* uncolored = &search.uncolored[0];
+  Word* clique = &search.clique[0];
+  const Word* candidates = &search.candidates[depth][0];
+  const Word* set = &search.set[0];
+
+  // An edge is live if all of its vertices are in the set or are
+  // candidates. At least one of the candidates of a live edge must be
+  // left out, so greedily picking live edges whose candidates are
+  // disjoint gives groups of vertices that each contribute at most one
+  // less than their size. The live edge with the fewest candidates is
+  // recorded in edge, as it is good to branch on. An edge that is not
+  // live stays that way further down in the search, so only the live
+  // edges of the previous depth need be considered.
+  vector<size_t>& live = search.live[depth];
+  live.clear();
+  const size_t parentCount = depth == 0 ?
+	_hyperEdges.size() / _wordCount : search.live[depth - 1].size();
+  size_t bestSize = 0;
+  size_t bestEdge = 0;
+  size_t total = 0;
+  for (size_t i = 0; i < parentCount; ++i) {
+	const size_t e = depth == 0 ? i : search.live[depth - 1][i];
+	const Word* hyperEdge = &_hyperEdges[e * _wordCount];
+	bool isLive = true;
+	bool disjoint = true;
+	size_t size = 0;
+	for (size_t word = 0; word < _wordCount; ++word) {
+	  const Word rest = hyperEdge[word] & ~set[word];
+	  if ((rest & ~candidates[word]) != 0) {
+		isLive = false;
+		break;
+	  }
+	  if ((rest & ~uncolored[word]) != 0)
+		disjoint = false;
+	  size += getBitCount(rest);
+	}
+	if (!isLive)
+	  continue;
+	live.push_back(e);
+	ASSERT(size >= 2);
+	if (bestSize == 0 || size < bestSize) {
+	  bestSize = size;
+	  bestEdge = e;
+	}
+	if (disjoint) {
+	  for (size_t word = 0; word < _wordCount; ++word)
+		uncolored[word] &= ~(hyperEdge[word] & ~set[word]);
+	  total += size - 1;
+	}
+  }
+
+  if (bestSize != 0) {
+	// Leaving out vertices of high degree first tends to find large
+	// independent sets sooner.
+	const Word* hyperEdge = &_hyperEdges[bestEdge * _wordCount];
+	for (size_t var = _varCount; var > 0; --var)
+	  if (hasBit(hyperEdge, var - 1) && !hasBit(set, var - 1))
+		edge.push_back(var - 1);
+  }
+
+  if (_adjacent.empty()) // Each vertex is a clique by itself.
+	return total + getBitCount(uncolored, _wordCount);
+
+  // Each clique takes the lowest uncolored vertex and then the lowest
+  // uncolored vertex that is adjacent to every vertex of the clique
+  // so far. Each clique contributes at most one vertex. The vertices
+  // of the groups are not recorded in order, since they are only
+  // needed when there are no live edges.
+  size_t firstWord = 0;
+  while (getLowestElement(uncolored, firstWord, _wordCount) <
+		 _wordCount * BitsPerWord) {
+	++total;
+	std::copy(uncolored, uncolored + _wordCount, clique);
+	size_t word = firstWord;
+	while (true) {
+	  const size_t var = getLowestElement(clique, word, _wordCount);
+	  if (var == _wordCount * BitsPerWord)
+		break;
+	  clearBit(uncolored, var);
+	  order.push_back(var);
+	  bound.push_back(total);
+
+	  const Word* adjacent = &_adjacent[var * _wordCount];
+	  for (size_t w = word; w < _wordCount; ++w)
+		clique[w] &= adjacent[w];
+	}
+  }
+  return total;
+}
+
+void SquareFreeMaxIndepSetAlg::include(size_t var, Word* set,
+									   Word* candidates) const {
+  setBit(set, var);
+  clearBit(candidates, var);
+  if (!_adjacent.empty()) {
+	const Word* adjacent = &_adjacent[var * _wordCount];
+	for (size_t word = 0; word < _wordCount; ++word)
+	  candidates[word] &= ~adjacent[word];
+  }
+
+  // A vertex can no longer be added if it is the only vertex of some
+  // edge that is not in the set.
+  const vector<size_t>& edges = _hyperEdgesOf[var];
+  for (size_t i = 0; i < edges.size(); ++i) {
+	const Word* edge = &_hyperEdges[edges[i] * _wordCount];
+	size_t missingWord = _wordCount;
+	Word missing = 0;
+	for (size_t word = 0; word < _wordCount; ++word) {
+	  const Word outside = edge[word] & ~set[word];
+	  if (outside == 0)
+		continue;
+	  if (missingWord != _wordCount || (outside & (outside - 1)) != 0) {
+		missingWord = _wordCount;
+		break;
+	  }
+	  missingWord = word;
+	  missing = outside;
+	}
+	if (missingWord != _wordCount)
+	  candidates[missingWord] &= ~missing;
+  }
+}
+
+void SquareFreeMaxIndepSetAlg::improve(size_t size) {
+  MutexLocker locker(_bestMutex);
+  if (size > _best)
+	_best = size;
+}
+
+void SquareFreeMaxIndepSetAlg::prepare(Search& search, size_t depth) const {
+  // The vectors for each depth are allocated up front so that growing
+  // them does not move the vectors of the depths that are in use.
+  if (search.candidates.size() < _varCount + 2) {
+	search.candidates.resize(_varCount + 2);
+	search.order.resize(_varCount + 2);
+	search.bound.resize(_varCount + 2);
+	search.edge.resize(_varCount + 2);
+	search.live.resize(_varCount + 2);
+  }
+  search.candidates[depth].resize(_wordCount);
+  if (search.set.size() != _wordCount)
+	search.set.assign(_wordCount, 0);
+}
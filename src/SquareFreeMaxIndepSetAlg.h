@@ -0,0 +1,120 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef SQUARE_FREE_MAX_INDEP_SET_ALG_GUARD
+#define SQUARE_FREE_MAX_INDEP_SET_ALG_GUARD
+
+#include "Parallel.h"
+#include <vector>
+
+class RawSquareFreeIdeal;
+class Ideal;
+
+/** Computes the size of the largest independent sets of the
+ hypergraph whose edges are the supports of the generators of a square
+ free ideal. This is the dimension of the ideal, while the number of
+ variables minus this is the codimension. This does the same thing as
+ SizeMaxIndepSetAlg, but it keeps sets of vertices as bit sets.
+
+ The algorithm is a branch-and-bound algorithm. The state is an
+ independent set S and a set P of candidates, which are the vertices v
+ not in S such that S plus v is independent. A vertex v of P is then
+ picked, and first S plus v is explored and then v is removed from P.
+ The edges of size 2 form a graph, and the vertices of a clique of
+ that graph contribute at most one vertex to an independent set. So
+ greedily partitioning P into cliques gives a bound on how much larger
+ S can get. The vertices are picked in the order of the partition,
+ which makes the bound smaller for the remaining vertices as they are
+ removed from P. Edges of size 3 or more are not used for the bound,
+ but they are used to remove the vertices from P that would make S
+ dependent.
+
+ The subtrees of the first level of the search are independent, so
+ they are explored in parallel if Frobby has been compiled with
+ OpenMP. The threads share the size of the best set found so far. */
+class SquareFreeMaxIndepSetAlg {
+ public:
+  SquareFreeMaxIndepSetAlg();
+
+  /** Use at most count threads. The default is getMaxThreadCount(). */
+  void setThreadCount(size_t count);
+
+  /** Computes the size of the largest independent sets of the
+   hypergraph of ideal. ideal need not be minimally generated. */
+  void run(const RawSquareFreeIdeal& ideal);
+
+  /** As run(const RawSquareFreeIdeal&) for an ideal whose exponents
+   are all 0 or 1. */
+  void run(const Ideal& ideal);
+
+  /** Returns the largest size of an independent set, or -1 if there
+   are none, which happens if the ideal contains the identity. */
+  mpz_class getMaxIndepSetSize() const;
+
+ private:
+  /** The state of the search on one thread. */
+  struct Search {
+    vector<Word> set;
+    vector<vector<Word> > candidates;
+    vector<vector<size_t> > order;
+    vector<vector<size_t> > bound;
+    vector<vector<size_t> > edge;
+    vector<vector<size_t> > live;
+    vector<Word> uncolored;
+    vector<Word> clique;
+  };
+
+  void makeGraph(const RawSquareFreeIdeal& ideal);
+  void greedy();
+  void searchSubtree(Search& search, size_t subtree);
+  void search(Search& search, size_t depth, size_t size);
+  size_t partition(Search& search, size_t depth);
+  void include(size_t var, Word* set, Word* candidates) const;
+  void improve(size_t size);
+  void prepare(Search& search, size_t depth) const;
+
+  size_t _varCount;
+  size_t _wordCount;
+  size_t _threadCount;
+  bool _noIndependentSets;
+
+  /** The vertices are renumbered by increasing degree. _adjacent holds
+   the neighbors in the graph of each vertex as a bit set of
+   _wordCount words. It is empty if there are no edges of size 2. */
+  vector<Word> _adjacent;
+
+  /** The edges of size 3 or more, each given as _wordCount words. */
+  vector<Word> _hyperEdges;
+
+  /** The indices of the edges in _hyperEdges that contain each
+   vertex. */
+  vector<vector<size_t> > _hyperEdgesOf;
+
+  /** The vertices that are not edges by themselves. */
+  vector<Word> _vertices;
+
+  /** The first level of the search. */
+  Search _root;
+
+  /** The size of the largest independent set found so far. This is
+   read without locking, so a thread may miss a recent improvement for
+   a while, which just means that it prunes less. */
+  volatile size_t _best;
+  Mutex _bestMutex;
+};
+
+#endif
@@ -0,0 +1,101 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "SquareFreeMaxIndepSetAlg.h"
+#include "tests.h"
+
+#include "RawSquareFreeIdeal.h"
+#include "SizeMaxIndepSetAlg.h"
+#include "Ideal.h"
+#include "Term.h"
+
+TEST_SUITE(SquareFreeMaxIndepSetAlg)
+
+namespace {
+  mpz_class getMaxIndepSetSize(const char* str) {
+	RawSquareFreeIdeal* ideal = newRawSquareFreeIdealParse(str);
+	SquareFreeMaxIndepSetAlg alg;
+	alg.run(*ideal);
+	deleteRawSquareFreeIdeal(ideal);
+	return alg.getMaxIndepSetSize();
+  }
+}
+
+TEST(SquareFreeMaxIndepSetAlg, Path) {
+  ASSERT_EQ(getMaxIndepSetSize("1100\n0110\n0011\n"), 2);
+}
+
+TEST(SquareFreeMaxIndepSetAlg, HyperEdges) {
+  ASSERT_EQ(getMaxIndepSetSize("111\n"), 2);
+  ASSERT_EQ(getMaxIndepSetSize("11100\n00111\n"), 4);
+  ASSERT_EQ(getMaxIndepSetSize("1110\n0111\n1011\n1101\n"), 2);
+}
+
+TEST(SquareFreeMaxIndepSetAlg, Variables) {
+  ASSERT_EQ(getMaxIndepSetSize("100\n011\n"), 1);
+  ASSERT_EQ(getMaxIndepSetSize("100\n010\n001\n"), 0);
+}
+
+TEST(SquareFreeMaxIndepSetAlg, NotMinimallyGenerated) {
+  ASSERT_EQ(getMaxIndepSetSize("110\n111\n100\n"), 2);
+}
+
+TEST(SquareFreeMaxIndepSetAlg, Identity) {
+  ASSERT_EQ(getMaxIndepSetSize("000\n110\n"), -1);
+}
+
+TEST(SquareFreeMaxIndepSetAlg, NoGenerators) {
+  RawSquareFreeIdeal* ideal = newRawSquareFreeIdeal(3, 0);
+  SquareFreeMaxIndepSetAlg alg;
+  alg.run(*ideal);
+  deleteRawSquareFreeIdeal(ideal);
+  ASSERT_EQ(alg.getMaxIndepSetSize(), 3);
+}
+
+TEST(SquareFreeMaxIndepSetAlg, SameAsSizeMaxIndepSetAlg) {
+  // Compare to SizeMaxIndepSetAlg on pseudo-random hypergraphs with
+  // edges of size 2 and 3, using both one and two threads.
+  unsigned long seed = 1;
+  for (size_t round = 0; round < 40; ++round) {
+	const size_t varCount = 10 + round % 70;
+	const size_t edgeCount = varCount + round * 3;
+	Ideal edges(varCount);
+	Term term(varCount);
+	for (size_t i = 0; i < edgeCount; ++i) {
+	  term.setToIdentity();
+	  const size_t size = 2 + (i % 5 == 0);
+	  for (size_t j = 0; j < size; ++j) {
+		seed = seed * 1103515245 + 12345;
+		term[(seed >> 16) % varCount] = 1;
+	  }
+	  edges.insert(term);
+	}
+	edges.minimize();
+
+	Ideal copy(edges);
+	SizeMaxIndepSetAlg expected;
+	expected.run(copy);
+
+	for (size_t threadCount = 1; threadCount <= 2; ++threadCount) {
+	  SquareFreeMaxIndepSetAlg alg;
+	  alg.setThreadCount(threadCount);
+	  alg.run(edges);
+	  ASSERT_EQ(alg.getMaxIndepSetSize(), expected.getMaxIndepSetSize());
+	}
+  }
+}
@@ -39,6 +39,12 @@ class Task {
    circumstances.
   */
   virtual void dispose() = 0;
+
+  /** Returns false if this task only gathers the results of other
+   tasks rather than splitting up the work. Such a task is then not
+   a node of the tree that the ProgressMeter measures.
+  */
+  virtual bool isTreeNode() const {return true;}
 };
 
 #endif
@@ -19,45 +19,94 @@
 #include "TaskEngine.h"
 
 #include "Task.h"
+#include "Cancellation.h"
+#include "ProgressMeter.h"
 #include "display.h"
+#include <algorithm>
 
 TaskEngine::TaskEngine():
-  _totalTasksEver(0) {
+  _totalTasksEver(0),
+  _depthOfNewTasks(0),
+  _measuring(false) {
 }
 
 TaskEngine::~TaskEngine() {
   while (!_tasks.empty()) {
-    dispose(_tasks.back());
+    dispose(_tasks.back().task);
     _tasks.pop_back();
   }
+  if (_measuring)
+    ProgressMeter::getSingleton().detach(this);
 }
 
 void TaskEngine::addTask(Task* task) {
   ASSERT(task != 0);
 
+  PendingTask pending;
+  pending.task = task;
+  pending.depth = _depthOfNewTasks;
+  pending.isTreeNode = task->isTreeNode();
+  pending.probability = 1;
+  pending.estimate = 1;
   try {
-    _tasks.push_back(task);
+    _tasks.push_back(pending);
   } catch (...) {
     // We should only get an exception if insertion failed.
-    ASSERT(_tasks.empty() || _tasks.back() != task);
+    ASSERT(_tasks.empty() || _tasks.back().task != task);
     dispose(task);
     throw;
   }
 
   ++_totalTasksEver;
+
+  if (_depthOfNewTasks == 0 && pending.isTreeNode) {
+    ProgressMeter& meter = ProgressMeter::getSingleton();
+    if (!_measuring)
+      _measuring = meter.attach(this);
+    if (_measuring)
+      meter.addRoot();
+  }
 }
 
 bool TaskEngine::runNextTask() {
   if (_tasks.empty())
     return false;
+  Cancellation::getSingleton().check();
 
-  Task* task = _tasks.back();
+  const PendingTask pending = _tasks.back();
   _tasks.pop_back();
-  task->run(*this);
+  const size_t firstChild = _tasks.size();
+
+  const size_t depthOfNewTasks = _depthOfNewTasks;
+  _depthOfNewTasks = pending.depth + 1;
+  try {
+    pending.task->run(*this);
+  } catch (...) {
+    _depthOfNewTasks = depthOfNewTasks;
+    throw;
+  }
+  _depthOfNewTasks = depthOfNewTasks;
 
+  if (_measuring)
+    measure(pending, firstChild);
   return true;
 }
 
+void TaskEngine::runPendingTask(size_t index) {
+  ASSERT(index < _tasks.size());
+  std::rotate(_tasks.begin() + index, _tasks.begin() + index + 1,
+              _tasks.end());
+  runNextTask();
+}
+
+Task* TaskEngine::removeNextTask() {
+  if (_tasks.empty())
+    return 0;
+  Task* task = _tasks.back().task;
+  _tasks.pop_back();
+  return task;
+}
+
 void TaskEngine::runTasks() {
   while (runNextTask())
     ;
@@ -67,6 +116,40 @@ size_t TaskEngine::getTotalTasksEver() {
   return _totalTasksEver;
 }
 
+size_t TaskEngine::getCurrentDepth() const {
+  return _depthOfNewTasks == 0 ? 0 : _depthOfNewTasks - 1;
+}
+
+void TaskEngine::measure(const PendingTask& pending, size_t firstChild) {
+  ASSERT(_measuring);
+  ProgressMeter& meter = ProgressMeter::getSingleton();
+
+  if (pending.isTreeNode) {
+    // The children of a task are added on top of the stack while it
+    // runs, so they are the tasks from firstChild and on.
+    size_t childCount = 0;
+    for (size_t i = firstChild; i < _tasks.size(); ++i)
+      if (_tasks[i].isTreeNode)
+        ++childCount;
+    if (childCount == 0)
+      meter.addBaseCase(pending.probability, pending.estimate);
+    else {
+      const double probability = pending.probability / childCount;
+      const double estimate = pending.estimate + 1 / probability;
+      for (size_t i = firstChild; i < _tasks.size(); ++i) {
+        _tasks[i].probability = probability;
+        _tasks[i].estimate = estimate;
+      }
+    }
+    meter.nodeDone(pending.depth, _tasks.size());
+  }
+
+  if (_tasks.empty()) {
+    meter.detach(this);
+    _measuring = false;
+  }
+}
+
 void TaskEngine::dispose(Task* task) {
   ASSERT(task != 0);
 
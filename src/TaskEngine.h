@@ -36,6 +36,12 @@ class Task;
  TaskEngine is also the first step towards an implementation where
  sub-computations can be run in parallel. At that time TaskEngine will
  need support for specifying dependencies among tasks.
+
+ The tasks form a tree where the children of a task are the tasks
+ that it adds when it is run. If the ProgressMeter is on, TaskEngine
+ attaches to it when a root is added and feeds it this tree until
+ there are no more pending tasks. Tasks for which Task::isTreeNode()
+ returns false are left out of the tree.
 */
 class TaskEngine {
  public:
@@ -54,10 +60,23 @@ class TaskEngine {
   /** Run the most recently added task that has not been run yet.
 
    Returns true if a task has been run. Returns false if there are no
-   pending tasks.
+   pending tasks. Calls Cancellation::check() before running the task,
+   so the computation can be stopped between tasks. The task is then
+   still pending.
   */
   bool runNextTask();
 
+  /** Runs the pending task at the given index as runNextTask() would
+   if it were the next task. The other pending tasks keep their
+   order. */
+  void runPendingTask(size_t index);
+
+  /** Removes the task that would be run next and returns it without
+   running it. The caller takes over the responsibility of calling
+   run() or dispose() on the task. Returns null if there are no pending
+   tasks. */
+  Task* removeNextTask();
+
   /** Runs all pending tasks.
 
    If a task adds new tasks, those are run as well.
@@ -70,14 +89,55 @@ class TaskEngine {
   */
   size_t getTotalTasksEver();
 
+  /** Returns the depth of the task that is currently being run. A
+   task added while no task is running has depth zero, and a task
+   added while running a task of depth d has depth d + 1. Returns zero
+   if no task is being run. */
+  size_t getCurrentDepth() const;
+
+  /** Returns the number of tasks that have been added but not yet
+   run. */
+  size_t getPendingTaskCount() const {return _tasks.size();}
+
+  /** Returns a pending task. The task at index zero will be run last
+   and the task at index getPendingTaskCount() - 1 will be run
+   next. Adding the pending tasks to another TaskEngine in order of
+   increasing index makes it run them in the same order. */
+  Task* getPendingTask(size_t index) const {
+    ASSERT(index < _tasks.size());
+    return _tasks[index].task;
+  }
+
  private:
   void dispose(Task* task);
 
+  struct PendingTask {
+    Task* task;
+    size_t depth;
+    bool isTreeNode;
+
+    /** The probability that a random probe of the tree reaches this
+     task and the estimate of the size of the tree from such a
+     probe. These are only kept up to date while measuring. */
+    double probability;
+    double estimate;
+  };
+
+  /** Passes the children of pending, which are the tasks from index
+   firstChild, and pending itself on to the ProgressMeter. */
+  void measure(const PendingTask& pending, size_t firstChild);
+
   /** This is used for statistics so that it is not a disaster if this
    overflows for very long-running computations. */
   size_t _totalTasksEver;
 
-  vector<Task*> _tasks;
+  /** The depth given to tasks that are added now. */
+  size_t _depthOfNewTasks;
+
+  vector<PendingTask> _tasks;
+
+  /** Whether this engine is attached to the ProgressMeter. */
+  bool _measuring;
 };
 
 #endif
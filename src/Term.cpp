@@ -18,6 +18,7 @@
 #include "Term.h"
 
 #include "TermPredicate.h"
+#include "Parallel.h"
 #include <sstream>
 #include <vector>
 
@@ -86,7 +87,10 @@ namespace {
 Exponent* Term::allocate(size_t size) {
   ASSERT(size > 0);
 
-  if (size < PoolCount) {
+  // The pools are not thread safe, so they are bypassed inside
+  // parallel regions. Buffers from new and from the pools are
+  // interchangeable so deallocate can still pool buffers from here.
+  if (size < PoolCount && !isInParallelRegion()) {
     pools[size].ensureInit();
     if (!pools[size].empty())
       return pools[size].removeObject();
@@ -101,7 +105,8 @@ void Term::deallocate(Exponent* p, size_t size) {
 
   ASSERT(size > 0);
 
-  if (size < PoolCount && pools[size].canStoreMore())
+  if (size < PoolCount && !isInParallelRegion() &&
+      pools[size].canStoreMore())
     pools[size].addObject(p);
   else
     delete[] p;
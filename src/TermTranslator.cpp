@@ -23,6 +23,8 @@
 #include "VarNames.h"
 #include "FrobbyStringStream.h"
 #include "ElementDeleter.h"
+#include "HashMap.h"
+#include "Parallel.h"
 
 #include <iterator>
 #include <algorithm>
@@ -192,8 +194,72 @@ void TermTranslator::initialize(const vector<BigIdeal*>& bigIdeals,
 
   _exponents.resize(_names.getVarCount());
 
-  for (size_t var = 0; var < _names.getVarCount(); ++var)
-    extractExponents(bigIdeals, _exponents[var], _names.getName(var));
+  // The variables are independent of each other, so they are
+  // extracted in parallel.
+  const long varCount = static_cast<long>(_names.getVarCount());
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long var = 0; var < varCount; ++var) {
+    if (catcher.hasCaught())
+      continue;
+    try {
+      extractExponents(bigIdeals, _exponents[var], _names.getName(var));
+    } catch (...) {
+      catcher.catchCurrent();
+    }
+  }
+  catcher.rethrowIfCaught();
+}
+
+namespace {
+  /** Helper class for shrinkBigIdeal. Translates the exponents of one
+   variable to their IDs. If the exponents are small, they are looked
+   up in a table indexed by the exponent. Otherwise they are looked
+   up in a hash table. Either is faster than a binary search among
+   the big integer exponents. */
+  class ExponentLookup {
+  public:
+    /** exponents is as in TermTranslator::_exponents. */
+    void setExponents(const vector<mpz_class>& exponents) {
+      ASSERT(exponents.size() >= 2);
+
+      // The last exponent is the 0 for the maximal ID, and it is
+      // skipped since 0 must be translated to the ID 0.
+      const size_t idCount = exponents.size() - 1;
+      const mpz_class& maxExponent = exponents[idCount - 1];
+      if (maxExponent.fits_uint_p() &&
+          maxExponent.get_ui() < MaxTableSizePerId * idCount) {
+        _table.resize(maxExponent.get_ui() + 1);
+        for (size_t id = 0; id < idCount; ++id)
+          _table[exponents[id].get_ui()] = static_cast<Exponent>(id);
+      } else {
+        for (size_t id = 0; id < idCount; ++id)
+          _map[exponents[id]] = static_cast<Exponent>(id);
+      }
+    }
+
+    Exponent getId(const mpz_class& exponent) const {
+      if (!_table.empty()) {
+        ASSERT(exponent.fits_uint_p());
+        ASSERT(exponent.get_ui() < _table.size());
+        return _table[exponent.get_ui()];
+      }
+      HashMap<mpz_class, Exponent>::const_iterator it = _map.find(exponent);
+      ASSERT(it != _map.end());
+      return it->second;
+    }
+
+  private:
+    /** Tables are used when they are at most this many times larger
+     than the number of IDs, which keeps the memory use reasonable for
+     sparse exponents. */
+    static const size_t MaxTableSizePerId = 16;
+
+    vector<Exponent> _table;
+    HashMap<mpz_class, Exponent> _map;
+  };
 }
 
 void TermTranslator::shrinkBigIdeal(const BigIdeal& bigIdeal,
@@ -217,15 +283,40 @@ void TermTranslator::shrinkBigIdeal(const BigIdeal& bigIdeal,
     }
   }
 
-  // Insert generators after translating exponents and variables.
-  Term term(ideal.getVarCount());
-  size_t varCount = bigIdeal.getVarCount();
-  for (size_t i = 0; i < bigIdeal.getGeneratorCount(); ++i) {
-    for (size_t var = 0; var < varCount; ++var) {
-      size_t newVar = newVars[var];
-      term[newVar] = shrinkExponent(newVar, bigIdeal.getExponent(i, var));
+  const long varCount = static_cast<long>(bigIdeal.getVarCount());
+  vector<ExponentLookup> lookups(varCount);
+  ParallelExceptionCatcher catcher;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (long var = 0; var < varCount; ++var) {
+    if (catcher.hasCaught())
+      continue;
+    try {
+      lookups[var].setExponents(_exponents[newVars[var]]);
+    } catch (...) {
+      catcher.catchCurrent();
     }
-    ideal.insert(term);
+  }
+  catcher.rethrowIfCaught();
+
+  // Allocate the generators first, since inserting into ideal cannot
+  // be done from several threads at once. Variables of ideal that
+  // bigIdeal does not have are left at zero.
+  const long generatorCount = static_cast<long>(bigIdeal.getGeneratorCount());
+  Term identity(ideal.getVarCount());
+  for (long i = 0; i < generatorCount; ++i)
+    ideal.insert(identity);
+
+  // Translate exponents and variables. The generators are independent,
+  // so blocks of them are translated in parallel.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (long i = 0; i < generatorCount; ++i) {
+    Exponent* term = ideal[i];
+    for (long var = 0; var < varCount; ++var)
+      term[newVars[var]] = lookups[var].getId(bigIdeal.getExponent(i, var));
   }
 }
 
@@ -427,19 +518,6 @@ Exponent TermTranslator::getMaxId(size_t variable) const {
   return _exponents[variable].size() - 1;
 }
 
-Exponent TermTranslator::shrinkExponent(size_t var,
-                                        const mpz_class& exponent) const {
-  const vector<mpz_class>& exponents = _exponents[var];
-
-  // We subtract 1 from exponents.end() to skip past the 0 that is
-  // added there. Otherwise the range would not be sorted.
-  vector<mpz_class>::const_iterator it =
-    lower_bound(exponents.begin(), exponents.end() - 1, exponent);
-  ASSERT(*it == exponent);
-
-  return it - exponents.begin();
-}
-
 const VarNames& TermTranslator::getNames() const {
   return _names;
 }
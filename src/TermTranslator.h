@@ -127,7 +127,6 @@ private:
 
   void initialize(const vector<BigIdeal*>& bigIdeals, bool sortVars);
   void shrinkBigIdeal(const BigIdeal& bigIdeal, Ideal& ideal) const;
-  Exponent shrinkExponent(size_t var, const mpz_class& exponent) const;
 
   vector<vector<mpz_class> > _exponents;
   mutable vector<vector<const char*> > _stringExponents;
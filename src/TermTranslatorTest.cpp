@@ -18,6 +18,9 @@
 #include "TermTranslator.h"
 #include "tests.h"
 
+#include "BigIdeal.h"
+#include "Ideal.h"
+
 TEST_SUITE(TermTranslator)
 
 TEST(TermTranslator, IdentityConstructor) {
@@ -29,3 +32,31 @@ TEST(TermTranslator, IdentityConstructor) {
             " var 3: 0 1 2 3 4 5 6 7 8 9 0\n"
             ")\n");
 }
+
+TEST(TermTranslator, TranslateBigIdeal) {
+  // The exponents of the first variable are small and dense, while
+  // those of the other variables are sparse or do not fit in a
+  // machine word.
+  const char* exponents[][3] = {
+    {"0", "5", "100000000000000000000000"},
+    {"3", "1000000", "7"},
+    {"5", "5", "0"}
+  };
+  const size_t termCount = sizeof(exponents) / sizeof(exponents[0]);
+  BigIdeal bigIdeal((VarNames(3)));
+  for (size_t term = 0; term < termCount; ++term) {
+    bigIdeal.newLastTerm();
+    for (size_t var = 0; var < 3; ++var)
+      bigIdeal.getLastTermExponentRef(var) = mpz_class(exponents[term][var]);
+  }
+
+  Ideal ideal;
+  TermTranslator translator(bigIdeal, ideal, false);
+  ASSERT_EQ(ideal.getGeneratorCount(), termCount);
+  for (size_t term = 0; term < termCount; ++term) {
+    for (size_t var = 0; var < 3; ++var) {
+      ASSERT_EQ(translator.getExponent(var, ideal[term][var]),
+                mpz_class(exponents[term][var]));
+    }
+  }
+}
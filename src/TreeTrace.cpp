@@ -0,0 +1,249 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "TreeTrace.h"
+
+#include "Parallel.h"
+#include "error.h"
+#include <limits>
+#include <algorithm>
+#include <map>
+
+const unsigned int TreeTrace::NoVar;
+const size_t TreeTrace::DefaultCapacity;
+
+namespace {
+  unsigned int clampToUnsignedInt(size_t value) {
+    if (value > std::numeric_limits<unsigned int>::max())
+      return std::numeric_limits<unsigned int>::max();
+    return static_cast<unsigned int>(value);
+  }
+}
+
+TreeTrace::TreeTrace():
+  _enabled(false),
+  _suspendCount(0),
+  _inNode(false),
+  _capacity(DefaultCapacity),
+  _oldest(0),
+  _droppedNodeCount(0) {
+}
+
+TreeTrace& TreeTrace::getSingleton() {
+  static TreeTrace singleton;
+  return singleton;
+}
+
+void TreeTrace::setEnabled(bool enabled) {
+  clear();
+  _enabled = enabled;
+}
+
+void TreeTrace::setCapacity(size_t capacity) {
+  ASSERT(capacity > 0);
+  clear();
+  _capacity = capacity;
+}
+
+void TreeTrace::clear() {
+  std::vector<Node>().swap(_nodes);
+  _oldest = 0;
+  _droppedNodeCount = 0;
+  _inNode = false;
+  _timer.reset();
+}
+
+void TreeTrace::beginNode(Algorithm algorithm, size_t depth,
+                          size_t genCount, size_t varCount) {
+  if (!isEnabled() || isInParallelRegion())
+    return;
+  if (_inNode)
+    endNode();
+
+  _current.start = getMicroseconds();
+  _current.duration = 0;
+  _current.depth = clampToUnsignedInt(depth);
+  _current.genCount = clampToUnsignedInt(genCount);
+  _current.varCount = clampToUnsignedInt(varCount);
+  _current.pivotVar = NoVar;
+  _current.pivotSupport = 0;
+  _current.algorithm = static_cast<unsigned char>(algorithm);
+  _current.kind = UnknownNode;
+  _inNode = true;
+}
+
+void TreeTrace::setNodeKind(NodeKind kind,
+                            size_t pivotVar, size_t pivotSupport) {
+  if (!_inNode || _suspendCount > 0 || isInParallelRegion())
+    return;
+  _current.kind = static_cast<unsigned char>(kind);
+  _current.pivotVar = clampToUnsignedInt(pivotVar);
+  _current.pivotSupport = clampToUnsignedInt(pivotSupport);
+}
+
+void TreeTrace::endNode() {
+  if (!_inNode || isInParallelRegion())
+    return;
+  _inNode = false;
+
+  const unsigned long now = getMicroseconds();
+  _current.duration = now < _current.start ? 0 : now - _current.start;
+
+  if (_nodes.size() < _capacity) {
+    try {
+      _nodes.push_back(_current);
+      return;
+    } catch (const bad_alloc&) {
+      // Treat the buffer as full so that tracing does not make the
+      // computation fail.
+      if (_nodes.empty())
+        return;
+      _capacity = _nodes.size();
+    }
+  }
+
+  _nodes[_oldest] = _current;
+  ++_oldest;
+  if (_oldest == _nodes.size())
+    _oldest = 0;
+  ++_droppedNodeCount;
+}
+
+size_t TreeTrace::getNodeCount() const {
+  return _nodes.size();
+}
+
+void TreeTrace::writeChromeTrace(FILE* out) const {
+  std::vector<unsigned long> ends;
+  computeEnds(ends);
+
+  fputs("{\"traceEvents\":[", out);
+  for (size_t i = 0; i < getNodeCount(); ++i) {
+    const Node& node = getNode(i);
+    if (i > 0)
+      fputc(',', out);
+    fprintf(out, "\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+            "\"pid\":1,\"tid\":1,\"ts\":%lu,\"dur\":%lu,\"args\":{"
+            "\"depth\":%u,\"generators\":%u,\"variables\":%u,"
+            "\"selfMicroseconds\":%lu",
+            getKindName(node.kind), getAlgorithmName(node.algorithm),
+            node.start, ends[i] - node.start,
+            node.depth, node.genCount, node.varCount, node.duration);
+    if (node.pivotVar != NoVar)
+      fprintf(out, ",\"pivotVar\":%u", node.pivotVar);
+    if (node.pivotSupport != 0)
+      fprintf(out, ",\"pivotSupport\":%u", node.pivotSupport);
+    fputs("}}", out);
+  }
+  fprintf(out, "\n],\"displayTimeUnit\":\"ms\","
+          "\"otherData\":{\"droppedNodes\":%lu}}\n", _droppedNodeCount);
+}
+
+void TreeTrace::writeFoldedStacks(FILE* out) const {
+  // The frames of the path from the root to the current node. The
+  // path is shared between nodes, so only the tail is changed.
+  std::vector<string> path;
+  std::map<string, unsigned long> microsecondsByStack;
+  string stack;
+  for (size_t i = 0; i < getNodeCount(); ++i) {
+    const Node& node = getNode(i);
+    path.resize(node.depth + 1, "[unknown]");
+    path[0] = getAlgorithmName(node.algorithm);
+    path.push_back(getKindName(node.kind));
+
+    stack.clear();
+    for (size_t frame = 0; frame < path.size(); ++frame) {
+      if (frame > 0)
+        stack += ';';
+      stack += path[frame];
+    }
+    microsecondsByStack[stack] += node.duration;
+  }
+
+  std::map<string, unsigned long>::const_iterator it =
+    microsecondsByStack.begin();
+  for (; it != microsecondsByStack.end(); ++it)
+    fprintf(out, "%s %lu\n", it->first.c_str(), it->second);
+}
+
+void TreeTrace::write(const string& format, FILE* out) const {
+  validateFormat(format);
+  if (format == "chrome")
+    writeChromeTrace(out);
+  else
+    writeFoldedStacks(out);
+}
+
+void TreeTrace::validateFormat(const string& format) {
+  if (format != "chrome" && format != "folded")
+    reportError("Unknown trace format \"" + format + "\".");
+}
+
+const TreeTrace::Node& TreeTrace::getNode(size_t index) const {
+  ASSERT(index < _nodes.size());
+  index += _oldest;
+  if (index >= _nodes.size())
+    index -= _nodes.size();
+  return _nodes[index];
+}
+
+void TreeTrace::computeEnds(std::vector<unsigned long>& ends) const {
+  // The descendants of a node are the nodes that follow it until the
+  // next node that is not deeper, so a node ends when the last of
+  // those ends.
+  ends.resize(getNodeCount());
+  std::vector<size_t> open;
+  unsigned long lastEnd = 0;
+  for (size_t i = 0; i < getNodeCount(); ++i) {
+    const Node& node = getNode(i);
+    while (!open.empty() && getNode(open.back()).depth >= node.depth) {
+      ends[open.back()] = lastEnd;
+      open.pop_back();
+    }
+    open.push_back(i);
+    lastEnd = std::max(lastEnd, node.start + node.duration);
+  }
+  while (!open.empty()) {
+    ends[open.back()] = lastEnd;
+    open.pop_back();
+  }
+}
+
+unsigned long TreeTrace::getMicroseconds() const {
+  return static_cast<unsigned long>(_timer.getSeconds() * 1000000);
+}
+
+const char* TreeTrace::getAlgorithmName(unsigned char algorithm) {
+  switch (algorithm) {
+  case SliceAlgorithm: return "slice";
+  case BigattiAlgorithm: return "bigatti";
+  case EulerAlgorithm: return "euler";
+  default: return "unknown";
+  }
+}
+
+const char* TreeTrace::getKindName(unsigned char kind) {
+  switch (kind) {
+  case BaseCase: return "base";
+  case PivotSplit: return "pivot";
+  case LabelSplit: return "label";
+  case IndependenceSplit: return "independence";
+  case GeneratorSplit: return "generator";
+  default: return "unknown";
+  }
+}
@@ -0,0 +1,222 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef TREE_TRACE_GUARD
+#define TREE_TRACE_GUARD
+
+#include "WallTimer.h"
+#include <vector>
+
+/** Records the nodes of the computation tree of the Slice, Bigatti
+ et.al. and Euler characteristic algorithms. For each node the trace
+ stores the depth, the number of generators and variables, what kind
+ of split or base case the node was, the pivot and the time spent
+ processing the node, excluding the time spent on its children.
+
+ The nodes are stored in fixed-size records in a ring buffer, so a
+ trace of a long computation keeps the most recent nodes and uses a
+ bounded amount of memory. The algorithms process the tree depth
+ first, so the descendants of a node follow it directly in the
+ trace. This is used to reconstruct the tree when writing the trace
+ either as JSON for the Chrome trace viewer or as folded stacks for
+ flame graph tools.
+
+ The trace does nothing unless it has been enabled. Nodes must be
+ recorded from the thread that began the computation. Calls from
+ inside a parallel region are ignored. */
+class TreeTrace {
+ public:
+  /** The algorithm that a node belongs to. */
+  enum Algorithm {
+    SliceAlgorithm,
+    BigattiAlgorithm,
+    EulerAlgorithm
+  };
+
+  /** What was done to a node. A node has kind UnknownNode if the
+   algorithm did not report what it did. */
+  enum NodeKind {
+    UnknownNode,
+    BaseCase,
+    PivotSplit,
+    LabelSplit,
+    IndependenceSplit,
+    GeneratorSplit
+  };
+
+  /** The value of the pivot variable of nodes that have no such
+   variable. */
+  static const unsigned int NoVar = static_cast<unsigned int>(-1);
+
+  /** The default maximal number of nodes kept in the ring buffer. */
+  static const size_t DefaultCapacity = 1 << 20;
+
+  /** Returns the trace for the whole program. */
+  static TreeTrace& getSingleton();
+
+  /** Enabling the trace clears it. */
+  void setEnabled(bool enabled);
+
+  /** Returns true if nodes are being recorded, which is when the trace
+   is enabled and not suspended. */
+  bool isEnabled() const {return _enabled && _suspendCount == 0;}
+
+  /** Nodes are not recorded while the trace is suspended. This is used
+   when an algorithm runs another algorithm as part of processing a
+   node, since nodes cannot be nested. Suspensions can be nested, and
+   each call to suspend has to be matched by a call to unsuspend. */
+  void suspend() {++_suspendCount;}
+  void unsuspend() {
+    ASSERT(_suspendCount > 0);
+    --_suspendCount;
+  }
+
+  /** Sets the maximal number of nodes that are kept. Clears the
+   trace. capacity must not be zero. */
+  void setCapacity(size_t capacity);
+
+  /** Removes all recorded nodes. */
+  void clear();
+
+  /** Begins recording a node. Nodes cannot be nested, so the node
+   has to be ended before the next one is begun. */
+  void beginNode(Algorithm algorithm, size_t depth,
+                 size_t genCount, size_t varCount);
+
+  /** Records what was done to the node that is being recorded. The
+   pivot is described by the first variable that it involves and by
+   the number of variables that it involves. */
+  void setNodeKind(NodeKind kind,
+                   size_t pivotVar = NoVar, size_t pivotSupport = 0);
+
+  /** Ends the node that is being recorded. */
+  void endNode();
+
+  /** Returns the number of nodes that are currently kept. */
+  size_t getNodeCount() const;
+
+  /** Returns the number of nodes that have been overwritten because
+   the ring buffer was full. */
+  unsigned long getDroppedNodeCount() const {return _droppedNodeCount;}
+
+  /** Writes the trace to out in the JSON format of the Chrome trace
+   viewer. Each node is a complete event whose duration includes the
+   time spent on its descendants. */
+  void writeChromeTrace(FILE* out) const;
+
+  /** Writes the trace to out as folded stacks. Each line is the path
+   from the root to a node followed by the number of microseconds
+   spent processing nodes with that path. Parts of the path that are
+   no longer in the trace are shown as [unknown]. */
+  void writeFoldedStacks(FILE* out) const;
+
+  /** Writes the trace in the format with the given name, which is
+   either chrome or folded. Reports an error if the format is
+   unknown. */
+  void write(const string& format, FILE* out) const;
+
+  /** Reports an error if format is not the name of a trace format. */
+  static void validateFormat(const string& format);
+
+ private:
+  TreeTrace();
+  TreeTrace(const TreeTrace&); // unavailable
+  void operator=(const TreeTrace&); // unavailable
+
+  struct Node {
+    unsigned long start; /// microseconds since the trace was enabled
+    unsigned long duration; /// microseconds spent on the node itself
+    unsigned int depth;
+    unsigned int genCount;
+    unsigned int varCount;
+    unsigned int pivotVar;
+    unsigned int pivotSupport;
+    unsigned char algorithm;
+    unsigned char kind;
+  };
+
+  /** Returns the node that is index nodes after the oldest node. */
+  const Node& getNode(size_t index) const;
+
+  /** Sets ends[i] to the time when the processing of getNode(i) and
+   all its descendants ended. */
+  void computeEnds(std::vector<unsigned long>& ends) const;
+
+  unsigned long getMicroseconds() const;
+
+  static const char* getAlgorithmName(unsigned char algorithm);
+  static const char* getKindName(unsigned char kind);
+
+  bool _enabled;
+  size_t _suspendCount;
+  bool _inNode; /// true if _current is being recorded
+  Node _current;
+  WallTimer _timer;
+
+  size_t _capacity;
+  std::vector<Node> _nodes;
+  size_t _oldest; /// index in _nodes of the oldest node once full
+  unsigned long _droppedNodeCount;
+};
+
+/** Records a node in the TreeTrace while an object of this class is
+ alive. Does nothing if the trace is not enabled. */
+class TraceNode {
+ public:
+  TraceNode(TreeTrace::Algorithm algorithm, size_t depth,
+            size_t genCount, size_t varCount):
+    _trace(TreeTrace::getSingleton()) {
+    if (_trace.isEnabled())
+      _trace.beginNode(algorithm, depth, genCount, varCount);
+  }
+
+  ~TraceNode() {
+    if (_trace.isEnabled())
+      _trace.endNode();
+  }
+
+ private:
+  TraceNode(const TraceNode&); // unavailable
+  void operator=(const TraceNode&); // unavailable
+
+  TreeTrace& _trace;
+};
+
+/** Suspends the TreeTrace while an object of this class is alive. */
+class TraceSuspension {
+ public:
+  TraceSuspension(): _trace(TreeTrace::getSingleton()) {_trace.suspend();}
+  ~TraceSuspension() {_trace.unsuspend();}
+
+ private:
+  TraceSuspension(const TraceSuspension&); // unavailable
+  void operator=(const TraceSuspension&); // unavailable
+
+  TreeTrace& _trace;
+};
+
+/** Records the kind of the node currently being recorded in the
+ TreeTrace if the trace is enabled. */
+inline void traceNodeKind(TreeTrace::NodeKind kind,
+                          size_t pivotVar = TreeTrace::NoVar,
+                          size_t pivotSupport = 0) {
+  TreeTrace& trace = TreeTrace::getSingleton();
+  if (trace.isEnabled())
+    trace.setNodeKind(kind, pivotVar, pivotSupport);
+}
+
+#endif
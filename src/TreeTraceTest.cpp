@@ -0,0 +1,102 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#include "stdinc.h"
+#include "TreeTrace.h"
+#include "tests.h"
+
+TEST_SUITE(TreeTrace)
+
+namespace {
+  /** Enables the trace while alive and disables it afterwards, so
+   that tests do not leave the trace enabled for the rest of the
+   program. */
+  class EnableTrace {
+  public:
+    EnableTrace(size_t capacity) {
+      TreeTrace::getSingleton().setCapacity(capacity);
+      TreeTrace::getSingleton().setEnabled(true);
+    }
+
+    ~EnableTrace() {
+      TreeTrace::getSingleton().setEnabled(false);
+      TreeTrace::getSingleton().setCapacity(TreeTrace::DefaultCapacity);
+    }
+  };
+
+  void addNode(size_t depth, TreeTrace::NodeKind kind) {
+    TraceNode node(TreeTrace::SliceAlgorithm, depth, 10, 3);
+    traceNodeKind(kind);
+  }
+
+  string getFoldedStacks() {
+    FILE* file = tmpfile();
+    TreeTrace::getSingleton().writeFoldedStacks(file);
+    rewind(file);
+
+    string folded;
+    char buffer[256];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+      folded.append(buffer, read);
+    fclose(file);
+
+    // The times vary, so remove them.
+    string withoutTimes;
+    for (size_t i = 0; i < folded.size(); ++i) {
+      if (folded[i] == ' ') {
+        while (i < folded.size() && folded[i] != '\n')
+          ++i;
+      }
+      if (i < folded.size())
+        withoutTimes += folded[i];
+    }
+    return withoutTimes;
+  }
+}
+
+TEST(TreeTrace, Disabled) {
+  addNode(0, TreeTrace::BaseCase);
+  ASSERT_EQ(TreeTrace::getSingleton().getNodeCount(), 0u);
+}
+
+TEST(TreeTrace, FoldedStacks) {
+  EnableTrace enable(100);
+  addNode(0, TreeTrace::PivotSplit);
+  addNode(1, TreeTrace::BaseCase);
+  addNode(1, TreeTrace::PivotSplit);
+  addNode(2, TreeTrace::BaseCase);
+  addNode(2, TreeTrace::BaseCase);
+  ASSERT_EQ(TreeTrace::getSingleton().getNodeCount(), 5u);
+  ASSERT_EQ(getFoldedStacks(),
+            "slice;pivot\n"
+            "slice;pivot;base\n"
+            "slice;pivot;pivot\n"
+            "slice;pivot;pivot;base\n");
+}
+
+TEST(TreeTrace, RingBuffer) {
+  EnableTrace enable(2);
+  addNode(0, TreeTrace::PivotSplit);
+  addNode(1, TreeTrace::LabelSplit);
+  addNode(2, TreeTrace::BaseCase);
+  ASSERT_EQ(TreeTrace::getSingleton().getNodeCount(), 2u);
+  ASSERT_EQ(TreeTrace::getSingleton().getDroppedNodeCount(), 1u);
+  ASSERT_EQ(getFoldedStacks(),
+            "slice;[unknown];label\n"
+            "slice;[unknown];label;base\n");
+}
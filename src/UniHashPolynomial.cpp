@@ -50,6 +50,13 @@ void UniHashPolynomial::add(const mpz_class& coef, const mpz_class& exponent) {
     _terms.erase(exponent);
 }
 
+void UniHashPolynomial::add(const UniHashPolynomial& poly) {
+  TermMap::const_iterator termsEnd = poly._terms.end();
+  TermMap::const_iterator it = poly._terms.begin();
+  for (; it != termsEnd; ++it)
+    add(it->second, it->first);
+}
+
 namespace {
   /** Helper class for feedTo. */
   class RefCompare {
@@ -22,18 +22,6 @@
 
 class CoefBigTermConsumer;
 
-/** This template specialization makes the hash code of an mpz_clas
- available to the implementation of HashMap.
-*/
-template<>
-class FrobbyHash<mpz_class> {
- public:
-  size_t operator()(const mpz_class& i) const {
-    // The constant is a prime. This method needs to be improved.
-    return mpz_fdiv_ui(i.get_mpz_t(), 2106945901u);
-  }
-};
-
 /** A sparse univariate polynomial represented by a hash table mapping
  terms to coefficients. This allows to avoid duplicate terms without a
  large overhead.
@@ -50,6 +38,9 @@ class UniHashPolynomial {
   /** Add coef*t^exponent to the polynomial. */
   void add(const mpz_class& coef, const mpz_class& exponent);
 
+  /** Add poly to this polynomial. */
+  void add(const UniHashPolynomial& poly);
+
   void feedTo(CoefBigTermConsumer& consumer, bool inCanonicalOrder = false) const;
 
   size_t getTermCount() const;
@@ -0,0 +1,54 @@
+/* Frobby: Software for monomial ideal computations.
+   Copyright (C) 2011 University of Aarhus
+   Contact Bjarke Hammersholt Roune for license information (www.broune.com)
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see http://www.gnu.org/licenses/.
+*/
+#ifndef WALL_TIMER_GUARD
+#define WALL_TIMER_GUARD
+
+/** Measures spans of wall clock time. Use Timer to measure CPU time.
+
+ Unlike CPU time, wall clock time keeps running while the process
+ waits, and it does not add up the time of several threads. */
+class WallTimer {
+public:
+  WallTimer() {reset();}
+
+  /** Resets the amount of elapsed wall clock time to zero. */
+  void reset() {_secondsAtReset = getSecondsSinceEpoch();}
+
+  /** Returns the number of wall clock seconds since the last reset. */
+  double getSeconds() const;
+
+  /** Returns the number of wall clock milliseconds since the last
+   reset, rounded to the nearest millisecond. */
+  unsigned long getMilliseconds() const;
+
+  /** Prints the elapsed time in the same format as Timer::print. */
+  void print(FILE* out) const;
+
+  /** Reading the clock takes about as long as a short step of an
+   algorithm, so code that watches the time between steps only reads
+   it once per this many steps. */
+  static const size_t StepsPerReading = 16;
+
+private:
+  /** Returns the number of seconds since some fixed point in time. */
+  static double getSecondsSinceEpoch();
+
+  double _secondsAtReset;
+};
+
+#endif
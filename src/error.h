@@ -69,5 +69,6 @@ void throwError(const string& errorMsg) {
 DEFINE_EXCEPTION(UnknownName);
 DEFINE_EXCEPTION(AmbiguousName);
 DEFINE_EXCEPTION(Unsupported);
+DEFINE_EXCEPTION(Cancelled);
 
 #endif
@@ -26,6 +26,8 @@
 #include "CoefBigTermConsumer.h"
 #include "IdealFacade.h"
 #include "SliceParams.h"
+#include "Cancellation.h"
+#include "ProgressMeter.h"
 
 class ConsumerWrapper {
 protected:
@@ -150,6 +152,58 @@ private:
   size_t _varCount;
 };
 
+namespace {
+  /** The time limit set through Frobby::setTimeLimit for the next
+   computation. */
+  unsigned long libraryTimeLimit = 0;
+
+  /** Marks a computation of the library for Cancellation while an
+   object of this class is alive. The computation takes over the time
+   limit, so later computations have no limit unless one is set
+   again. */
+  class LibraryComputation {
+  public:
+    LibraryComputation() {
+      Cancellation::getSingleton().start(libraryTimeLimit);
+      libraryTimeLimit = 0;
+    }
+
+    ~LibraryComputation() {
+      Cancellation::getSingleton().finish();
+    }
+  };
+}
+
+namespace {
+  /** Passes the reports of the ProgressMeter on to a consumer of the
+   library. */
+  class LibraryProgressReporter : public ProgressReporter {
+  public:
+    LibraryProgressReporter(): _consumer(0) {}
+
+    void setConsumer(Frobby::ProgressConsumer* consumer) {
+      _consumer = consumer;
+    }
+
+    virtual void report(const ::ProgressReport& report) {
+      ASSERT(_consumer != 0);
+      Frobby::ProgressReport libraryReport;
+      libraryReport.milliseconds = report.milliseconds;
+      libraryReport.nodeCount = report.nodeCount;
+      libraryReport.baseCaseCount = report.baseCaseCount;
+      libraryReport.outputTermCount = report.outputTermCount;
+      libraryReport.pendingCount = report.pendingCount;
+      libraryReport.depth = report.depth;
+      libraryReport.doneFraction = report.doneFraction;
+      libraryReport.estimatedNodeCount = report.estimatedNodeCount;
+      _consumer->consume(libraryReport);
+    }
+
+  private:
+    Frobby::ProgressConsumer* _consumer;
+  } libraryProgressReporter;
+}
+
 Frobby::IdealConsumer::~IdealConsumer() {
 }
 
@@ -168,6 +222,9 @@ void Frobby::PolynomialConsumer::polynomialBegin(size_t varCount) {
 void Frobby::PolynomialConsumer::polynomialEnd() {
 }
 
+Frobby::ProgressConsumer::~ProgressConsumer() {
+}
+
 namespace FrobbyImpl {
   using ::BigIdeal;
 
@@ -242,6 +299,7 @@ void Frobby::Ideal::addExponent(unsigned int exponent) {
 bool Frobby::alexanderDual(const Ideal& ideal,
                            const mpz_t* reflectionMonomial,
                            IdealConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   ExternalIdealConsumerWrapper wrappedConsumer
@@ -250,9 +308,12 @@ bool Frobby::alexanderDual(const Ideal& ideal,
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  if (reflectionMonomial == 0)
-    facade.computeAlexanderDual();
-  else {
+  if (reflectionMonomial == 0) {
+    try {
+      facade.computeAlexanderDual();
+    } catch (const CancelledException&) {
+    }
+  } else {
     vector<mpz_class> point;
     point.resize(bigIdeal.getVarCount());
     for (size_t var = 0; var < bigIdeal.getVarCount(); ++var)
@@ -264,6 +325,7 @@ bool Frobby::alexanderDual(const Ideal& ideal,
 
     try {
       facade.computeAlexanderDual(point);
+    } catch (const CancelledException&) {
     } catch (const FrobbyException&) {
       return false;
     }
@@ -294,6 +356,7 @@ bool Frobby::alexanderDual(const Ideal& ideal,
 
 void Frobby::multigradedHilbertPoincareSeries(const Ideal& ideal,
                                               PolynomialConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   ExternalPolynomialConsumerWrapper wrappedConsumer
@@ -301,18 +364,25 @@ void Frobby::multigradedHilbertPoincareSeries(const Ideal& ideal,
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  facade.computeMultigradedHilbertSeries();
+  try {
+    facade.computeMultigradedHilbertSeries();
+  } catch (const CancelledException&) {
+  }
 }
 
 void Frobby::univariateHilbertPoincareSeries(const Ideal& ideal,
                                              PolynomialConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   ExternalPolynomialConsumerWrapper wrappedConsumer(&consumer, 1);
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  facade.computeUnivariateHilbertSeries();
+  try {
+    facade.computeUnivariateHilbertSeries();
+  } catch (const CancelledException&) {
+  }
 }
 
 /**
@@ -376,6 +446,7 @@ void Frobby::irreducibleDecompositionAsIdeals(const Ideal& ideal,
 
 bool Frobby::irreducibleDecompositionAsMonomials(const Ideal& ideal,
                                                  IdealConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
   if (bigIdeal.getGeneratorCount() == 0)
     return false;
@@ -385,12 +456,16 @@ bool Frobby::irreducibleDecompositionAsMonomials(const Ideal& ideal,
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  facade.computeIrreducibleDecomposition(true);
+  try {
+    facade.computeIrreducibleDecomposition(true);
+  } catch (const CancelledException&) {
+  }
   return true;
 }
 
 void Frobby::primaryDecomposition(const Ideal& ideal,
 								  IdealConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   ExternalIdealConsumerWrapper wrappedConsumer
@@ -398,11 +473,15 @@ void Frobby::primaryDecomposition(const Ideal& ideal,
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  facade.computePrimaryDecomposition();
+  try {
+    facade.computePrimaryDecomposition();
+  } catch (const CancelledException&) {
+  }
 }
 
 void Frobby::maximalStandardMonomials(const Ideal& ideal,
                                       IdealConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   ExternalIdealConsumerWrapper wrappedConsumer
@@ -410,7 +489,10 @@ void Frobby::maximalStandardMonomials(const Ideal& ideal,
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  facade.computeMaximalStandardMonomials();
+  try {
+    facade.computeMaximalStandardMonomials();
+  } catch (const CancelledException&) {
+  }
 }
 
 bool Frobby::solveStandardMonomialProgram(const Ideal& ideal,
@@ -418,6 +500,7 @@ bool Frobby::solveStandardMonomialProgram(const Ideal& ideal,
                                           IdealConsumer& consumer) {
   ASSERT(l != 0);
 
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   vector<mpz_class> grading;
@@ -431,7 +514,11 @@ bool Frobby::solveStandardMonomialProgram(const Ideal& ideal,
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
   mpz_class dummy;
-  return facade.solveStandardProgram(grading, dummy, false);
+  try {
+    return facade.solveStandardProgram(grading, dummy, false);
+  } catch (const CancelledException&) {
+    return false;
+  }
 }
 
 void Frobby::codimension(const Ideal& ideal, mpz_t codim) {
@@ -441,14 +528,19 @@ void Frobby::codimension(const Ideal& ideal, mpz_t codim) {
 }
 
 void Frobby::dimension(const Ideal& ideal, mpz_t dim) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
 
   IdealFacade facade(false);
-  mpz_class dimen = facade.computeDimension(bigIdeal, false);
-  mpz_set(dim, dimen.get_mpz_t());
+  try {
+    mpz_class dimen = facade.computeDimension(bigIdeal, false);
+    mpz_set(dim, dimen.get_mpz_t());
+  } catch (const CancelledException&) {
+  }
 }
 
 void Frobby::associatedPrimes(const Ideal& ideal, IdealConsumer& consumer) {
+  LibraryComputation computation;
   const BigIdeal& bigIdeal = FrobbyImpl::FrobbyIdealHelper::getIdeal(ideal);
   IrreducibleIdealDecoder decodingConsumer(&consumer);
 
@@ -457,5 +549,35 @@ void Frobby::associatedPrimes(const Ideal& ideal, IdealConsumer& consumer) {
   SliceParams params;
   SliceFacade facade(params, bigIdeal, wrappedConsumer);
 
-  facade.computeAssociatedPrimes();
+  try {
+    facade.computeAssociatedPrimes();
+  } catch (const CancelledException&) {
+  }
+}
+
+void Frobby::setTimeLimit(unsigned long milliseconds) {
+  libraryTimeLimit = milliseconds;
+}
+
+void Frobby::cancel() {
+  Cancellation::getSingleton().cancel();
+}
+
+bool Frobby::wasCancelled() {
+  return Cancellation::getSingleton().wasCancelled();
+}
+
+size_t Frobby::getStepCount() {
+  return Cancellation::getSingleton().getStepCount();
+}
+
+unsigned long Frobby::getMilliseconds() {
+  return Cancellation::getSingleton().getMilliseconds();
+}
+
+void Frobby::setProgressConsumer(ProgressConsumer* consumer,
+                                 unsigned long interval) {
+  libraryProgressReporter.setConsumer(consumer);
+  ProgressMeter::getSingleton().setReporter
+    (consumer == 0 ? 0 : &libraryProgressReporter, interval);
 }
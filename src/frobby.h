@@ -135,6 +135,57 @@ namespace Frobby {
     virtual void polynomialEnd();
   };
 
+  /** A report on how far a computation has got. The Slice Algorithm,
+   the algorithm of Bigatti et.al. and the Euler characteristic
+   algorithm form a tree of nodes, where a node is for example a
+   slice, and this is a report on that tree. Other algorithms are not
+   reported on.
+  */
+  struct ProgressReport {
+    /** The wall clock milliseconds since the tree was begun. */
+    unsigned long milliseconds;
+
+    /** The number of nodes that have been processed. */
+    size_t nodeCount;
+
+    /** The number of processed nodes that were base cases. */
+    size_t baseCaseCount;
+
+    /** The number of terms that have been output. */
+    size_t outputTermCount;
+
+    /** The number of nodes that are waiting to be processed. */
+    size_t pendingCount;
+
+    /** The depth in the tree of the most recently processed node. */
+    size_t depth;
+
+    /** The estimated fraction of the tree that has been processed. The
+     estimate is zero until the first base case and it is biased
+     towards the part of the tree that was done first. */
+    double doneFraction;
+
+    /** The estimated number of nodes of the whole tree, or zero before
+     the first base case. This estimate can be far off early in a
+     computation, but it is exact once the tree is done. */
+    double estimatedNodeCount;
+  };
+
+  /** This class provides a way to follow the progress of a
+   computation, for example to decide whether to let it run or to
+   cancel it and try other options.
+  */
+  class ProgressConsumer {
+  public:
+    /** The provided implementation does nothing. */
+    virtual ~ProgressConsumer();
+
+    /** Called periodically while a computation is running. It is
+     allowed to call cancel() from here.
+    */
+    virtual void consume(const ProgressReport& report) = 0;
+  };
+
   /** Compute the Alexander dual of ideal using the point
    reflectionMonomial. The minimal generators of the dual are provided
    to the consumer in some arbitrary order. If reflectionMonomial is
@@ -312,6 +363,51 @@ namespace Frobby {
 
    The prime ideals are passed to the consumer in arbitrary order. */
   void associatedPrimes(const Ideal& ideal, IdealConsumer& consumer);
+
+  /** Stops the next computation started after this call once it has
+   run for the given number of wall clock milliseconds, as if cancel()
+   had been called at that time. The limit only applies to that one
+   computation, so call this again before each computation that is to
+   have a limit. A time limit of zero means that there is no limit.
+  */
+  void setTimeLimit(unsigned long milliseconds);
+
+  /** Stops the computation that is running now. The computation stops
+   at the end of its current step, and the function that started it
+   then returns as usual while wasCancelled() returns true. This only
+   sets a flag, so it can be called from another thread, from a signal
+   handler or from a consumer. A call while no computation is running
+   has no effect.
+  */
+  void cancel();
+
+  /** Returns true if the most recent computation was stopped by
+   cancel() or by the time limit. The output passed to the consumer is
+   then incomplete, the call that ends the output may not have been
+   made and the value returned by the function that started the
+   computation is meaningless.
+  */
+  bool wasCancelled();
+
+  /** Returns the number of steps done by the most recent computation,
+   such as slices of the Slice Algorithm. For a computation that was
+   stopped, this indicates how far it got.
+  */
+  size_t getStepCount();
+
+  /** Returns the wall clock milliseconds taken by the most recent
+   computation. */
+  unsigned long getMilliseconds();
+
+  /** Passes a report on each later computation to consumer about every
+   interval wall clock milliseconds. An interval of zero asks for
+   reports as often as they can be made. A null consumer turns the
+   reports off, which is the default. Frobby does not take over
+   ownership of consumer, which must stay alive until reports are
+   turned off.
+  */
+  void setProgressConsumer(ProgressConsumer* consumer,
+                           unsigned long interval);
 }
 
 #endif
@@ -21,9 +21,49 @@
 #include "DebugAllocator.h"
 #include "error.h"
 #include "display.h"
+#include "Profiler.h"
+#include "TreeTrace.h"
+#include "Cancellation.h"
+#include "ProgressMeter.h"
 
 #include <ctime>
 #include <cstdlib>
+#ifdef __GNUC__ // Only GCC defines this macro.
+#include <unistd.h>
+#endif
+
+namespace {
+  /** Output to files and pipes is written in chunks of this many
+   bytes. Large outputs are written much faster with a large buffer
+   than with the default of a few kilobytes. */
+  const size_t OutputBufferSize = 1 << 20;
+
+  /** Opens fileName for writing, or reports an error mentioning what
+   the file was for. Files are opened before the computation starts so
+   that a bad file name is reported before the time is spent. */
+  FILE* openReportFile(const string& fileName, const char* purpose) {
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (file == 0)
+      reportError("Could not open file \"" + fileName +
+                  "\" for writing the " + purpose + ".");
+    return file;
+  }
+
+  /** Writes the profile and the trace to the files opened for them,
+   if any, and closes the files. */
+  void writeReportFiles(const Action& action,
+                        FILE* profileFile, FILE* traceFile) {
+    if (profileFile != 0) {
+      Profiler::getSingleton().writeJson(profileFile);
+      fclose(profileFile);
+    }
+
+    if (traceFile != 0) {
+      TreeTrace::getSingleton().write(action.getTraceFormat(), traceFile);
+      fclose(traceFile);
+    }
+  }
+}
 
 /** This function runs the Frobby console interface. the ::main
     function calls this function after having set up DEBUG-specific
@@ -40,7 +80,42 @@ int frobbyMain(int argc, const char** argv) {
 
   const auto_ptr<Action> action(Action::createActionWithPrefix(prefix));
   action->parseCommandLine(argc - 1, argv + 1);
-  action->perform();
+
+  const string& profileFileName = action->getProfileFileName();
+  Profiler& profiler = Profiler::getSingleton();
+  profiler.setEnabled(!profileFileName.empty());
+  FILE* profileFile = 0;
+  if (profiler.isEnabled())
+    profileFile = openReportFile(profileFileName, "profile");
+
+  const string& traceFileName = action->getTraceFileName();
+  TreeTrace& trace = TreeTrace::getSingleton();
+  TreeTrace::validateFormat(action->getTraceFormat());
+  trace.setEnabled(!traceFileName.empty());
+  FILE* traceFile = 0;
+  if (trace.isEnabled())
+    traceFile = openReportFile(traceFileName, "trace");
+
+  static ProgressPrinter progressPrinter(stderr);
+  const unsigned int progressInterval = action->getProgressInterval();
+  ProgressMeter::getSingleton().setReporter
+    (progressInterval == 0 ? 0 : &progressPrinter, 1000ul * progressInterval);
+
+  Cancellation& cancellation = Cancellation::getSingleton();
+  cancellation.start(1000ul * action->getTimeLimit());
+  try {
+    ProfilePhase phase(action->getName());
+    action->perform();
+  } catch (const CancelledException&) {
+    // The profile and trace of a stopped computation show how far it
+    // got, so they are written before the stop is reported.
+    cancellation.finish();
+    profiler.endAllPhases();
+    writeReportFiles(*action, profileFile, traceFile);
+    throw;
+  }
+  cancellation.finish();
+  writeReportFiles(*action, profileFile, traceFile);
 
   return ExitCodeSuccess;
 }
@@ -84,6 +159,13 @@ int main(int argc, const char** argv) {
 #endif
           (unsigned int)clock());
 
+#ifdef __GNUC__ // Only GCC defines this macro.
+    // Output to a terminal should appear as it is produced, so only
+    // enlarge the buffer if output goes somewhere else.
+    if (!isatty(fileno(stdout)))
+      setvbuf(stdout, 0, _IOFBF, OutputBufferSize);
+#endif
+
 #ifdef PROFILE
     fputs("This is a PROFILE build of Frobby. It is therefore SLOW.\n",
           stderr);